@@ -232,6 +232,13 @@ static const uint PLUGIN_OPTION_SEND_ALL_SOUND_OFF = 0x100;
  */
 static const uint PLUGIN_OPTION_SEND_PROGRAM_CHANGES = 0x200;
 
+/*!
+ * Skip processing once input and output have been silent for longer than the plugin's tail.
+ * The plugin is woken up again by non-silent audio input or any incoming event.
+ * @note: Do not use this on plugins that generate sound from silence.
+ */
+static const uint PLUGIN_OPTION_SKIP_SILENCE = 0x400;
+
 /** @} */
 
 /* ------------------------------------------------------------------------------------------------------------
@@ -936,7 +943,30 @@ typedef enum {
     /*!
      * The engine has crashed or malfunctioned and will no longer work.
      */
-    ENGINE_CALLBACK_QUIT = 38
+    ENGINE_CALLBACK_QUIT = 38,
+
+    /*!
+     * Offline rendering progress.
+     * @a value1 Number of frames rendered so far
+     * @a value2 Total number of frames to render
+     * @a value3 Progress, from 0.0 to 1.0
+     * @note If the total does not fit in an int, value1 and value2 are both divided by the same power of 2,
+     *       use value3 for the progress.
+     * @see carla_engine_render()
+     */
+    ENGINE_CALLBACK_RENDER_PROGRESS = 39,
+
+    /*!
+     * A plugin bridge took longer than the soft deadline for one or more audio blocks.
+     * Sent from the idle thread, once for all blocks that were slow since the previous one.
+     * @a pluginId Plugin Id
+     * @a value1 Number of slow blocks since the previous callback
+     * @a value2 Total number of slow blocks
+     * @a value3 Round-trip time of the latest slow block, in percent of the audio cycle
+     * @see ENGINE_OPTION_BRIDGE_SOFT_DEADLINE
+     * @see carla_get_plugin_bridge_latency()
+     */
+    ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS = 40
 
 } EngineCallbackOpcode;
 
@@ -1065,7 +1095,59 @@ typedef enum {
     /*!
      * Set frontend winId, used to define as parent window for plugin UIs.
      */
-    ENGINE_OPTION_FRONTEND_WIN_ID = 18
+    ENGINE_OPTION_FRONTEND_WIN_ID = 18,
+
+    /*!
+     * Number of threads used for processing plugins, including the audio thread.
+     * Values lower than 2 disable parallel processing.
+     * Default is 0.
+     * @note Used in patchbay processing mode, and in single-client mode with JACK
+     */
+    ENGINE_OPTION_PROCESS_THREADS = 19,
+
+    /*!
+     * Longest time in milliseconds the engine idle thread sleeps between updates.
+     * The thread is woken up sooner when plugins have changed output parameters or pending events.
+     * Default is 25.
+     */
+    ENGINE_OPTION_IDLE_POLL_INTERVAL = 20,
+
+    /*!
+     * Let plugin bridges render one block ahead, in parallel with the rest of the engine.
+     * This adds one block of latency to bridged plugins, which is reported to the engine.
+     * Default is false.
+     * @note Only applies to plugin bridges added after changing this option
+     */
+    ENGINE_OPTION_PIPELINED_BRIDGES = 21,
+
+    /*!
+     * Soft deadline for plugin bridges, in percent of the audio cycle (buffer size / sample rate).
+     * Blocks whose round-trip takes longer are counted as slow and reported with ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS,
+     * well before they become full timeouts.
+     * Set to 0 to disable.
+     * Default is 75.
+     */
+    ENGINE_OPTION_BRIDGE_SOFT_DEADLINE = 22,
+
+    /*!
+     * Smallest number of frames a plugin block is split into when processing events sample accurately.
+     * Events closer than this to the start of the current sub-block or to the end of the audio block
+     * are applied at the start of the current sub-block instead of splitting again.
+     * MIDI events keep their exact time within the sub-block.
+     * Useful with dense automation and plugins that have a high per-call overhead.
+     * Default is 1 (split at every event time).
+     * @see carla_get_plugin_sub_blocks()
+     */
+    ENGINE_OPTION_SPLIT_GRANULARITY = 23,
+
+    /*!
+     * Use a spin-then-futex handshake instead of semaphores for the audio cycles of plugin bridges.
+     * Waiting spins for a while before sleeping, which can lower the round-trip time on some systems
+     * at the cost of extra CPU use. Measure before enabling it.
+     * Default is false.
+     * @note Only applies to plugin bridges added after changing this option, and only on Linux
+     */
+    ENGINE_OPTION_LOW_LATENCY_BRIDGES = 24
 
 } EngineOption;
 
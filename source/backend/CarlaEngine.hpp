@@ -31,6 +31,11 @@ class XmlDocument;
 
 CARLA_BACKEND_START_NAMESPACE
 
+#ifndef DOXYGEN
+// see CarlaEngineUtils.hpp
+struct EngineEventBuffer;
+#endif
+
 // -----------------------------------------------------------------------
 
 /*!
@@ -73,7 +78,12 @@ enum EngineType {
     /*!
      * Bridge engine type, used in BridgePlugin class.
      */
-    kEngineTypeBridge = 5
+    kEngineTypeBridge = 5,
+
+    /*!
+     * Offline engine type, used to render into audio files.
+     */
+    kEngineTypeOffline = 6
 };
 
 /*!
@@ -254,6 +264,13 @@ struct CARLA_API EngineOptions {
     bool preventBadBehaviour;
     uintptr_t frontendWinId;
 
+    uint processThreads;
+    uint idlePollInterval;
+    bool pipelinedBridges;
+    uint bridgeSoftDeadline;
+    uint splitGranularity;
+    bool lowLatencyBridges;
+
 #ifndef DOXYGEN
     EngineOptions() noexcept;
     ~EngineOptions() noexcept;
@@ -307,6 +324,52 @@ struct CARLA_API EngineTimeInfo {
 #endif
 };
 
+/*!
+ * Engine processing time information for a single node (plugin or patchbay I/O).
+ * All values are in microseconds.
+ */
+struct CARLA_API EngineProcessNodeTiming {
+    float lastUsecs; //!< time spent in the last cycle
+    float avgUsecs;  //!< smoothed average
+    float maxUsecs;  //!< highest value seen
+    float pathUsecs; //!< longest average path from an input up to the end of this node
+    bool  critical;  //!< node is part of the current critical path
+
+    /*!
+     * Clear.
+     */
+    void clear() noexcept;
+
+#ifndef DOXYGEN
+    EngineProcessNodeTiming() noexcept;
+#endif
+};
+
+/*!
+ * Engine processing load, of a single plugin or the whole engine.
+ * Loads are in percent of the time available for one audio cycle (buffer size / sample rate).
+ * Offline processing is not accounted for.
+ */
+struct CARLA_API EngineDspLoad {
+    float current;      //!< load of the last cycle
+    float average;      //!< smoothed average
+    float minimum;      //!< lowest value seen
+    float maximum;      //!< highest value seen
+    float percentile95; //!< 95% of the cycles were at or below this load
+    float percentile99; //!< 99% of the cycles were at or below this load
+    uint32_t xruns;     //!< number of cycles that took longer than the time available
+    uint32_t cycles;    //!< number of cycles accounted for
+
+    /*!
+     * Clear.
+     */
+    void clear() noexcept;
+
+#ifndef DOXYGEN
+    EngineDspLoad() noexcept;
+#endif
+};
+
 // -----------------------------------------------------------------------
 
 /*!
@@ -402,6 +465,16 @@ public:
         return fBuffer;
     }
 
+    /*!
+     * Use an external buffer as the port's audio buffer, or null to stop using it.
+     * Only meant for engines that do not provide port buffers themselves (rack mode),
+     * which will then read and write the port's audio directly from it.
+     */
+    void setSharedBuffer(float* const buffer) noexcept
+    {
+        fBuffer = buffer;
+    }
+
 #ifndef DOXYGEN
 protected:
     float* fBuffer;
@@ -538,7 +611,7 @@ public:
 
 #ifndef DOXYGEN
 protected:
-    EngineEvent* fBuffer;
+    EngineEventBuffer* fBuffer;
     const EngineProcessMode kProcessMode;
     friend class CarlaPluginInstance;
 
@@ -747,6 +820,25 @@ public:
      */
     virtual void idle() noexcept;
 
+    /*!
+     * Wake up the engine idle thread, so it handles plugins that requested it.
+     * @note RT call
+     */
+    void wakeUpIdleThread() noexcept;
+
+    /*!
+     * Queue a call to @a plugin's runWork() in one of the engine worker threads.
+     * Returns false if the queue is full.
+     * @note RT call
+     */
+    bool scheduleWork(CarlaPlugin* const plugin) noexcept;
+
+    /*!
+     * Remove @a plugin from the worker queue and wait for its current work to finish.
+     * Must be called before deleting a plugin that scheduled work.
+     */
+    void cancelWork(CarlaPlugin* const plugin) noexcept;
+
     /*!
      * Check if engine is running.
      */
@@ -919,6 +1011,20 @@ public:
      */
     float getOutputPeak(const uint pluginId, const bool isLeft) const noexcept;
 
+    // -------------------------------------------------------------------
+    // Information (processing load)
+
+    /*!
+     * Get the processing load of a plugin.
+     * Returns false if @a pluginId is invalid.
+     */
+    bool getPluginDspLoad(const uint pluginId, EngineDspLoad& load) const noexcept;
+
+    /*!
+     * Get the processing load of the whole engine, measured over the full audio cycle.
+     */
+    void getEngineLoad(EngineDspLoad& load) const noexcept;
+
     // -------------------------------------------------------------------
     // Callback
 
@@ -965,6 +1071,13 @@ public:
      * Force the engine to resend all patchbay clients, ports and connections again.
      */
     virtual bool patchbayRefresh(const bool external);
+
+    /*!
+     * Get the processing time information of a patchbay group.
+     * Only available in patchbay mode with parallel processing enabled.
+     * @see ENGINE_OPTION_PROCESS_THREADS
+     */
+    bool getPatchbayGroupTiming(const uint groupId, EngineProcessNodeTiming& timing, float& criticalPathUsecs) const;
 #endif
 
     // -------------------------------------------------------------------
@@ -985,6 +1098,19 @@ public:
      */
     virtual void transportRelocate(const uint64_t frame) noexcept;
 
+#ifndef BUILD_BRIDGE
+    // -------------------------------------------------------------------
+    // Offline rendering
+
+    /*!
+     * Render the master output from @a startFrame up to @a endFrame into an audio file.
+     * The file format is guessed from the extension, either WAV or FLAC.
+     * Processing runs as fast as possible and blocks until done, progress is reported via ENGINE_CALLBACK_RENDER_PROGRESS.
+     * Only supported by the offline engine driver.
+     */
+    virtual bool renderToFile(const char* const filename, const uint64_t startFrame, const uint64_t endFrame);
+#endif
+
     // -------------------------------------------------------------------
     // Error handling
 
@@ -1047,7 +1173,7 @@ public:
      * Return internal data, needed for EventPorts when used in Rack and Bridge modes.
      * @note RT call
      */
-    EngineEvent* getInternalEventBuffer(const bool isInput) const noexcept;
+    EngineEventBuffer* getInternalEventBuffer(const bool isInput) const noexcept;
 
 #ifndef BUILD_BRIDGE
     /*!
@@ -1111,6 +1237,12 @@ protected:
      */
     void setPluginPeaks(const uint pluginId, float const inPeaks[2], float const outPeaks[2]) noexcept;
 
+    /*!
+     * Account the time a plugin took to process @a frames, in seconds.
+     * @note RT call
+     */
+    void setPluginProcessTime(const uint pluginId, const double seconds, const uint32_t frames) noexcept;
+
     /*!
      * Common save project function for main engine and plugin.
      */
@@ -1166,6 +1298,11 @@ public:
     // JACK
     static CarlaEngine*       newJack();
 
+#ifndef BUILD_BRIDGE
+    // Offline
+    static CarlaEngine*       newOffline();
+#endif
+
 #ifdef BUILD_BRIDGE
     // Bridge
     static CarlaEngine*       newBridge(const char* const audioPoolBaseName, const char* const rtClientBaseName, const char* const nonRtClientBaseName, const char* const nonRtServerBaseName);
@@ -1215,6 +1352,7 @@ public:
     void oscSend_control_note_on(const uint pluginId, const uint8_t channel, const uint8_t note, const uint8_t velo) const noexcept;
     void oscSend_control_note_off(const uint pluginId, const uint8_t channel, const uint8_t note) const noexcept;
     void oscSend_control_set_peaks(const uint pluginId) const noexcept;
+    void oscSend_control_set_dsp_load(const uint pluginId) const noexcept;
     void oscSend_control_exit() const noexcept;
 #endif
 
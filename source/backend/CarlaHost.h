@@ -268,6 +268,467 @@ typedef struct _CarlaTransportInfo {
 
 } CarlaTransportInfo;
 
+/*!
+ * Patchbay group processing time information.
+ * All times are in microseconds.
+ * @see carla_get_patchbay_group_timing()
+ */
+typedef struct _CarlaPatchbayGroupTiming {
+    /*!
+     * Time spent in the last audio cycle.
+     */
+    float lastTime;
+
+    /*!
+     * Average time.
+     */
+    float avgTime;
+
+    /*!
+     * Highest time seen so far.
+     */
+    float maxTime;
+
+    /*!
+     * Longest average path from the graph inputs up to the end of this group.
+     */
+    float pathTime;
+
+    /*!
+     * Average time of the whole critical path.
+     */
+    float criticalPathTime;
+
+    /*!
+     * Wherever this group is part of the critical path.
+     */
+    bool critical;
+
+#ifdef __cplusplus
+    /*!
+     * C++ constructor.
+     */
+    CARLA_API _CarlaPatchbayGroupTiming() noexcept;
+#endif
+
+} CarlaPatchbayGroupTiming;
+
+/*!
+ * Processing load information, of a single plugin or the whole engine.
+ * Loads are in percent of the time available for one audio cycle (buffer size / sample rate).
+ * Offline processing is not accounted for.
+ * @see carla_get_plugin_dsp_load()
+ * @see carla_get_engine_load()
+ */
+typedef struct _CarlaDspLoadInfo {
+    /*!
+     * Load of the last audio cycle.
+     */
+    float current;
+
+    /*!
+     * Average load.
+     */
+    float average;
+
+    /*!
+     * Lowest load seen so far.
+     */
+    float minimum;
+
+    /*!
+     * Highest load seen so far.
+     */
+    float maximum;
+
+    /*!
+     * 95% of the audio cycles were at or below this load.
+     */
+    float percentile95;
+
+    /*!
+     * 99% of the audio cycles were at or below this load.
+     */
+    float percentile99;
+
+    /*!
+     * Number of audio cycles that took longer than the time available.
+     */
+    uint32_t xruns;
+
+    /*!
+     * Number of audio cycles accounted for.
+     */
+    uint32_t cycles;
+
+#ifdef __cplusplus
+    /*!
+     * C++ constructor.
+     */
+    CARLA_API _CarlaDspLoadInfo() noexcept;
+#endif
+
+} CarlaDspLoadInfo;
+
+/*!
+ * Round-trip timing of a plugin bridge, measured on the audio thread for every processed block.
+ * Times are in microseconds.
+ * In pipelined mode the bridge stage is only the time spent waiting for the bridge.
+ * @see carla_get_plugin_bridge_latency()
+ */
+typedef struct _CarlaBridgeLatencyInfo {
+    /*!
+     * Host writing the block into shared memory, smoothed average.
+     */
+    float writeAverage;
+
+    /*!
+     * Host writing the block into shared memory, highest value seen.
+     */
+    float writeMaximum;
+
+    /*!
+     * Bridge processing the block, smoothed average.
+     */
+    float processAverage;
+
+    /*!
+     * Bridge processing the block, highest value seen.
+     */
+    float processMaximum;
+
+    /*!
+     * Host reading back and post-processing the block, smoothed average.
+     */
+    float readAverage;
+
+    /*!
+     * Host reading back and post-processing the block, highest value seen.
+     */
+    float readMaximum;
+
+    /*!
+     * Full round-trip, smoothed average.
+     */
+    float totalAverage;
+
+    /*!
+     * Full round-trip, highest value seen.
+     */
+    float totalMaximum;
+
+    /*!
+     * 95% of the round-trips were at or below this time.
+     */
+    float percentile95;
+
+    /*!
+     * 99% of the round-trips were at or below this time.
+     */
+    float percentile99;
+
+    /*!
+     * Number of blocks over the soft deadline.
+     * @see ENGINE_OPTION_BRIDGE_SOFT_DEADLINE
+     */
+    uint32_t slowBlocks;
+
+    /*!
+     * Number of blocks the bridge did not reply to in time.
+     */
+    uint32_t timeouts;
+
+    /*!
+     * Number of blocks accounted for.
+     */
+    uint32_t blocks;
+
+    /*!
+     * Round-trip histogram.
+     * Bucket 0 counts round-trips below 2 microseconds, bucket N those from 2^N up to 2^(N+1) microseconds.
+     * The last bucket also counts anything slower.
+     */
+    uint32_t histogram[24];
+
+#ifdef __cplusplus
+    /*!
+     * C++ constructor.
+     */
+    CARLA_API _CarlaBridgeLatencyInfo() noexcept;
+#endif
+
+} CarlaBridgeLatencyInfo;
+
+/*!
+ * How often a plugin was run, for plugin types that split audio blocks at event times.
+ * Both counters wrap around at 2^32, use carla_reset_plugin_sub_blocks() to start a new measurement.
+ * @see ENGINE_OPTION_SPLIT_GRANULARITY
+ * @see carla_get_plugin_sub_blocks()
+ */
+typedef struct _CarlaSubBlockInfo {
+    /*!
+     * Number of audio blocks processed.
+     */
+    uint32_t blocks;
+
+    /*!
+     * Number of plugin runs for those blocks, at least one per block.
+     */
+    uint32_t subBlocks;
+
+#ifdef __cplusplus
+    /*!
+     * C++ constructor.
+     */
+    CARLA_API _CarlaSubBlockInfo() noexcept;
+#endif
+
+} CarlaSubBlockInfo;
+
+/*!
+ * Layout version of plugin snapshots.
+ * Bumped whenever any of the snapshot structs below change.
+ * @see CarlaPluginSnapshot
+ */
+static const uint32_t PLUGIN_SNAPSHOT_VERSION = 1;
+
+/*!
+ * Parameter entry of a plugin snapshot.
+ * Strings are stored as byte offsets from the start of the snapshot, each pointing to null-terminated UTF-8 text.
+ * @see CarlaPluginSnapshot
+ */
+typedef struct _CarlaParameterSnapshot {
+    /*!
+     * Parameter data.
+     */
+    ParameterData data;
+
+    /*!
+     * Parameter ranges.
+     */
+    ParameterRanges ranges;
+
+    /*!
+     * Current parameter value.
+     */
+    float value;
+
+    /*!
+     * Offset of the parameter name.
+     */
+    uint32_t name;
+
+    /*!
+     * Offset of the parameter symbol.
+     */
+    uint32_t symbol;
+
+    /*!
+     * Offset of the parameter unit.
+     */
+    uint32_t unit;
+
+    /*!
+     * Offset of the text for the current value.
+     * Points to an empty string unless the parameter has PARAMETER_USES_CUSTOM_TEXT.
+     */
+    uint32_t text;
+
+    /*!
+     * Index of this parameter's first scale point.
+     */
+    uint32_t scalePointStart;
+
+    /*!
+     * Number of scale points.
+     */
+    uint32_t scalePointCount;
+
+} CarlaParameterSnapshot;
+
+/*!
+ * Scale point entry of a plugin snapshot.
+ * @see CarlaPluginSnapshot
+ */
+typedef struct _CarlaScalePointSnapshot {
+    /*!
+     * Scale point value.
+     */
+    float value;
+
+    /*!
+     * Offset of the scale point label.
+     */
+    uint32_t label;
+
+} CarlaScalePointSnapshot;
+
+/*!
+ * MIDI program entry of a plugin snapshot.
+ * @see CarlaPluginSnapshot
+ */
+typedef struct _CarlaMidiProgramSnapshot {
+    /*!
+     * MIDI bank.
+     */
+    uint32_t bank;
+
+    /*!
+     * MIDI program.
+     */
+    uint32_t program;
+
+    /*!
+     * Offset of the MIDI program name.
+     */
+    uint32_t name;
+
+} CarlaMidiProgramSnapshot;
+
+/*!
+ * Snapshot of everything a frontend needs to show a plugin's parameters and programs.
+ * This is the header of a single contiguous buffer of @a size bytes, which holds all arrays and strings.
+ * Every offset is in bytes, from the start of this struct.
+ * @see carla_get_plugin_snapshot()
+ */
+typedef struct _CarlaPluginSnapshot {
+    /*!
+     * Layout version, always check this against PLUGIN_SNAPSHOT_VERSION first.
+     */
+    uint32_t version;
+
+    /*!
+     * Total size of the snapshot, in bytes.
+     */
+    uint32_t size;
+
+    /*!
+     * Value generation this snapshot was taken at.
+     * @see carla_get_plugin_snapshot_changes()
+     */
+    uint32_t generation;
+
+    /*!
+     * Number of parameters.
+     */
+    uint32_t parameterCount;
+
+    /*!
+     * Number of scale points, for all parameters.
+     */
+    uint32_t scalePointCount;
+
+    /*!
+     * Number of programs.
+     */
+    uint32_t programCount;
+
+    /*!
+     * Number of MIDI programs.
+     */
+    uint32_t midiProgramCount;
+
+    /*!
+     * Current program, or -1 if none.
+     */
+    int32_t currentProgram;
+
+    /*!
+     * Current MIDI program, or -1 if none.
+     */
+    int32_t currentMidiProgram;
+
+    /*!
+     * Offset of the parameters, an array of CarlaParameterSnapshot.
+     */
+    uint32_t parameters;
+
+    /*!
+     * Offset of the scale points, an array of CarlaScalePointSnapshot.
+     */
+    uint32_t scalePoints;
+
+    /*!
+     * Offset of the program names, an array of uint32_t string offsets.
+     */
+    uint32_t programNames;
+
+    /*!
+     * Offset of the MIDI programs, an array of CarlaMidiProgramSnapshot.
+     */
+    uint32_t midiPrograms;
+
+#ifdef __cplusplus
+    /*!
+     * C++ constructor.
+     */
+    CARLA_API _CarlaPluginSnapshot() noexcept;
+#endif
+
+} CarlaPluginSnapshot;
+
+/*!
+ * Parameter value change.
+ * @see CarlaPluginSnapshotChanges
+ */
+typedef struct _CarlaParameterChange {
+    /*!
+     * Parameter index.
+     */
+    uint32_t index;
+
+    /*!
+     * New parameter value.
+     */
+    float value;
+
+} CarlaParameterChange;
+
+/*!
+ * Parameter values that changed since a previous snapshot.
+ * @see carla_get_plugin_snapshot_changes()
+ */
+typedef struct _CarlaPluginSnapshotChanges {
+    /*!
+     * Current value generation, to pass on the next call.
+     */
+    uint32_t generation;
+
+    /*!
+     * Parameters or programs were recreated since the requested generation.
+     * When true, the change list is empty and a new full snapshot is needed.
+     */
+    bool layoutChanged;
+
+    /*!
+     * Current program, or -1 if none.
+     */
+    int32_t currentProgram;
+
+    /*!
+     * Current MIDI program, or -1 if none.
+     */
+    int32_t currentMidiProgram;
+
+    /*!
+     * Number of changed parameters.
+     */
+    uint32_t count;
+
+    /*!
+     * Changed parameters, ordered by index.
+     */
+    const CarlaParameterChange* changes;
+
+#ifdef __cplusplus
+    /*!
+     * C++ constructor.
+     */
+    CARLA_API _CarlaPluginSnapshotChanges() noexcept;
+#endif
+
+} CarlaPluginSnapshotChanges;
+
 /* ------------------------------------------------------------------------------------------------------------
  * Carla Host API (C functions) */
 
@@ -411,6 +872,14 @@ CARLA_EXPORT bool carla_patchbay_disconnect(uint connectionId);
  */
 CARLA_EXPORT bool carla_patchbay_refresh(bool external);
 
+/*!
+ * Get the processing time information of a patchbay group.
+ * Only valid in patchbay engine mode with ENGINE_OPTION_PROCESS_THREADS bigger than 1,
+ * all values are zero otherwise.
+ * @param groupId Group Id
+ */
+CARLA_EXPORT const CarlaPatchbayGroupTiming* carla_get_patchbay_group_timing(uint groupId);
+
 /*!
  * Start playback of the engine transport.
  */
@@ -435,6 +904,17 @@ CARLA_EXPORT uint64_t carla_get_current_transport_frame();
  * Get the engine transport information.
  */
 CARLA_EXPORT const CarlaTransportInfo* carla_get_transport_info();
+
+/*!
+ * Render the engine master output into an audio file, as fast as possible.
+ * The file format is guessed from the extension, either WAV or FLAC.
+ * This call blocks until rendering is done, progress is reported via ENGINE_CALLBACK_RENDER_PROGRESS.
+ * Only valid when using the "Offline" engine driver.
+ * @param filename   Audio file to write
+ * @param startFrame First frame to render
+ * @param endFrame   Frame to stop rendering at (not included)
+ */
+CARLA_EXPORT bool carla_engine_render(const char* filename, uint64_t startFrame, uint64_t endFrame);
 #endif
 
 /*!
@@ -694,6 +1174,23 @@ CARLA_EXPORT float carla_get_current_parameter_value(uint pluginId, uint32_t par
  */
 CARLA_EXPORT float carla_get_internal_parameter_value(uint pluginId, int32_t parameterId);
 
+/*!
+ * Get a snapshot of all of a plugin's parameters, scale points, values and programs, in a single buffer.
+ * This replaces calling the per-parameter functions above for every parameter.
+ * The returned data is valid until the next call.
+ * @param pluginId Plugin
+ */
+CARLA_EXPORT const CarlaPluginSnapshot* carla_get_plugin_snapshot(uint pluginId);
+
+/*!
+ * Get the parameter values of a plugin that changed after a previous snapshot or change list.
+ * Only changed values are returned, making this cheap enough for periodic refreshes.
+ * The returned data is valid until the next call.
+ * @param pluginId   Plugin
+ * @param generation Generation of the previous snapshot or change list
+ */
+CARLA_EXPORT const CarlaPluginSnapshotChanges* carla_get_plugin_snapshot_changes(uint pluginId, uint32_t generation);
+
 /*!
  * Get a plugin's input peak value.
  * @param pluginId Plugin
@@ -708,6 +1205,41 @@ CARLA_EXPORT float carla_get_input_peak_value(uint pluginId, bool isLeft);
  */
 CARLA_EXPORT float carla_get_output_peak_value(uint pluginId, bool isLeft);
 
+/*!
+ * Get a plugin's processing load.
+ * @param pluginId Plugin
+ */
+CARLA_EXPORT const CarlaDspLoadInfo* carla_get_plugin_dsp_load(uint pluginId);
+
+/*!
+ * Get a plugin bridge's round-trip timing.
+ * All values are zero if the plugin is not a bridge.
+ * @param pluginId Plugin
+ */
+CARLA_EXPORT const CarlaBridgeLatencyInfo* carla_get_plugin_bridge_latency(uint pluginId);
+
+/*!
+ * Reset a plugin bridge's round-trip timing.
+ * Does nothing if the plugin is not a bridge.
+ * @param pluginId Plugin
+ */
+CARLA_EXPORT void carla_reset_plugin_bridge_latency(uint pluginId);
+
+/*!
+ * Get how many sub-blocks a plugin was run in.
+ * Only LADSPA, DSSI, LV2 and VST2 plugins split blocks, all values are zero for other plugin types.
+ * @param pluginId Plugin
+ * @see ENGINE_OPTION_SPLIT_GRANULARITY
+ */
+CARLA_EXPORT const CarlaSubBlockInfo* carla_get_plugin_sub_blocks(uint pluginId);
+
+/*!
+ * Reset a plugin's sub-block counters.
+ * They are cleared before the plugin processes its next block.
+ * @param pluginId Plugin
+ */
+CARLA_EXPORT void carla_reset_plugin_sub_blocks(uint pluginId);
+
 /*!
  * Enable or disable a plugin.
  * @param pluginId Plugin
@@ -874,6 +1406,11 @@ CARLA_EXPORT uint32_t carla_get_buffer_size();
  */
 CARLA_EXPORT double carla_get_sample_rate();
 
+/*!
+ * Get the processing load of the whole engine.
+ */
+CARLA_EXPORT const CarlaDspLoadInfo* carla_get_engine_load();
+
 /*!
  * Get the last error.
  */
@@ -95,6 +95,69 @@ _CarlaTransportInfo::_CarlaTransportInfo() noexcept
       tick(0),
       bpm(0.0) {}
 
+_CarlaPatchbayGroupTiming::_CarlaPatchbayGroupTiming() noexcept
+    : lastTime(0.0f),
+      avgTime(0.0f),
+      maxTime(0.0f),
+      pathTime(0.0f),
+      criticalPathTime(0.0f),
+      critical(false) {}
+
+_CarlaDspLoadInfo::_CarlaDspLoadInfo() noexcept
+    : current(0.0f),
+      average(0.0f),
+      minimum(0.0f),
+      maximum(0.0f),
+      percentile95(0.0f),
+      percentile99(0.0f),
+      xruns(0),
+      cycles(0) {}
+
+_CarlaBridgeLatencyInfo::_CarlaBridgeLatencyInfo() noexcept
+    : writeAverage(0.0f),
+      writeMaximum(0.0f),
+      processAverage(0.0f),
+      processMaximum(0.0f),
+      readAverage(0.0f),
+      readMaximum(0.0f),
+      totalAverage(0.0f),
+      totalMaximum(0.0f),
+      percentile95(0.0f),
+      percentile99(0.0f),
+      slowBlocks(0),
+      timeouts(0),
+      blocks(0)
+{
+    carla_zeroStruct(histogram, 24);
+}
+
+_CarlaSubBlockInfo::_CarlaSubBlockInfo() noexcept
+    : blocks(0),
+      subBlocks(0) {}
+
+_CarlaPluginSnapshot::_CarlaPluginSnapshot() noexcept
+    : version(PLUGIN_SNAPSHOT_VERSION),
+      size(sizeof(_CarlaPluginSnapshot)),
+      generation(0),
+      parameterCount(0),
+      scalePointCount(0),
+      programCount(0),
+      midiProgramCount(0),
+      currentProgram(-1),
+      currentMidiProgram(-1),
+      parameters(sizeof(_CarlaPluginSnapshot)),
+      scalePoints(sizeof(_CarlaPluginSnapshot)),
+      programNames(sizeof(_CarlaPluginSnapshot)),
+      midiPrograms(sizeof(_CarlaPluginSnapshot)) {}
+
+_CarlaPluginSnapshotChanges::_CarlaPluginSnapshotChanges() noexcept
+    : generation(0),
+      layoutChanged(false),
+      currentProgram(-1),
+      currentMidiProgram(-1),
+      count(0),
+      changes(nullptr) {}
+
 // -------------------------------------------------------------------------------------------------------------------
 
 const char* carla_get_library_filename()
@@ -51,6 +51,46 @@ struct CarlaStateSave;
 
 // -----------------------------------------------------------------------
 
+/*!
+ * Number of buckets in a plugin bridge round-trip histogram.
+ */
+const uint kPluginBridgeLatencyBucketCount = 24;
+
+/*!
+ * Round-trip timing of a plugin bridge, measured on the audio thread for every processed block.
+ * Times are in microseconds.
+ * In pipelined mode the bridge stage is only the time spent waiting for the bridge.
+ * @see CarlaPlugin::getBridgeLatency()
+ */
+struct CARLA_API PluginBridgeLatency {
+    float writeAverage;     //!< host writing the block into shared memory, smoothed average
+    float writeMaximum;     //!< host writing the block into shared memory, highest value seen
+    float processAverage;   //!< bridge processing the block, smoothed average
+    float processMaximum;   //!< bridge processing the block, highest value seen
+    float readAverage;      //!< host reading back and post-processing the block, smoothed average
+    float readMaximum;      //!< host reading back and post-processing the block, highest value seen
+    float totalAverage;     //!< full round-trip, smoothed average
+    float totalMaximum;     //!< full round-trip, highest value seen
+    float percentile95;     //!< 95% of the round-trips were at or below this time
+    float percentile99;     //!< 99% of the round-trips were at or below this time
+    uint32_t slowBlocks;    //!< number of blocks over the soft deadline
+    uint32_t timeouts;      //!< number of blocks the bridge did not reply to in time
+    uint32_t blocks;        //!< number of blocks accounted for
+
+    /*!
+     * Round-trip histogram.
+     * Bucket 0 counts round-trips below 2 microseconds, bucket N those from 2^N up to 2^(N+1) microseconds.
+     * The last bucket also counts anything slower.
+     */
+    uint32_t histogram[kPluginBridgeLatencyBucketCount];
+
+#ifndef DOXYGEN
+    PluginBridgeLatency() noexcept;
+#endif
+};
+
+// -----------------------------------------------------------------------
+
 /*!
  * Carla Backend base plugin class
  *
@@ -156,6 +196,13 @@ public:
      */
     virtual uint32_t getLatencyInFrames() const noexcept;
 
+    /*!
+     * Get the plugin's tail length, in sample frames.
+     * This is how long the plugin may keep producing sound after its input becomes silent.
+     * @see PLUGIN_OPTION_SKIP_SILENCE
+     */
+    virtual uint32_t getTailLengthInFrames() const noexcept;
+
     // -------------------------------------------------------------------
     // Information (count)
 
@@ -369,6 +416,28 @@ public:
      */
     void getParameterCountInfo(uint32_t& ins, uint32_t& outs) const noexcept;
 
+    /*!
+     * Compare the current parameter values against the last update, and return the current value generation.
+     * Parameters that changed are stamped with a new generation.
+     * If the parameters or programs were recreated since the last update, all parameters are stamped and the layout generation moves too.
+     *
+     * @note Not RT safe, call from the main thread only.
+     *
+     * @see getParameterGeneration() and getLayoutGeneration()
+     */
+    uint32_t updateGenerations() noexcept;
+
+    /*!
+     * Get the generation in which parameter @a parameterId last changed value.
+     */
+    uint32_t getParameterGeneration(const uint32_t parameterId) const noexcept;
+
+    /*!
+     * Get the generation in which the parameters or programs were last recreated.
+     * Anything older than this needs a full refresh.
+     */
+    uint32_t getLayoutGeneration() const noexcept;
+
     // -------------------------------------------------------------------
     // Set data (state)
 
@@ -670,6 +739,48 @@ public:
      */
     virtual void idle();
 
+    /*!
+     * Check if the audio thread requested an idle call since the last check, and clear the request.
+     * This happens when output parameters change or new post-RT events are available.
+     * @note: This function is NOT called from the main thread.
+     */
+    bool takeIdleRequest() noexcept;
+
+    /*!
+     * Run non-RT work the plugin requested from the audio thread through CarlaEngine::scheduleWork().
+     * The default implementation does nothing.
+     * @note: This function is called from an engine worker thread, never twice at the same time.
+     */
+    virtual void runWork() noexcept;
+
+    /*!
+     * Check if output parameter @a parameterId changed since the last check, and clear its changed state.
+     * @note: This function is NOT called from the main thread.
+     */
+    bool takeParameterOutputChanged(const uint32_t parameterId) noexcept;
+
+    /*!
+     * Mark all output parameters as changed, so the engine thread sends all of them on its next pass.
+     * Used when a custom UI or an OSC client attaches, as only changed outputs are sent otherwise.
+     */
+    void refreshParameterOutputs() noexcept;
+
+    /*!
+     * Check if the plugin is asleep and can skip processing of the current block.
+     * Always false unless PLUGIN_OPTION_SKIP_SILENCE is enabled.
+     * Non-silent input or any pending event wakes up the plugin.
+     * @param inPeak Absolute peak of the block's audio input
+     * @note: RT call, made by the engine before initBuffers() and process()
+     */
+    bool isSleepingOnSilence(const float inPeak) noexcept;
+
+    /*!
+     * Update the silence state after processing a block.
+     * The plugin goes to sleep once its input has been silent for longer than its tail and its output is silent too.
+     * @note: RT call, made by the engine after process()
+     */
+    void updateSilenceState(const float inPeak, const float outPeak, const uint32_t frames) noexcept;
+
     /*!
      * Try to lock the plugin's master mutex.
      * @param forcedOffline When true, always locks and returns true
@@ -841,6 +952,32 @@ public:
      */
     virtual uintptr_t getUiBridgeProcessId() const noexcept;
 
+    /*!
+     * Get the round-trip timing of a plugin bridge.
+     * Returns false if this plugin is not a bridge.
+     */
+    virtual bool getBridgeLatency(PluginBridgeLatency& latency) const noexcept;
+
+    /*!
+     * Reset the round-trip timing of a plugin bridge.
+     * The audio thread clears it before processing its next block.
+     * This is also done when the plugin is activated, or the buffer size or sample rate changes.
+     */
+    virtual void resetBridgeLatency() noexcept;
+
+    /*!
+     * Get how many audio blocks were processed, and in how many runs of the plugin in total.
+     * Blocks are split at event times when processing sample accurately, see ENGINE_OPTION_SPLIT_GRANULARITY.
+     * Both counters wrap around, see resetSubBlockCount() to start a new measurement.
+     */
+    void getSubBlockCount(uint32_t& blocks, uint32_t& subBlocks) const noexcept;
+
+    /*!
+     * Reset the block and run counters.
+     * The audio thread clears them before processing its next block.
+     */
+    void resetSubBlockCount() noexcept;
+
     // -------------------------------------------------------------------
 
     /*!
@@ -440,6 +440,9 @@ static void carla_engine_init_common()
     if (const char* const uiBridgesTimeout = std::getenv("ENGINE_OPTION_UI_BRIDGES_TIMEOUT"))
         gStandalone.engine->setOption(CB::ENGINE_OPTION_UI_BRIDGES_TIMEOUT, std::atoi(uiBridgesTimeout), nullptr);
 
+    if (const char* const splitGranularity = std::getenv("ENGINE_OPTION_SPLIT_GRANULARITY"))
+        gStandalone.engine->setOption(CB::ENGINE_OPTION_SPLIT_GRANULARITY,  std::atoi(splitGranularity), nullptr);
+
     if (const char* const pathLADSPA = std::getenv("ENGINE_OPTION_PLUGIN_PATH_LADSPA"))
         gStandalone.engine->setOption(CB::ENGINE_OPTION_PLUGIN_PATH, CB::PLUGIN_LADSPA, pathLADSPA);
 
@@ -492,6 +495,12 @@ static void carla_engine_init_common()
     gStandalone.engine->setOption(CB::ENGINE_OPTION_AUDIO_NUM_PERIODS,     static_cast<int>(gStandalone.engineOptions.audioNumPeriods),  nullptr);
     gStandalone.engine->setOption(CB::ENGINE_OPTION_AUDIO_BUFFER_SIZE,     static_cast<int>(gStandalone.engineOptions.audioBufferSize),  nullptr);
     gStandalone.engine->setOption(CB::ENGINE_OPTION_AUDIO_SAMPLE_RATE,     static_cast<int>(gStandalone.engineOptions.audioSampleRate),  nullptr);
+    gStandalone.engine->setOption(CB::ENGINE_OPTION_PROCESS_THREADS,       static_cast<int>(gStandalone.engineOptions.processThreads),   nullptr);
+    gStandalone.engine->setOption(CB::ENGINE_OPTION_IDLE_POLL_INTERVAL,    static_cast<int>(gStandalone.engineOptions.idlePollInterval), nullptr);
+    gStandalone.engine->setOption(CB::ENGINE_OPTION_PIPELINED_BRIDGES,     gStandalone.engineOptions.pipelinedBridges ? 1 : 0,           nullptr);
+    gStandalone.engine->setOption(CB::ENGINE_OPTION_BRIDGE_SOFT_DEADLINE,  static_cast<int>(gStandalone.engineOptions.bridgeSoftDeadline), nullptr);
+    gStandalone.engine->setOption(CB::ENGINE_OPTION_SPLIT_GRANULARITY,     static_cast<int>(gStandalone.engineOptions.splitGranularity),   nullptr);
+    gStandalone.engine->setOption(CB::ENGINE_OPTION_LOW_LATENCY_BRIDGES,   gStandalone.engineOptions.lowLatencyBridges ? 1 : 0,          nullptr);
 
     if (gStandalone.engineOptions.audioDevice != nullptr)
         gStandalone.engine->setOption(CB::ENGINE_OPTION_AUDIO_DEVICE,      0, gStandalone.engineOptions.audioDevice);
@@ -879,11 +888,41 @@ void carla_set_engine_option(EngineOption option, int value, const char* valueSt
         gStandalone.engineOptions.preventBadBehaviour = (value != 0);
         break;
 
-    case CB::ENGINE_OPTION_FRONTEND_WIN_ID:
+    case CB::ENGINE_OPTION_FRONTEND_WIN_ID: {
         CARLA_SAFE_ASSERT_RETURN(valueStr != nullptr && valueStr[0] != '\0',);
         const long long winId(std::strtoll(valueStr, nullptr, 16));
         CARLA_SAFE_ASSERT_RETURN(winId >= 0,);
         gStandalone.engineOptions.frontendWinId = static_cast<uintptr_t>(winId);
+    }   break;
+
+    case CB::ENGINE_OPTION_PROCESS_THREADS:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        gStandalone.engineOptions.processThreads = static_cast<uint>(value);
+        break;
+
+    case CB::ENGINE_OPTION_IDLE_POLL_INTERVAL:
+        CARLA_SAFE_ASSERT_RETURN(value > 0,);
+        gStandalone.engineOptions.idlePollInterval = static_cast<uint>(value);
+        break;
+
+    case CB::ENGINE_OPTION_PIPELINED_BRIDGES:
+        CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
+        gStandalone.engineOptions.pipelinedBridges = (value != 0);
+        break;
+
+    case CB::ENGINE_OPTION_BRIDGE_SOFT_DEADLINE:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        gStandalone.engineOptions.bridgeSoftDeadline = static_cast<uint>(value);
+        break;
+
+    case CB::ENGINE_OPTION_SPLIT_GRANULARITY:
+        CARLA_SAFE_ASSERT_RETURN(value >= 1,);
+        gStandalone.engineOptions.splitGranularity = static_cast<uint>(value);
+        break;
+
+    case CB::ENGINE_OPTION_LOW_LATENCY_BRIDGES:
+        CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
+        gStandalone.engineOptions.lowLatencyBridges = (value != 0);
         break;
     }
 
@@ -983,6 +1022,37 @@ bool carla_patchbay_refresh(bool external)
     return false;
 }
 
+const CarlaPatchbayGroupTiming* carla_get_patchbay_group_timing(uint groupId)
+{
+    static CarlaPatchbayGroupTiming retInfo;
+
+    // reset
+    retInfo.lastTime         = 0.0f;
+    retInfo.avgTime          = 0.0f;
+    retInfo.maxTime          = 0.0f;
+    retInfo.pathTime         = 0.0f;
+    retInfo.criticalPathTime = 0.0f;
+    retInfo.critical         = false;
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr && gStandalone.engine->isRunning(), &retInfo);
+    carla_debug("carla_get_patchbay_group_timing(%i)", groupId);
+
+    CB::EngineProcessNodeTiming timing;
+    float criticalPathUsecs = 0.0f;
+
+    if (! gStandalone.engine->getPatchbayGroupTiming(groupId, timing, criticalPathUsecs))
+        return &retInfo;
+
+    retInfo.lastTime         = timing.lastUsecs;
+    retInfo.avgTime          = timing.avgUsecs;
+    retInfo.maxTime          = timing.maxUsecs;
+    retInfo.pathTime         = timing.pathUsecs;
+    retInfo.criticalPathTime = criticalPathUsecs;
+    retInfo.critical         = timing.critical;
+
+    return &retInfo;
+}
+
 // -------------------------------------------------------------------------------------------------------------------
 
 void carla_transport_play()
@@ -1046,6 +1116,19 @@ const CarlaTransportInfo* carla_get_transport_info()
 
     return &retInfo;
 }
+
+bool carla_engine_render(const char* filename, uint64_t startFrame, uint64_t endFrame)
+{
+    CARLA_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+    carla_debug("carla_engine_render(\"%s\", " P_UINT64 ", " P_UINT64 ")", filename, startFrame, endFrame);
+
+    if (gStandalone.engine != nullptr)
+        return gStandalone.engine->renderToFile(filename, startFrame, endFrame);
+
+    carla_stderr2("Engine is not running");
+    gStandalone.lastError = "Engine is not running";
+    return false;
+}
 #endif
 
 // -------------------------------------------------------------------------------------------------------------------
@@ -1831,6 +1914,186 @@ float carla_get_internal_parameter_value(uint pluginId, int32_t parameterId)
 
 // -------------------------------------------------------------------------------------------------------------------
 
+// copy a string into the snapshot string area and return its offset, the area always starts with an empty string
+static uint32_t carla_add_snapshot_string(juce::MemoryOutputStream& strings, const uint32_t stringsOffset, const char* const str)
+{
+    if (str[0] == '\0')
+        return stringsOffset;
+
+    const uint32_t offset(stringsOffset + static_cast<uint32_t>(strings.getDataSize()));
+    strings.write(str, std::strlen(str)+1);
+    return offset;
+}
+
+const CarlaPluginSnapshot* carla_get_plugin_snapshot(uint pluginId)
+{
+    static const CarlaPluginSnapshot fallbackSnapshot;
+    static juce::MemoryBlock snapshotData;
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, &fallbackSnapshot);
+    carla_debug("carla_get_plugin_snapshot(%i)", pluginId);
+
+    CarlaPlugin* const plugin(gStandalone.engine->getPlugin(pluginId));
+
+    if (plugin == nullptr)
+    {
+        carla_stderr2("carla_get_plugin_snapshot(%i) - could not find plugin", pluginId);
+        return &fallbackSnapshot;
+    }
+
+    CarlaPluginSnapshot header;
+    header.generation         = plugin->updateGenerations();
+    header.parameterCount     = plugin->getParameterCount();
+    header.programCount       = plugin->getProgramCount();
+    header.midiProgramCount   = plugin->getMidiProgramCount();
+    header.currentProgram     = plugin->getCurrentProgram();
+    header.currentMidiProgram = plugin->getCurrentMidiProgram();
+
+    for (uint32_t i=0; i < header.parameterCount; ++i)
+        header.scalePointCount += plugin->getParameterScalePointCount(i);
+
+    // all entries are 4-byte aligned, so arrays can follow each other directly
+    header.parameters   = static_cast<uint32_t>(sizeof(CarlaPluginSnapshot));
+    header.scalePoints  = header.parameters   + header.parameterCount   * static_cast<uint32_t>(sizeof(CarlaParameterSnapshot));
+    header.programNames = header.scalePoints  + header.scalePointCount  * static_cast<uint32_t>(sizeof(CarlaScalePointSnapshot));
+    header.midiPrograms = header.programNames + header.programCount     * static_cast<uint32_t>(sizeof(uint32_t));
+
+    const uint32_t stringsOffset(header.midiPrograms + header.midiProgramCount * static_cast<uint32_t>(sizeof(CarlaMidiProgramSnapshot)));
+
+    snapshotData.setSize(stringsOffset, true);
+
+    char* const data(static_cast<char*>(snapshotData.getData()));
+    CarlaParameterSnapshot*   const params(reinterpret_cast<CarlaParameterSnapshot*>(data + header.parameters));
+    CarlaScalePointSnapshot*  const scalePoints(reinterpret_cast<CarlaScalePointSnapshot*>(data + header.scalePoints));
+    uint32_t*                 const programNames(reinterpret_cast<uint32_t*>(data + header.programNames));
+    CarlaMidiProgramSnapshot* const midiPrograms(reinterpret_cast<CarlaMidiProgramSnapshot*>(data + header.midiPrograms));
+
+    juce::MemoryOutputStream strings;
+    strings.writeByte('\0');
+
+    char strBuf[STR_MAX+1];
+
+    for (uint32_t i=0, scalePointIndex=0; i < header.parameterCount; ++i)
+    {
+        CarlaParameterSnapshot& param(params[i]);
+
+        param.data   = plugin->getParameterData(i);
+        param.ranges = plugin->getParameterRanges(i);
+        param.value  = plugin->getParameterValue(i);
+
+        carla_zeroChar(strBuf, STR_MAX+1);
+        plugin->getParameterName(i, strBuf);
+        param.name = carla_add_snapshot_string(strings, stringsOffset, strBuf);
+
+        carla_zeroChar(strBuf, STR_MAX+1);
+        plugin->getParameterSymbol(i, strBuf);
+        param.symbol = carla_add_snapshot_string(strings, stringsOffset, strBuf);
+
+        carla_zeroChar(strBuf, STR_MAX+1);
+        plugin->getParameterUnit(i, strBuf);
+        param.unit = carla_add_snapshot_string(strings, stringsOffset, strBuf);
+
+        if (param.data.hints & CB::PARAMETER_USES_CUSTOM_TEXT)
+        {
+            carla_zeroChar(strBuf, STR_MAX+1);
+            plugin->getParameterText(i, strBuf);
+            param.text = carla_add_snapshot_string(strings, stringsOffset, strBuf);
+        }
+        else
+        {
+            param.text = stringsOffset;
+        }
+
+        param.scalePointStart = scalePointIndex;
+        param.scalePointCount = plugin->getParameterScalePointCount(i);
+
+        for (uint32_t j=0; j < param.scalePointCount; ++j, ++scalePointIndex)
+        {
+            CarlaScalePointSnapshot& scalePoint(scalePoints[scalePointIndex]);
+
+            scalePoint.value = plugin->getParameterScalePointValue(i, j);
+
+            carla_zeroChar(strBuf, STR_MAX+1);
+            plugin->getParameterScalePointLabel(i, j, strBuf);
+            scalePoint.label = carla_add_snapshot_string(strings, stringsOffset, strBuf);
+        }
+    }
+
+    for (uint32_t i=0; i < header.programCount; ++i)
+    {
+        carla_zeroChar(strBuf, STR_MAX+1);
+        plugin->getProgramName(i, strBuf);
+        programNames[i] = carla_add_snapshot_string(strings, stringsOffset, strBuf);
+    }
+
+    for (uint32_t i=0; i < header.midiProgramCount; ++i)
+    {
+        const MidiProgramData& mpData(plugin->getMidiProgramData(i));
+        CarlaMidiProgramSnapshot& midiProgram(midiPrograms[i]);
+
+        midiProgram.bank    = mpData.bank;
+        midiProgram.program = mpData.program;
+        midiProgram.name    = carla_add_snapshot_string(strings, stringsOffset, mpData.name != nullptr ? mpData.name : "");
+    }
+
+    header.size = stringsOffset + static_cast<uint32_t>(strings.getDataSize());
+
+    // grows the block, any pointers taken above are invalid from here on
+    snapshotData.setSize(header.size);
+    snapshotData.copyFrom(strings.getData(), static_cast<int>(stringsOffset), strings.getDataSize());
+    snapshotData.copyFrom(&header, 0, sizeof(CarlaPluginSnapshot));
+
+    return static_cast<const CarlaPluginSnapshot*>(snapshotData.getData());
+}
+
+const CarlaPluginSnapshotChanges* carla_get_plugin_snapshot_changes(uint pluginId, uint32_t generation)
+{
+    static CarlaPluginSnapshotChanges retChanges;
+    static juce::Array<CarlaParameterChange> changeList;
+
+    // reset
+    retChanges.layoutChanged      = false;
+    retChanges.currentProgram     = -1;
+    retChanges.currentMidiProgram = -1;
+    retChanges.count              = 0;
+    retChanges.changes            = nullptr;
+    changeList.clearQuick();
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, &retChanges);
+    carla_debug("carla_get_plugin_snapshot_changes(%i, %u)", pluginId, generation);
+
+    if (CarlaPlugin* const plugin = gStandalone.engine->getPlugin(pluginId))
+    {
+        retChanges.generation         = plugin->updateGenerations();
+        retChanges.currentProgram     = plugin->getCurrentProgram();
+        retChanges.currentMidiProgram = plugin->getCurrentMidiProgram();
+
+        if (generation < plugin->getLayoutGeneration())
+        {
+            retChanges.layoutChanged = true;
+            return &retChanges;
+        }
+
+        for (uint32_t i=0, count=plugin->getParameterCount(); i < count; ++i)
+        {
+            if (plugin->getParameterGeneration(i) <= generation)
+                continue;
+
+            const CarlaParameterChange change = { i, plugin->getParameterValue(i) };
+            changeList.add(change);
+        }
+
+        retChanges.count   = static_cast<uint32_t>(changeList.size());
+        retChanges.changes = changeList.getRawDataPointer();
+        return &retChanges;
+    }
+
+    carla_stderr2("carla_get_plugin_snapshot_changes(%i, %u) - could not find plugin", pluginId, generation);
+    return &retChanges;
+}
+
+// -------------------------------------------------------------------------------------------------------------------
+
 float carla_get_input_peak_value(uint pluginId, bool isLeft)
 {
     CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, 0.0f);
@@ -1845,6 +2108,108 @@ float carla_get_output_peak_value(uint pluginId, bool isLeft)
     return gStandalone.engine->getOutputPeak(pluginId, isLeft);
 }
 
+static const CarlaDspLoadInfo* carla_get_dsp_load_info(const CB::EngineDspLoad& load)
+{
+    static CarlaDspLoadInfo retInfo;
+
+    retInfo.current      = load.current;
+    retInfo.average      = load.average;
+    retInfo.minimum      = load.minimum;
+    retInfo.maximum      = load.maximum;
+    retInfo.percentile95 = load.percentile95;
+    retInfo.percentile99 = load.percentile99;
+    retInfo.xruns        = load.xruns;
+    retInfo.cycles       = load.cycles;
+
+    return &retInfo;
+}
+
+const CarlaDspLoadInfo* carla_get_plugin_dsp_load(uint pluginId)
+{
+    CB::EngineDspLoad load;
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, carla_get_dsp_load_info(load));
+    carla_debug("carla_get_plugin_dsp_load(%i)", pluginId);
+
+    gStandalone.engine->getPluginDspLoad(pluginId, load);
+    return carla_get_dsp_load_info(load);
+}
+
+static const CarlaBridgeLatencyInfo* carla_get_bridge_latency_info(const CB::PluginBridgeLatency& latency)
+{
+    static CarlaBridgeLatencyInfo retInfo;
+    static_assert(sizeof(retInfo.histogram) == sizeof(latency.histogram), "Incorrect data");
+
+    retInfo.writeAverage   = latency.writeAverage;
+    retInfo.writeMaximum   = latency.writeMaximum;
+    retInfo.processAverage = latency.processAverage;
+    retInfo.processMaximum = latency.processMaximum;
+    retInfo.readAverage    = latency.readAverage;
+    retInfo.readMaximum    = latency.readMaximum;
+    retInfo.totalAverage   = latency.totalAverage;
+    retInfo.totalMaximum   = latency.totalMaximum;
+    retInfo.percentile95   = latency.percentile95;
+    retInfo.percentile99   = latency.percentile99;
+    retInfo.slowBlocks     = latency.slowBlocks;
+    retInfo.timeouts       = latency.timeouts;
+    retInfo.blocks         = latency.blocks;
+    std::memcpy(retInfo.histogram, latency.histogram, sizeof(retInfo.histogram));
+
+    return &retInfo;
+}
+
+const CarlaBridgeLatencyInfo* carla_get_plugin_bridge_latency(uint pluginId)
+{
+    CB::PluginBridgeLatency latency;
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, carla_get_bridge_latency_info(latency));
+    carla_debug("carla_get_plugin_bridge_latency(%i)", pluginId);
+
+    if (CarlaPlugin* const plugin = gStandalone.engine->getPlugin(pluginId))
+        plugin->getBridgeLatency(latency);
+
+    return carla_get_bridge_latency_info(latency);
+}
+
+void carla_reset_plugin_bridge_latency(uint pluginId)
+{
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr,);
+    carla_debug("carla_reset_plugin_bridge_latency(%i)", pluginId);
+
+    if (CarlaPlugin* const plugin = gStandalone.engine->getPlugin(pluginId))
+        return plugin->resetBridgeLatency();
+
+    carla_stderr2("carla_reset_plugin_bridge_latency(%i) - could not find plugin", pluginId);
+}
+
+const CarlaSubBlockInfo* carla_get_plugin_sub_blocks(uint pluginId)
+{
+    static CarlaSubBlockInfo retInfo;
+
+    // reset
+    retInfo.blocks    = 0;
+    retInfo.subBlocks = 0;
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, &retInfo);
+    carla_debug("carla_get_plugin_sub_blocks(%i)", pluginId);
+
+    if (CarlaPlugin* const plugin = gStandalone.engine->getPlugin(pluginId))
+        plugin->getSubBlockCount(retInfo.blocks, retInfo.subBlocks);
+
+    return &retInfo;
+}
+
+void carla_reset_plugin_sub_blocks(uint pluginId)
+{
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr,);
+    carla_debug("carla_reset_plugin_sub_blocks(%i)", pluginId);
+
+    if (CarlaPlugin* const plugin = gStandalone.engine->getPlugin(pluginId))
+        return plugin->resetSubBlockCount();
+
+    carla_stderr2("carla_reset_plugin_sub_blocks(%i) - could not find plugin", pluginId);
+}
+
 // -------------------------------------------------------------------------------------------------------------------
 
 void carla_set_active(uint pluginId, bool onOff)
@@ -2145,6 +2510,17 @@ double carla_get_sample_rate()
     return gStandalone.engine->getSampleRate();
 }
 
+const CarlaDspLoadInfo* carla_get_engine_load()
+{
+    CB::EngineDspLoad load;
+
+    CARLA_SAFE_ASSERT_RETURN(gStandalone.engine != nullptr, carla_get_dsp_load_info(load));
+    carla_debug("carla_get_engine_load()");
+
+    gStandalone.engine->getEngineLoad(load);
+    return carla_get_dsp_load_info(load);
+}
+
 // -------------------------------------------------------------------------------------------------------------------
 
 const char* carla_get_last_error()
@@ -61,9 +61,12 @@ SOURCES += \
     engine/CarlaEngineOsc.cpp \
     engine/CarlaEngineOscSend.cpp \
     engine/CarlaEnginePorts.cpp \
+    engine/CarlaEngineProcessPool.cpp \
     engine/CarlaEngineThread.cpp \
+    engine/CarlaEngineWorkerPool.cpp \
     engine/CarlaEngineJack.cpp \
     engine/CarlaEngineNative.cpp \
+    engine/CarlaEngineOffline.cpp \
     engine/CarlaEngineRtAudio.cpp
 
 SOURCES += \
@@ -81,6 +81,7 @@ uint CarlaEngine::getDriverCount()
 # else
     count += getRtAudioApiCount();
 # endif
+    count += 1; // offline
 #endif
 
     return count;
@@ -111,6 +112,9 @@ const char* CarlaEngine::getDriverName(const uint index2)
         index -= count;
     }
 # endif
+
+    if (index-- == 0)
+        return "Offline";
 #endif
 
     carla_stderr("CarlaEngine::getDriverName(%i) - invalid index", index2);
@@ -145,6 +149,12 @@ const char* const* CarlaEngine::getDriverDeviceNames(const uint index2)
         index -= count;
     }
 # endif
+
+    if (index-- == 0)
+    {
+        static const char* ret[1] = { nullptr };
+        return ret;
+    }
 #endif
 
     carla_stderr("CarlaEngine::getDriverDeviceNames(%i) - invalid index", index2);
@@ -183,6 +193,17 @@ const EngineDriverDeviceInfo* CarlaEngine::getDriverDeviceInfo(const uint index2
         index -= count;
     }
 # endif
+
+    if (index-- == 0)
+    {
+        static uint32_t bufSizes[10] = { 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 0 };
+        static double   sampleRates[8] = { 22050.0, 32000.0, 44100.0, 48000.0, 88200.0, 96000.0, 192000.0, 0.0 };
+        static EngineDriverDeviceInfo devInfo;
+        devInfo.hints       = 0x0;
+        devInfo.bufferSizes = bufSizes;
+        devInfo.sampleRates = sampleRates;
+        return &devInfo;
+    }
 #endif
 
     carla_stderr("CarlaEngine::getDriverDeviceNames(%i, \"%s\") - invalid index", index2, deviceName);
@@ -198,6 +219,9 @@ CarlaEngine* CarlaEngine::newDriverByName(const char* const driverName)
         return newJack();
 
 #ifndef BUILD_BRIDGE
+    if (std::strcmp(driverName, "Offline") == 0)
+        return newOffline();
+
 # if defined(CARLA_OS_MAC) || defined(CARLA_OS_WIN)
     // -------------------------------------------------------------------
     // macos
@@ -287,6 +311,10 @@ void CarlaEngine::idle() noexcept
     CARLA_SAFE_ASSERT_RETURN(pData->nextAction.opcode == kEnginePostActionNull,); // FIXME REMOVE
     CARLA_SAFE_ASSERT_RETURN(pData->nextPluginId == pData->maxPluginNumber,);
 
+#ifndef BUILD_BRIDGE
+    pData->reclaimPluginLists(false);
+#endif
+
     for (uint i=0; i < pData->curPluginCount; ++i)
     {
         CarlaPlugin* const plugin(pData->plugins[i].plugin);
@@ -309,6 +337,21 @@ void CarlaEngine::idle() noexcept
 #endif
 }
 
+void CarlaEngine::wakeUpIdleThread() noexcept
+{
+    pData->thread.wakeUp();
+}
+
+bool CarlaEngine::scheduleWork(CarlaPlugin* const plugin) noexcept
+{
+    return pData->workers.schedule(plugin);
+}
+
+void CarlaEngine::cancelWork(CarlaPlugin* const plugin) noexcept
+{
+    pData->workers.cancel(plugin);
+}
+
 CarlaEngineClient* CarlaEngine::addClient(CarlaPlugin* const)
 {
     return new CarlaEngineClient(*this);
@@ -528,28 +571,45 @@ bool CarlaEngine::addPlugin(const BinaryType btype, const PluginType ptype,
     plugin->registerToOscClient();
 #endif
 
+#ifndef BUILD_BRIDGE
+    EnginePluginList* const newList(pData->copyPluginList());
+
+    if (newList == nullptr)
+    {
+        delete plugin;
+        setLastError("Failed to allocate new plugin list");
+        return false;
+    }
+
+    EnginePluginData& pluginData(newList->plugins[id]);
+#else
     EnginePluginData& pluginData(pData->plugins[id]);
+#endif
     pluginData.plugin      = plugin;
     pluginData.insPeak[0]  = 0.0f;
     pluginData.insPeak[1]  = 0.0f;
     pluginData.outsPeak[0] = 0.0f;
     pluginData.outsPeak[1] = 0.0f;
+    pluginData.dspLoad.clear();
 
 #ifndef BUILD_BRIDGE
     if (oldPlugin != nullptr)
     {
-        // the engine thread might be reading from the old plugin
-        pData->thread.stopThread(500);
-        pData->thread.startThread();
+        const bool  wasActive = oldPlugin->getInternalParameterValue(PARAMETER_ACTIVE) >= 0.5f;
+        const float oldDryWet = oldPlugin->getInternalParameterValue(PARAMETER_DRYWET);
+        const float oldVolume = oldPlugin->getInternalParameterValue(PARAMETER_VOLUME);
 
         if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
             pData->graph.replacePlugin(oldPlugin, plugin);
 
-        const bool  wasActive = oldPlugin->getInternalParameterValue(PARAMETER_ACTIVE) >= 0.5f;
-        const float oldDryWet = oldPlugin->getInternalParameterValue(PARAMETER_DRYWET);
-        const float oldVolume = oldPlugin->getInternalParameterValue(PARAMETER_VOLUME);
+        // the engine thread might be reading from the old plugin
+        pData->thread.stopThread(500);
+
+        // old plugin is deleted once the audio thread picks up the new list
+        newList->removed[newList->removedCount++] = oldPlugin;
+        pData->publishPluginList(newList, isRunning());
 
-        delete oldPlugin;
+        pData->thread.startThread();
 
         if (plugin->getHints() & PLUGIN_CAN_DRYWET)
             plugin->setDryWet(oldDryWet, true, true);
@@ -565,7 +625,12 @@ bool CarlaEngine::addPlugin(const BinaryType btype, const PluginType ptype,
     else
 #endif
     {
+#ifndef BUILD_BRIDGE
+        ++newList->count;
+        pData->publishPluginList(newList, isRunning());
+#else
         ++pData->curPluginCount;
+#endif
         callback(ENGINE_CALLBACK_PLUGIN_ADDED, id, 0, 0, 0.0f, plugin->getName());
 
 #ifndef BUILD_BRIDGE
@@ -599,20 +664,43 @@ bool CarlaEngine::removePlugin(const uint id)
     pData->thread.stopThread(500);
 
 #ifndef BUILD_BRIDGE
+    EnginePluginList* const newList(pData->copyPluginList());
+
+    if (newList == nullptr)
+    {
+        if (isRunning() && ! pData->aboutToClose)
+            pData->thread.startThread();
+
+        setLastError("Failed to allocate new plugin list");
+        return false;
+    }
+
     if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
         pData->graph.removePlugin(plugin);
 
-    const bool lockWait(isRunning() /*&& pData->options.processMode != ENGINE_PROCESS_MODE_MULTIPLE_CLIENTS*/);
-    const ScopedActionLock sal(pData, kEnginePostActionRemovePlugin, id, 0, lockWait);
-
-    /*
-    for (uint i=id; i < pData->curPluginCount; ++i)
+    // move all plugins 1 spot backwards, their Ids change once the new list is published
+    for (uint i=id+1; i < newList->count; ++i)
     {
-        CarlaPlugin* const plugin2(pData->plugins[i].plugin);
+        CarlaPlugin* const plugin2(newList->plugins[i].plugin);
+
         CARLA_SAFE_ASSERT_BREAK(plugin2 != nullptr);
-        plugin2->updateOscURL();
+
+        EnginePluginData& pluginData(newList->plugins[i-1]);
+        pluginData.plugin      = plugin2;
+        pluginData.insPeak[0]  = 0.0f;
+        pluginData.insPeak[1]  = 0.0f;
+        pluginData.outsPeak[0] = 0.0f;
+        pluginData.outsPeak[1] = 0.0f;
+        carla_copyStruct(pluginData.dspLoad, newList->plugins[i].dspLoad);
     }
-    */
+
+    --newList->count;
+    carla_zeroStruct(newList->plugins[newList->count]);
+
+    // plugin is deleted once the audio thread picks up the new list
+    newList->removed[newList->removedCount++] = plugin;
+
+    pData->publishPluginList(newList, isRunning());
 
 # ifdef HAVE_LIBLO
     if (isOscControlRegistered())
@@ -621,9 +709,9 @@ bool CarlaEngine::removePlugin(const uint id)
 #else
     pData->curPluginCount = 0;
     carla_zeroStruct(pData->plugins, 1);
-#endif
 
     delete plugin;
+#endif
 
     if (isRunning() && ! pData->aboutToClose)
         pData->thread.startThread();
@@ -646,10 +734,36 @@ bool CarlaEngine::removeAllPlugins()
     pData->thread.stopThread(500);
 
 #ifndef BUILD_BRIDGE
+    EnginePluginList* const newList(pData->copyPluginList());
+
+    if (newList == nullptr)
+    {
+        if (isRunning() && ! pData->aboutToClose)
+            pData->thread.startThread();
+
+        setLastError("Failed to allocate new plugin list");
+        return false;
+    }
+
     if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
         pData->graph.removeAllPlugins(this);
-#endif
 
+    // plugins are deleted once the audio thread picks up the new list
+    for (uint i=0; i < newList->count; ++i)
+    {
+        EnginePluginData& pluginData(newList->plugins[i]);
+
+        if (pluginData.plugin != nullptr)
+            newList->removed[newList->removedCount++] = pluginData.plugin;
+
+        carla_zeroStruct(pluginData);
+    }
+
+    newList->count = 0;
+    pData->publishPluginList(newList, isRunning());
+
+    callback(ENGINE_CALLBACK_IDLE, 0, 0, 0, 0.0f, nullptr);
+#else
     const uint32_t curPluginCount(pData->curPluginCount);
 
     const bool lockWait(isRunning());
@@ -671,9 +785,11 @@ bool CarlaEngine::removeAllPlugins()
         pluginData.insPeak[1]  = 0.0f;
         pluginData.outsPeak[0] = 0.0f;
         pluginData.outsPeak[1] = 0.0f;
+        pluginData.dspLoad.clear();
 
         callback(ENGINE_CALLBACK_IDLE, 0, 0, 0, 0.0f, nullptr);
     }
+#endif
 
     if (isRunning() && ! pData->aboutToClose)
         pData->thread.startThread();
@@ -787,14 +903,26 @@ bool CarlaEngine::switchPlugins(const uint idA, const uint idB) noexcept
         CARLA_SAFE_ASSERT_RETURN_ERR(pluginA->getId() == idA, "Invalid engine internal data");
         CARLA_SAFE_ASSERT_RETURN_ERR(pluginB->getId() == idB, "Invalid engine internal data");
 
+        EnginePluginList* const newList(pData->copyPluginList());
+        CARLA_SAFE_ASSERT_RETURN_ERR(newList != nullptr, "Failed to allocate new plugin list");
+
         pData->thread.stopThread(500);
 
         if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
             pData->graph.replacePlugin(pluginA, pluginB);
-    }
 
-    const bool lockWait(isRunning() /*&& pData->options.processMode != ENGINE_PROCESS_MODE_MULTIPLE_CLIENTS*/);
-    const ScopedActionLock sal(pData, kEnginePostActionSwitchPlugins, idA, idB, lockWait);
+        newList->plugins[idA].plugin = pluginB;
+        newList->plugins[idB].plugin = pluginA;
+
+        // processing load follows its plugin
+        EngineDspLoadStats dspLoad;
+        carla_copyStruct(dspLoad, newList->plugins[idA].dspLoad);
+        carla_copyStruct(newList->plugins[idA].dspLoad, newList->plugins[idB].dspLoad);
+        carla_copyStruct(newList->plugins[idB].dspLoad, dspLoad);
+
+        // Ids are switched once the new list is published
+        pData->publishPluginList(newList, isRunning());
+    }
 
     /*
     CarlaPlugin* const pluginA(pData->plugins[idA].plugin);
@@ -1087,6 +1215,24 @@ float CarlaEngine::getOutputPeak(const uint pluginId, const bool isLeft) const n
     return pData->plugins[pluginId].outsPeak[isLeft ? 0 : 1];
 }
 
+// -----------------------------------------------------------------------
+// Information (processing load)
+
+bool CarlaEngine::getPluginDspLoad(const uint pluginId, EngineDspLoad& load) const noexcept
+{
+    load.clear();
+
+    CARLA_SAFE_ASSERT_RETURN(pluginId < pData->curPluginCount, false);
+
+    pData->plugins[pluginId].dspLoad.get(load);
+    return true;
+}
+
+void CarlaEngine::getEngineLoad(EngineDspLoad& load) const noexcept
+{
+    pData->dspLoad.get(load);
+}
+
 // -----------------------------------------------------------------------
 // Callback
 
@@ -1175,6 +1321,17 @@ void CarlaEngine::transportRelocate(const uint64_t frame) noexcept
     pData->time.frame = frame;
 }
 
+#ifndef BUILD_BRIDGE
+// -----------------------------------------------------------------------
+// Offline rendering
+
+bool CarlaEngine::renderToFile(const char* const, const uint64_t, const uint64_t)
+{
+    setLastError("Rendering to file is only supported by the offline engine driver");
+    return false;
+}
+#endif
+
 // -----------------------------------------------------------------------
 // Error handling
 
@@ -1202,7 +1359,7 @@ void CarlaEngine::setOption(const EngineOption option, const int value, const ch
 {
     carla_debug("CarlaEngine::setOption(%i:%s, %i, \"%s\")", option, EngineOption2Str(option), value, valueStr);
 
-    if (isRunning() && (option == ENGINE_OPTION_PROCESS_MODE || option == ENGINE_OPTION_AUDIO_NUM_PERIODS || option == ENGINE_OPTION_AUDIO_DEVICE))
+    if (isRunning() && (option == ENGINE_OPTION_PROCESS_MODE || option == ENGINE_OPTION_AUDIO_NUM_PERIODS || option == ENGINE_OPTION_AUDIO_DEVICE || option == ENGINE_OPTION_PROCESS_THREADS))
         return carla_stderr("CarlaEngine::setOption(%i:%s, %i, \"%s\") - Cannot set this option while engine is running!", option, EngineOption2Str(option), value, valueStr);
 
     if (option == ENGINE_OPTION_FORCE_STEREO && pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK)
@@ -1399,11 +1556,41 @@ void CarlaEngine::setOption(const EngineOption option, const int value, const ch
 #endif
         break;
 
-    case ENGINE_OPTION_FRONTEND_WIN_ID:
+    case ENGINE_OPTION_FRONTEND_WIN_ID: {
         CARLA_SAFE_ASSERT_RETURN(valueStr != nullptr && valueStr[0] != '\0',);
         const long long winId(std::strtoll(valueStr, nullptr, 16));
         CARLA_SAFE_ASSERT_RETURN(winId >= 0,);
         pData->options.frontendWinId = static_cast<uintptr_t>(winId);
+    }   break;
+
+    case ENGINE_OPTION_PROCESS_THREADS:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        pData->options.processThreads = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_IDLE_POLL_INTERVAL:
+        CARLA_SAFE_ASSERT_RETURN(value > 0,);
+        pData->options.idlePollInterval = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_PIPELINED_BRIDGES:
+        CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
+        pData->options.pipelinedBridges = (value != 0);
+        break;
+
+    case ENGINE_OPTION_BRIDGE_SOFT_DEADLINE:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        pData->options.bridgeSoftDeadline = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_SPLIT_GRANULARITY:
+        CARLA_SAFE_ASSERT_RETURN(value >= 1,);
+        pData->options.splitGranularity = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_LOW_LATENCY_BRIDGES:
+        CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
+        pData->options.lowLatencyBridges = (value != 0);
         break;
     }
 }
@@ -1438,9 +1625,9 @@ const char* CarlaEngine::getOscServerPathUDP() const noexcept
 // -----------------------------------------------------------------------
 // Helper functions
 
-EngineEvent* CarlaEngine::getInternalEventBuffer(const bool isInput) const noexcept
+EngineEventBuffer* CarlaEngine::getInternalEventBuffer(const bool isInput) const noexcept
 {
-    return isInput ? pData->events.in : pData->events.out;
+    return isInput ? &pData->events.in : &pData->events.out;
 }
 
 void CarlaEngine::lockEnvironment() const noexcept
@@ -1525,6 +1712,9 @@ void CarlaEngine::offlineModeChanged(const bool isOfflineNow)
 
 void CarlaEngine::runPendingRtEvents() noexcept
 {
+#ifndef BUILD_BRIDGE
+    pData->updateRtPluginList();
+#endif
     pData->doNextPluginAction(true);
 
     if (pData->time.playing)
@@ -1539,7 +1729,14 @@ void CarlaEngine::runPendingRtEvents() noexcept
 
 void CarlaEngine::setPluginPeaks(const uint pluginId, float const inPeaks[2], float const outPeaks[2]) noexcept
 {
+#ifndef BUILD_BRIDGE
+    CARLA_SAFE_ASSERT_RETURN(pData->rtPluginList != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(pluginId < pData->maxPluginNumber,);
+
+    EnginePluginData& pluginData(pData->rtPluginList->plugins[pluginId]);
+#else
     EnginePluginData& pluginData(pData->plugins[pluginId]);
+#endif
 
     pluginData.insPeak[0]  = inPeaks[0];
     pluginData.insPeak[1]  = inPeaks[1];
@@ -1547,6 +1744,23 @@ void CarlaEngine::setPluginPeaks(const uint pluginId, float const inPeaks[2], fl
     pluginData.outsPeak[1] = outPeaks[1];
 }
 
+void CarlaEngine::setPluginProcessTime(const uint pluginId, const double seconds, const uint32_t frames) noexcept
+{
+    if (isOffline())
+        return;
+
+#ifndef BUILD_BRIDGE
+    CARLA_SAFE_ASSERT_RETURN(pData->rtPluginList != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(pluginId < pData->maxPluginNumber,);
+
+    EnginePluginData& pluginData(pData->rtPluginList->plugins[pluginId]);
+#else
+    EnginePluginData& pluginData(pData->plugins[pluginId]);
+#endif
+
+    pluginData.dspLoad.add(seconds, frames, pData->sampleRate);
+}
+
 void CarlaEngine::saveProjectInternal(juce::MemoryOutputStream& outStream) const
 {
     // send initial prepareForSave first, giving time for bridges to act
@@ -54,6 +54,7 @@ SOURCES  = \
     CarlaEngine.cpp \
     CarlaEngineOsc.cpp \
     CarlaEngineThread.cpp \
+    CarlaEngineWorkerPool.cpp \
     CarlaEngineBridge.cpp \
     CarlaEngineJack.cpp \
     CarlaEngineJuce.cpp \
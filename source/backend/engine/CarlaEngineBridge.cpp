@@ -97,6 +97,157 @@ struct BridgeAudioPool {
 
 // -------------------------------------------------------------------
 
+// owned by the client, unlike the other areas, as only the client knows how big it needs to be.
+// growing it creates a new area, the server attaches to it by name for each bulk message.
+struct BridgeParameterPool {
+    CarlaString filename;
+    uint8_t* data;
+    std::size_t size;
+    char shm[64];
+
+    BridgeParameterPool() noexcept
+        : filename(),
+          data(nullptr),
+          size(0)
+    {
+        carla_zeroChar(shm, 64);
+        jackbridge_shm_init(shm);
+    }
+
+    ~BridgeParameterPool() noexcept
+    {
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        filename.clear();
+        size = 0;
+
+        if (! jackbridge_shm_is_valid(shm))
+        {
+            CARLA_SAFE_ASSERT(data == nullptr);
+            return;
+        }
+
+        if (data != nullptr)
+        {
+            jackbridge_shm_unmap(shm, data);
+            data = nullptr;
+        }
+
+        jackbridge_shm_close(shm);
+        jackbridge_shm_init(shm);
+    }
+
+    bool resize(const std::size_t newSize) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(newSize > 0, false);
+
+        if (newSize <= size)
+            return true;
+
+        clear();
+
+        char tmpFileBase[64];
+        std::sprintf(tmpFileBase, PLUGIN_BRIDGE_NAMEPREFIX_PARAMETERS "XXXXXX");
+
+        jackbridge_shm_create_temp(shm, tmpFileBase);
+
+        if (! jackbridge_shm_is_valid(shm))
+            return false;
+
+        data = (uint8_t*)jackbridge_shm_map(shm, newSize);
+
+        if (data == nullptr)
+        {
+            clear();
+            return false;
+        }
+
+        filename = tmpFileBase;
+        size     = newSize;
+        return true;
+    }
+
+    CARLA_DECLARE_NON_COPY_STRUCT(BridgeParameterPool)
+};
+
+// -------------------------------------------------------------------
+
+// raw chunk data sent to the server, kept until the server tells us it was read
+struct BridgeChunkShm {
+    CarlaString filename;
+    void* data;
+    char shm[64];
+
+    BridgeChunkShm() noexcept
+        : filename(),
+          data(nullptr)
+    {
+        carla_zeroChar(shm, 64);
+        jackbridge_shm_init(shm);
+    }
+
+    ~BridgeChunkShm() noexcept
+    {
+        clear();
+    }
+
+    bool write(const void* const chunk, const std::size_t size) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(chunk != nullptr, false);
+        CARLA_SAFE_ASSERT_RETURN(size > 0, false);
+
+        clear();
+
+        char tmpFileBase[64];
+        std::sprintf(tmpFileBase, PLUGIN_BRIDGE_NAMEPREFIX_CHUNK "XXXXXX");
+
+        jackbridge_shm_create_temp(shm, tmpFileBase);
+
+        if (! jackbridge_shm_is_valid(shm))
+            return false;
+
+        data = jackbridge_shm_map(shm, size);
+
+        if (data == nullptr)
+        {
+            clear();
+            return false;
+        }
+
+        std::memcpy(data, chunk, size);
+
+        filename = tmpFileBase;
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        filename.clear();
+
+        if (! jackbridge_shm_is_valid(shm))
+        {
+            CARLA_SAFE_ASSERT(data == nullptr);
+            return;
+        }
+
+        if (data != nullptr)
+        {
+            jackbridge_shm_unmap(shm, data);
+            data = nullptr;
+        }
+
+        jackbridge_shm_close(shm);
+        jackbridge_shm_init(shm);
+    }
+
+    CARLA_DECLARE_NON_COPY_STRUCT(BridgeChunkShm)
+};
+
+// -------------------------------------------------------------------
+
 struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
     CarlaString filename;
     BridgeRtClientData* data;
@@ -166,6 +317,9 @@ struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
     {
         CARLA_SAFE_ASSERT_RETURN(data != nullptr, false);
 
+        if (data->sem.lowLatency != 0)
+            return jackbridge_futex_sem_post(&data->sem.futexClient);
+
         return jackbridge_sem_post(&data->sem.client);
     }
 
@@ -173,6 +327,9 @@ struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
     {
         CARLA_SAFE_ASSERT_RETURN(data != nullptr, false);
 
+        if (data->sem.lowLatency != 0)
+            return jackbridge_futex_sem_timedwait(&data->sem.futexServer, secs, timedOut);
+
         return jackbridge_sem_timedwait(&data->sem.server, secs, timedOut);
     }
 
@@ -373,6 +530,8 @@ public:
           fShmRtClientControl(),
           fShmNonRtClientControl(),
           fShmNonRtServerControl(),
+          fShmParameterPool(),
+          fShmChunk(),
           fIsOffline(false),
           fFirstIdle(true),
           fLastPingTime(-1),
@@ -629,7 +788,10 @@ public:
                 fShmNonRtServerControl.writeUInt(count);
                 fShmNonRtServerControl.commitWrite();
 
-                for (uint32_t i=0; i<count; ++i)
+                // kPluginBridgeNonRtServerParameterDataBulk, or one message per parameter if that fails
+                const bool sentInBulk(writeParameterDataBulk(plugin, count));
+
+                for (uint32_t i=0; i<count && ! sentInBulk; ++i)
                 {
                     const ParameterData& paramData(plugin->getParameterData(i));
 
@@ -864,12 +1026,110 @@ public:
 
     // -------------------------------------------------------------------
 
+    // called from idle() with the server control mutex locked
+    bool writeParameterDataBulk(CarlaPlugin* const plugin, const uint32_t count) noexcept
+    {
+        std::vector<BridgeParameterData> params;
+        std::vector<char> strings;
+
+        try {
+            params.reserve(count);
+        } CARLA_SAFE_EXCEPTION_RETURN("writeParameterDataBulk reserve", false);
+
+        char bufStr[STR_MAX+1];
+
+        for (uint32_t i=0; i<count; ++i)
+        {
+            const ParameterData& paramData(plugin->getParameterData(i));
+
+            if (paramData.type != PARAMETER_INPUT && paramData.type != PARAMETER_OUTPUT)
+                continue;
+            if ((paramData.hints & PARAMETER_IS_ENABLED) == 0)
+                continue;
+
+            const ParameterRanges& paramRanges(plugin->getParameterRanges(i));
+
+            BridgeParameterData bulkData;
+            carla_zeroStruct(bulkData);
+
+            bulkData.index  = i;
+            bulkData.rindex = paramData.rindex;
+            bulkData.type   = paramData.type;
+            bulkData.hints  = paramData.hints;
+            bulkData.midiCC = paramData.midiCC;
+
+            bulkData.def       = paramRanges.def;
+            bulkData.min       = paramRanges.min;
+            bulkData.max       = paramRanges.max;
+            bulkData.step      = paramRanges.step;
+            bulkData.stepSmall = paramRanges.stepSmall;
+            bulkData.stepLarge = paramRanges.stepLarge;
+
+            bulkData.value = plugin->getParameterValue(i);
+
+            try {
+                carla_zeroChar(bufStr, STR_MAX+1);
+                plugin->getParameterName(i, bufStr);
+                bulkData.nameOffset = appendBulkString(strings, bufStr);
+
+                carla_zeroChar(bufStr, STR_MAX+1);
+                plugin->getParameterSymbol(i, bufStr);
+                bulkData.symbolOffset = appendBulkString(strings, bufStr);
+
+                carla_zeroChar(bufStr, STR_MAX+1);
+                plugin->getParameterUnit(i, bufStr);
+                bulkData.unitOffset = appendBulkString(strings, bufStr);
+
+                params.push_back(bulkData);
+            } CARLA_SAFE_EXCEPTION_RETURN("writeParameterDataBulk strings", false);
+        }
+
+        const uint32_t written(static_cast<uint32_t>(params.size()));
+        const std::size_t paramsSize(params.size()*sizeof(BridgeParameterData));
+        const std::size_t dataSize(paramsSize + strings.size());
+
+        // nothing to send
+        if (written == 0)
+            return true;
+
+        if (! fShmParameterPool.resize(dataSize))
+            return false;
+
+        if (paramsSize > 0)
+            std::memcpy(fShmParameterPool.data, params.data(), paramsSize);
+        if (strings.size() > 0)
+            std::memcpy(fShmParameterPool.data + paramsSize, strings.data(), strings.size());
+
+        // uint/count, uint/size, uint/size, str[] (shm size, shm name)
+        const uint32_t filenameSize(static_cast<uint32_t>(fShmParameterPool.filename.length()));
+
+        fShmNonRtServerControl.writeOpcode(kPluginBridgeNonRtServerParameterDataBulk);
+        fShmNonRtServerControl.writeUInt(written);
+        fShmNonRtServerControl.writeUInt(static_cast<uint32_t>(dataSize));
+        fShmNonRtServerControl.writeUInt(filenameSize);
+        fShmNonRtServerControl.writeCustomData(fShmParameterPool.filename.buffer(), filenameSize);
+        fShmNonRtServerControl.commitWrite();
+        fShmNonRtServerControl.waitIfDataIsReachingLimit();
+
+        return true;
+    }
+
+    // returns the offset of the string within the bulk string area
+    static uint32_t appendBulkString(std::vector<char>& strings, const char* const str)
+    {
+        const uint32_t offset(static_cast<uint32_t>(strings.size()));
+        strings.insert(strings.end(), str, str + std::strlen(str) + 1);
+        return offset;
+    }
+
     void clear() noexcept
     {
         fShmAudioPool.clear();
         fShmRtClientControl.clear();
         fShmNonRtClientControl.clear();
         fShmNonRtServerControl.clear();
+        fShmParameterPool.clear();
+        fShmChunk.clear();
     }
 
     void handleNonRtData()
@@ -1045,6 +1305,62 @@ public:
                 break;
             }
 
+            case kPluginBridgeNonRtClientSetChunkDataShm: {
+                // ulong/size, uint/size, str[] (shm name)
+                const uint64_t chunkSize(fShmNonRtClientControl.readULong());
+
+                const uint32_t chunkShmNameSize(fShmNonRtClientControl.readUInt());
+                CARLA_SAFE_ASSERT_BREAK(chunkShmNameSize > 0);
+
+                char chunkShmName[chunkShmNameSize+1];
+                carla_zeroChar(chunkShmName, chunkShmNameSize+1);
+                fShmNonRtClientControl.readCustomData(chunkShmName, chunkShmNameSize);
+
+                if (chunkSize > 0 && plugin != nullptr && plugin->isEnabled())
+                {
+                    char chunkShm[64];
+                    carla_zeroChar(chunkShm, 64);
+                    jackbridge_shm_init(chunkShm);
+                    jackbridge_shm_attach(chunkShm, chunkShmName);
+
+                    if (jackbridge_shm_is_valid(chunkShm))
+                    {
+                        // plugin reads straight from shared memory, no extra copy
+                        if (void* const chunk = jackbridge_shm_map(chunkShm, static_cast<size_t>(chunkSize)))
+                        {
+                            plugin->setChunkData(chunk, static_cast<std::size_t>(chunkSize));
+                            jackbridge_shm_unmap(chunkShm, chunk);
+                        }
+
+                        jackbridge_shm_close(chunkShm);
+                    }
+                }
+
+                // let the server free it
+                const CarlaMutexLocker _cml(fShmNonRtServerControl.mutex);
+
+                fShmNonRtServerControl.writeOpcode(kPluginBridgeNonRtServerChunkDataShmRead);
+                fShmNonRtServerControl.writeUInt(chunkShmNameSize);
+                fShmNonRtServerControl.writeCustomData(chunkShmName, chunkShmNameSize);
+                fShmNonRtServerControl.commitWrite();
+                break;
+            }
+
+            case kPluginBridgeNonRtClientChunkDataShmRead: {
+                // uint/size, str[] (shm name)
+                const uint32_t chunkShmNameSize(fShmNonRtClientControl.readUInt());
+                CARLA_SAFE_ASSERT_BREAK(chunkShmNameSize > 0);
+
+                char chunkShmName[chunkShmNameSize+1];
+                carla_zeroChar(chunkShmName, chunkShmNameSize+1);
+                fShmNonRtClientControl.readCustomData(chunkShmName, chunkShmNameSize);
+
+                // a newer chunk might have been sent meanwhile
+                if (fShmChunk.filename == chunkShmName)
+                    fShmChunk.clear();
+                break;
+            }
+
             case kPluginBridgeNonRtClientSetCtrlChannel: {
                 const int16_t channel(fShmNonRtClientControl.readShort());
                 CARLA_SAFE_ASSERT_BREAK(channel >= -1 && channel < MAX_MIDI_CHANNELS);
@@ -1105,6 +1421,21 @@ public:
                     {
                         CARLA_SAFE_ASSERT_BREAK(data != nullptr);
 
+                        // raw data through shared memory, base64 file as fallback
+                        if (fShmChunk.write(data, dataSize))
+                        {
+                            const uint32_t ulength(static_cast<uint32_t>(fShmChunk.filename.length()));
+
+                            const CarlaMutexLocker _cml(fShmNonRtServerControl.mutex);
+
+                            fShmNonRtServerControl.writeOpcode(kPluginBridgeNonRtServerSetChunkDataShm);
+                            fShmNonRtServerControl.writeULong(static_cast<uint64_t>(dataSize));
+                            fShmNonRtServerControl.writeUInt(ulength);
+                            fShmNonRtServerControl.writeCustomData(fShmChunk.filename.buffer(), ulength);
+                            fShmNonRtServerControl.commitWrite();
+                            break;
+                        }
+
                         CarlaString dataBase64 = CarlaString::asBase64(data, dataSize);
                         CARLA_SAFE_ASSERT_BREAK(dataBase64.length() > 0);
 
@@ -1429,17 +1760,13 @@ protected:
                     carla_zeroBytes(midiData, kBridgeRtClientDataMidiOutSize);
                     std::size_t curMidiDataPos = 0;
 
-                    if (pData->events.in[0].type != kEngineEventTypeNull)
-                        carla_zeroStruct<EngineEvent>(pData->events.in,  kMaxEngineEventInternalCount);
+                    pData->events.in.clear();
 
-                    if (pData->events.out[0].type != kEngineEventTypeNull)
+                    if (pData->events.out.count != 0)
                     {
-                        for (ushort i=0; i < kMaxEngineEventInternalCount; ++i)
+                        for (uint32_t i=0; i < pData->events.out.count; ++i)
                         {
-                            const EngineEvent& event(pData->events.out[i]);
-
-                            if (event.type == kEngineEventTypeNull)
-                                break;
+                            const EngineEvent& event(pData->events.out.data[i]);
 
                             if (event.type == kEngineEventTypeControl)
                             {
@@ -1490,7 +1817,7 @@ protected:
                             }
                         }
 
-                        carla_zeroStruct<EngineEvent>(pData->events.out, kMaxEngineEventInternalCount);
+                        pData->events.out.clear();
                     }
 
                 }   break;
@@ -1524,14 +1851,7 @@ protected:
     // called from process thread above
     EngineEvent* getNextFreeInputEvent() const noexcept
     {
-        for (ushort i=0; i < kMaxEngineEventInternalCount; ++i)
-        {
-            EngineEvent* const event(&pData->events.in[i]);
-
-            if (event->type == kEngineEventTypeNull)
-                return event;
-        }
-        return nullptr;
+        return pData->events.in.append();
     }
 
     // -------------------------------------------------------------------
@@ -1541,6 +1861,8 @@ private:
     BridgeRtClientControl    fShmRtClientControl;
     BridgeNonRtClientControl fShmNonRtClientControl;
     BridgeNonRtServerControl fShmNonRtServerControl;
+    BridgeParameterPool      fShmParameterPool;
+    BridgeChunkShm           fShmChunk;
 
     bool fIsOffline;
     bool fFirstIdle;
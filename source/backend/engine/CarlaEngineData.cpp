@@ -212,7 +212,13 @@ EngineOptions::EngineOptions() noexcept
       binaryDir(nullptr),
       resourceDir(nullptr),
       preventBadBehaviour(false),
-      frontendWinId(0) {}
+      frontendWinId(0),
+      processThreads(0),
+      idlePollInterval(25),
+      pipelinedBridges(false),
+      bridgeSoftDeadline(75),
+      splitGranularity(1),
+      lowLatencyBridges(false) {}
 
 EngineOptions::~EngineOptions() noexcept
 {
@@ -336,6 +342,50 @@ bool EngineTimeInfo::operator!=(const EngineTimeInfo& timeInfo) const noexcept
     return !operator==(timeInfo);
 }
 
+// -----------------------------------------------------------------------
+// EngineProcessNodeTiming
+
+EngineProcessNodeTiming::EngineProcessNodeTiming() noexcept
+    : lastUsecs(0.0f),
+      avgUsecs(0.0f),
+      maxUsecs(0.0f),
+      pathUsecs(0.0f),
+      critical(false) {}
+
+void EngineProcessNodeTiming::clear() noexcept
+{
+    lastUsecs = 0.0f;
+    avgUsecs  = 0.0f;
+    maxUsecs  = 0.0f;
+    pathUsecs = 0.0f;
+    critical  = false;
+}
+
+// -----------------------------------------------------------------------
+// EngineDspLoad
+
+EngineDspLoad::EngineDspLoad() noexcept
+    : current(0.0f),
+      average(0.0f),
+      minimum(0.0f),
+      maximum(0.0f),
+      percentile95(0.0f),
+      percentile99(0.0f),
+      xruns(0),
+      cycles(0) {}
+
+void EngineDspLoad::clear() noexcept
+{
+    current      = 0.0f;
+    average      = 0.0f;
+    minimum      = 0.0f;
+    maximum      = 0.0f;
+    percentile95 = 0.0f;
+    percentile99 = 0.0f;
+    xruns        = 0;
+    cycles       = 0;
+}
+
 // -----------------------------------------------------------------------
 
 CARLA_BACKEND_END_NAMESPACE
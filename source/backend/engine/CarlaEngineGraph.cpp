@@ -25,10 +25,14 @@
 using juce::AudioPluginInstance;
 using juce::AudioProcessor;
 using juce::AudioProcessorEditor;
+using juce::Array;
 using juce::FloatVectorOperations;
 using juce::MemoryBlock;
+using juce::OwnedArray;
 using juce::PluginDescription;
+using juce::ScopedPointer;
 using juce::String;
+using juce::Time;
 using juce::jmax;
 
 CARLA_BACKEND_START_NAMESPACE
@@ -82,6 +86,29 @@ const char* getCarlaRackFullPortNameFromId(const /*RackGraphCarlaPortIds*/ uint
     return nullptr;
 }
 
+// -----------------------------------------------------------------------
+// RackGraph Routes
+
+RackGraphRoutes::RackGraphRoutes(const uint count)
+    : routes(nullptr),
+      inCount(0),
+      outCount(0),
+      serial(0),
+      older(nullptr)
+{
+    if (count > 0)
+        routes = new Route[count];
+}
+
+RackGraphRoutes::~RackGraphRoutes() noexcept
+{
+    if (routes != nullptr)
+    {
+        delete[] routes;
+        routes = nullptr;
+    }
+}
+
 // -----------------------------------------------------------------------
 // RackGraph Audio
 
@@ -90,7 +117,9 @@ RackGraph::Audio::Audio() noexcept
       connectedIn1(),
       connectedIn2(),
       connectedOut1(),
-      connectedOut2()
+      connectedOut2(),
+      routes(nullptr),
+      rtSerial(0)
 #ifdef CARLA_PROPER_CPP11_SUPPORT
     , inBuf{nullptr, nullptr},
       inBufTmp{nullptr, nullptr},
@@ -166,6 +195,7 @@ RackGraph::RackGraph(const uint32_t bufferSize, const uint32_t ins, const uint32
 RackGraph::~RackGraph() noexcept
 {
     clearConnections();
+    reclaimRoutes(true);
 }
 
 void RackGraph::setBufferSize(const uint32_t bufferSize) noexcept
@@ -258,6 +288,7 @@ bool RackGraph::connect(CarlaEngine* const engine, const uint groupA, const uint
         CARLA_SAFE_ASSERT_RETURN(otherGroup == RACK_GRAPH_GROUP_AUDIO_IN, false);
         audio.mutex.lock();
         makeConnection = audio.connectedIn1.append(otherPort);
+        publishRoutes();
         audio.mutex.unlock();
         break;
 
@@ -265,6 +296,7 @@ bool RackGraph::connect(CarlaEngine* const engine, const uint groupA, const uint
         CARLA_SAFE_ASSERT_RETURN(otherGroup == RACK_GRAPH_GROUP_AUDIO_IN, false);
         audio.mutex.lock();
         makeConnection = audio.connectedIn2.append(otherPort);
+        publishRoutes();
         audio.mutex.unlock();
         break;
 
@@ -272,6 +304,7 @@ bool RackGraph::connect(CarlaEngine* const engine, const uint groupA, const uint
         CARLA_SAFE_ASSERT_RETURN(otherGroup == RACK_GRAPH_GROUP_AUDIO_OUT, false);
         audio.mutex.lock();
         makeConnection = audio.connectedOut1.append(otherPort);
+        publishRoutes();
         audio.mutex.unlock();
         break;
 
@@ -279,6 +312,7 @@ bool RackGraph::connect(CarlaEngine* const engine, const uint groupA, const uint
         CARLA_SAFE_ASSERT_RETURN(otherGroup == RACK_GRAPH_GROUP_AUDIO_OUT, false);
         audio.mutex.lock();
         makeConnection = audio.connectedOut2.append(otherPort);
+        publishRoutes();
         audio.mutex.unlock();
         break;
 
@@ -358,24 +392,28 @@ bool RackGraph::disconnect(CarlaEngine* const engine, const uint connectionId) n
         case RACK_GRAPH_CARLA_PORT_AUDIO_IN1:
             audio.mutex.lock();
             makeDisconnection = audio.connectedIn1.removeOne(otherPort);
+            publishRoutes();
             audio.mutex.unlock();
             break;
 
         case RACK_GRAPH_CARLA_PORT_AUDIO_IN2:
             audio.mutex.lock();
             makeDisconnection = audio.connectedIn2.removeOne(otherPort);
+            publishRoutes();
             audio.mutex.unlock();
             break;
 
         case RACK_GRAPH_CARLA_PORT_AUDIO_OUT1:
             audio.mutex.lock();
             makeDisconnection = audio.connectedOut1.removeOne(otherPort);
+            publishRoutes();
             audio.mutex.unlock();
             break;
 
         case RACK_GRAPH_CARLA_PORT_AUDIO_OUT2:
             audio.mutex.lock();
             makeDisconnection = audio.connectedOut2.removeOne(otherPort);
+            publishRoutes();
             audio.mutex.unlock();
             break;
 
@@ -415,12 +453,121 @@ void RackGraph::clearConnections() noexcept
     audio.connectedIn2.clear();
     audio.connectedOut1.clear();
     audio.connectedOut2.clear();
+    publishRoutes();
     audio.mutex.unlock();
 
     midi.ins.clear();
     midi.outs.clear();
 }
 
+void RackGraph::publishRoutes() noexcept
+{
+    RackGraphRoutes* table;
+
+    try {
+        table = new RackGraphRoutes(audio.connectedIn1.count() + audio.connectedIn2.count() +
+                                    audio.connectedOut1.count() + audio.connectedOut2.count());
+    } CARLA_SAFE_EXCEPTION_RETURN("new RackGraphRoutes",);
+
+    uint count = 0;
+
+    for (LinkedList<uint>::Itenerator it = audio.connectedIn1.begin(); it.valid(); it.next())
+    {
+        const uint& port(it.getValue(0));
+        CARLA_SAFE_ASSERT_CONTINUE(port != 0);
+        CARLA_SAFE_ASSERT_CONTINUE(port < inputs);
+
+        table->routes[count].src = port;
+        table->routes[count].dst = 0;
+        ++count;
+    }
+
+    for (LinkedList<uint>::Itenerator it = audio.connectedIn2.begin(); it.valid(); it.next())
+    {
+        const uint& port(it.getValue(0));
+        CARLA_SAFE_ASSERT_CONTINUE(port != 0);
+        CARLA_SAFE_ASSERT_CONTINUE(port < inputs);
+
+        table->routes[count].src = port;
+        table->routes[count].dst = 1;
+        ++count;
+    }
+
+    table->inCount = count;
+
+    for (LinkedList<uint>::Itenerator it = audio.connectedOut1.begin(); it.valid(); it.next())
+    {
+        const uint& port(it.getValue(0));
+        CARLA_SAFE_ASSERT_CONTINUE(port > 0);
+        CARLA_SAFE_ASSERT_CONTINUE(port <= outputs);
+
+        table->routes[count].src = 0;
+        table->routes[count].dst = port-1;
+        ++count;
+    }
+
+    for (LinkedList<uint>::Itenerator it = audio.connectedOut2.begin(); it.valid(); it.next())
+    {
+        const uint& port(it.getValue(0));
+        CARLA_SAFE_ASSERT_CONTINUE(port > 0);
+        CARLA_SAFE_ASSERT_CONTINUE(port <= outputs);
+
+        table->routes[count].src = 1;
+        table->routes[count].dst = port-1;
+        ++count;
+    }
+
+    table->outCount = count - table->inCount;
+
+    RackGraphRoutes* const newest(audio.routes.get());
+
+    table->serial = (newest != nullptr) ? newest->serial + 1 : 1;
+    table->older  = newest;
+
+    audio.routes = table;
+
+    reclaimRoutes(false);
+}
+
+void RackGraph::reclaimRoutes(const bool all) noexcept
+{
+    RackGraphRoutes* const newest(audio.routes.get());
+
+    if (newest == nullptr)
+        return;
+
+    RackGraphRoutes* old;
+
+    if (all)
+    {
+        audio.routes = nullptr;
+        old = newest;
+    }
+    else
+    {
+        const uint rtSerial(static_cast<uint>(audio.rtSerial.get()));
+        old = nullptr;
+
+        for (RackGraphRoutes* table = newest; table != nullptr; table = table->older)
+        {
+            if (table->serial > rtSerial)
+                continue;
+
+            // everything older than the table in use by the audio thread can go
+            old = table->older;
+            table->older = nullptr;
+            break;
+        }
+    }
+
+    for (; old != nullptr;)
+    {
+        RackGraphRoutes* const older(old->older);
+        delete old;
+        old = older;
+    }
+}
+
 const char* const* RackGraph::getConnections() const noexcept
 {
     if (connections.list.count() == 0)
@@ -556,18 +703,44 @@ bool RackGraph::getGroupAndPortIdFromFullName(const char* const fullPortName, ui
     return false;
 }
 
+// use the plugin's own port buffers where available (see CarlaEngineAudioPort::setSharedBuffer), saving a copy in the plugin
+static void getRackPluginBuffers(const CarlaPlugin* const plugin, float* inBuf[2], float* outBuf[2]) noexcept
+{
+    for (uint32_t i=0, count=plugin->getAudioInCount(); i < count && i < 2; ++i)
+    {
+        if (CarlaEngineAudioPort* const port = plugin->getAudioInPort(i))
+        {
+            if (float* const buffer = port->getBuffer())
+                inBuf[i] = buffer;
+        }
+    }
+
+    for (uint32_t i=0, count=plugin->getAudioOutCount(); i < count && i < 2; ++i)
+    {
+        if (CarlaEngineAudioPort* const port = plugin->getAudioOutPort(i))
+        {
+            if (float* const buffer = port->getBuffer())
+                outBuf[i] = buffer;
+        }
+    }
+}
+
 void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inBufReal[2], float* outBuf[2], const uint32_t frames)
 {
     CARLA_SAFE_ASSERT_RETURN(data != nullptr,);
-    CARLA_SAFE_ASSERT_RETURN(data->events.in != nullptr,);
-    CARLA_SAFE_ASSERT_RETURN(data->events.out != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(data->events.in.isAllocated(),);
+    CARLA_SAFE_ASSERT_RETURN(data->events.out.isAllocated(),);
+    CARLA_SAFE_ASSERT_RETURN(data->rtPluginList != nullptr,);
 
+    const EnginePluginList* const pluginList(data->rtPluginList);
     const int iframes(static_cast<int>(frames));
 
+    // shared port buffers are sized for the full engine buffer
+    const bool canUseSharedBuffers(frames == data->bufferSize);
+
     // safe copy
     float inBuf0[frames];
     float inBuf1[frames];
-    const float* inBuf[2] = { inBuf0, inBuf1 };
 
     // initialize audio inputs
     FloatVectorOperations::copy(inBuf0, inBufReal[0], iframes);
@@ -577,103 +750,153 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
     FloatVectorOperations::clear(outBuf[0], iframes);
     FloatVectorOperations::clear(outBuf[1], iframes);
 
-    // initialize event outputs (zero)
-    carla_zeroStruct<EngineEvent>(data->events.out, kMaxEngineEventInternalCount);
+    // initialize event outputs (empty)
+    data->events.out.clear();
 
     bool processed = false;
 
     uint32_t oldAudioInCount = 0;
     uint32_t oldMidiOutCount = 0;
 
+    // where the previous plugin wrote its audio
+    float* prevOutBuf[2] = { outBuf[0], outBuf[1] };
+
     // process plugins
-    for (uint i=0; i < data->curPluginCount; ++i)
+    for (uint i=0; i < pluginList->count; ++i)
     {
-        CarlaPlugin* const plugin = data->plugins[i].plugin;
+        CarlaPlugin* const plugin = pluginList->plugins[i].plugin;
 
         if (plugin == nullptr || ! plugin->isEnabled() || ! plugin->tryLock(isOffline))
             continue;
 
+        float* plugInBuf[2]  = { inBuf0, inBuf1 };
+        float* plugOutBuf[2] = { outBuf[0], outBuf[1] };
+
+        if (canUseSharedBuffers)
+            getRackPluginBuffers(plugin, plugInBuf, plugOutBuf);
+
         if (processed)
         {
             // initialize audio inputs (from previous outputs)
-            FloatVectorOperations::copy(inBuf0, outBuf[0], iframes);
-            FloatVectorOperations::copy(inBuf1, outBuf[1], iframes);
+            FloatVectorOperations::copy(plugInBuf[0], prevOutBuf[0], iframes);
+            FloatVectorOperations::copy(plugInBuf[1], prevOutBuf[1], iframes);
 
             // initialize audio outputs (zero)
-            FloatVectorOperations::clear(outBuf[0], iframes);
-            FloatVectorOperations::clear(outBuf[1], iframes);
+            FloatVectorOperations::clear(plugOutBuf[0], iframes);
+            FloatVectorOperations::clear(plugOutBuf[1], iframes);
 
             // if plugin has no midi out, add previous events
-            if (oldMidiOutCount == 0 && data->events.in[0].type != kEngineEventTypeNull)
+            if (oldMidiOutCount == 0 && data->events.in.count != 0)
             {
-                if (data->events.out[0].type != kEngineEventTypeNull)
+                if (data->events.out.count != 0)
                 {
-                    // TODO: carefully add to input, sorted events
+                    // merge anything it did output into previous events, sorted by time
+                    data->events.in.mergeFrom(data->events.out);
+
+                    // initialize event outputs (empty)
+                    data->events.out.clear();
                 }
                 // else nothing needed
             }
             else
             {
                 // initialize event inputs from previous outputs
-                carla_copyStruct<EngineEvent>(data->events.in, data->events.out, kMaxEngineEventInternalCount);
+                data->events.in.copyFrom(data->events.out);
 
-                // initialize event outputs (zero)
-                carla_zeroStruct<EngineEvent>(data->events.out, kMaxEngineEventInternalCount);
+                // initialize event outputs (empty)
+                data->events.out.clear();
             }
         }
+        else
+        {
+            // first plugin, initialize shared buffers from the real inputs
+            if (plugInBuf[0] != inBuf0)
+                FloatVectorOperations::copy(plugInBuf[0], inBuf0, iframes);
+            if (plugInBuf[1] != inBuf1)
+                FloatVectorOperations::copy(plugInBuf[1], inBuf1, iframes);
+            if (plugOutBuf[0] != outBuf[0])
+                FloatVectorOperations::clear(plugOutBuf[0], iframes);
+            if (plugOutBuf[1] != outBuf[1])
+                FloatVectorOperations::clear(plugOutBuf[1], iframes);
+        }
 
         oldAudioInCount = plugin->getAudioInCount();
         oldMidiOutCount = plugin->getMidiOutCount();
 
-        // process
+        EnginePluginData& pluginData(pluginList->plugins[i]);
+
+        juce::Range<float> range;
+
+        // set input peaks, before processing so they can be used for silence detection
+        if (oldAudioInCount > 0)
+        {
+            range = FloatVectorOperations::findMinAndMax(plugInBuf[0], iframes);
+            pluginData.insPeak[0] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
+
+            range = FloatVectorOperations::findMinAndMax(plugInBuf[1], iframes);
+            pluginData.insPeak[1] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
+        }
+        else
+        {
+            pluginData.insPeak[0] = 0.0f;
+            pluginData.insPeak[1] = 0.0f;
+        }
+
+        const float inPeak(carla_maxLimited<float>(pluginData.insPeak[0], pluginData.insPeak[1], 1.0f));
+
+        double processSecs = 0.0;
+
+        // the event input buffer is set here, it is needed for the silence check
         plugin->initBuffers();
-        plugin->process(inBuf, outBuf, nullptr, nullptr, frames);
-        plugin->unlock();
+
+        // process, unless asleep on silence (outputs are already clear)
+        if (! plugin->isSleepingOnSilence(inPeak))
+        {
+            const float* constInBuf[2] = { plugInBuf[0], plugInBuf[1] };
+
+            const juce::int64 startTicks(Time::getHighResolutionTicks());
+            plugin->process(constInBuf, plugOutBuf, nullptr, nullptr, frames);
+            processSecs = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()-startTicks);
+        }
 
         // if plugin has no audio inputs, add input buffer
         if (oldAudioInCount == 0)
         {
-            FloatVectorOperations::add(outBuf[0], inBuf0, iframes);
-            FloatVectorOperations::add(outBuf[1], inBuf1, iframes);
+            FloatVectorOperations::add(plugOutBuf[0], plugInBuf[0], iframes);
+            FloatVectorOperations::add(plugOutBuf[1], plugInBuf[1], iframes);
         }
 
-        // set peaks
+        // set output peaks
+        if (plugin->getAudioOutCount() > 0)
         {
-            EnginePluginData& pluginData(data->plugins[i]);
+            range = FloatVectorOperations::findMinAndMax(plugOutBuf[0], iframes);
+            pluginData.outsPeak[0] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
 
-            juce::Range<float> range;
-
-            if (oldAudioInCount > 0)
-            {
-                range = FloatVectorOperations::findMinAndMax(inBuf0, iframes);
-                pluginData.insPeak[0] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
-
-                range = FloatVectorOperations::findMinAndMax(inBuf1, iframes);
-                pluginData.insPeak[1] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
-            }
-            else
-            {
-                pluginData.insPeak[0] = 0.0f;
-                pluginData.insPeak[1] = 0.0f;
-            }
+            range = FloatVectorOperations::findMinAndMax(plugOutBuf[1], iframes);
+            pluginData.outsPeak[1] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
+        }
+        else
+        {
+            pluginData.outsPeak[0] = 0.0f;
+            pluginData.outsPeak[1] = 0.0f;
+        }
 
-            if (plugin->getAudioOutCount() > 0)
-            {
-                range = FloatVectorOperations::findMinAndMax(outBuf[0], iframes);
-                pluginData.outsPeak[0] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
+        plugin->updateSilenceState(inPeak, carla_maxLimited<float>(pluginData.outsPeak[0], pluginData.outsPeak[1], 1.0f), frames);
+        plugin->unlock();
 
-                range = FloatVectorOperations::findMinAndMax(outBuf[1], iframes);
-                pluginData.outsPeak[1] = carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f);
-            }
-            else
-            {
-                pluginData.outsPeak[0] = 0.0f;
-                pluginData.outsPeak[1] = 0.0f;
-            }
-        }
+        if (! isOffline)
+            pluginData.dspLoad.add(processSecs, frames, data->sampleRate);
 
+        prevOutBuf[0] = plugOutBuf[0];
+        prevOutBuf[1] = plugOutBuf[1];
         processed = true;
     }
+
+    // last plugin wrote into its own buffers
+    if (prevOutBuf[0] != outBuf[0])
+        FloatVectorOperations::copy(outBuf[0], prevOutBuf[0], iframes);
+    if (prevOutBuf[1] != outBuf[1])
+        FloatVectorOperations::copy(outBuf[1], prevOutBuf[1], iframes);
 }
 
 void RackGraph::processHelper(CarlaEngine::ProtectedData* const data, const float* const* const inBuf, float* const* const outBuf, const uint32_t frames)
@@ -682,53 +905,38 @@ void RackGraph::processHelper(CarlaEngine::ProtectedData* const data, const floa
 
     const int iframes(static_cast<int>(frames));
 
-    const CarlaRecursiveMutexLocker _cml(audio.mutex);
+    // lock-free, connection changes publish a new table
+    const RackGraphRoutes* const table(audio.routes.get());
+
+    if (table != nullptr)
+        audio.rtSerial = static_cast<int>(table->serial);
+
+    const uint inCount(table != nullptr ? table->inCount : 0);
+    const uint outCount(table != nullptr ? table->outCount : 0);
 
     if (inBuf != nullptr && inputs > 0)
     {
-        bool noConnections = true;
+        bool connected[2] = { false, false };
 
-        // connect input buffers
-        for (LinkedList<uint>::Itenerator it = audio.connectedIn1.begin(); it.valid(); it.next())
+        // connect input buffers, the first connection of a channel copies and the others mix
+        for (uint i=0; i < inCount; ++i)
         {
-            const uint& port(it.getValue(0));
-            CARLA_SAFE_ASSERT_CONTINUE(port != 0);
-            CARLA_SAFE_ASSERT_CONTINUE(port < inputs);
+            const RackGraphRoutes::Route& route(table->routes[i]);
 
-            if (noConnections)
+            if (connected[route.dst])
             {
-                FloatVectorOperations::copy(audio.inBuf[0], inBuf[port], iframes);
-                noConnections = false;
+                FloatVectorOperations::add(audio.inBuf[route.dst], inBuf[route.src], iframes);
             }
             else
             {
-                FloatVectorOperations::add(audio.inBuf[0], inBuf[port], iframes);
+                FloatVectorOperations::copy(audio.inBuf[route.dst], inBuf[route.src], iframes);
+                connected[route.dst] = true;
             }
         }
 
-        if (noConnections)
+        if (! connected[0])
             FloatVectorOperations::clear(audio.inBuf[0], iframes);
-
-        noConnections = true;
-
-        for (LinkedList<uint>::Itenerator it = audio.connectedIn2.begin(); it.valid(); it.next())
-        {
-            const uint& port(it.getValue(0));
-            CARLA_SAFE_ASSERT_CONTINUE(port != 0);
-            CARLA_SAFE_ASSERT_CONTINUE(port < inputs);
-
-            if (noConnections)
-            {
-                FloatVectorOperations::copy(audio.inBuf[1], inBuf[port], iframes);
-                noConnections = false;
-            }
-            else
-            {
-                FloatVectorOperations::add(audio.inBuf[1], inBuf[port], iframes);
-            }
-        }
-
-        if (noConnections)
+        if (! connected[1])
             FloatVectorOperations::clear(audio.inBuf[1], iframes);
     }
     else
@@ -744,28 +952,11 @@ void RackGraph::processHelper(CarlaEngine::ProtectedData* const data, const floa
     process(data, const_cast<const float**>(audio.inBuf), audio.outBuf, frames);
 
     // connect output buffers
-    if (audio.connectedOut1.count() != 0)
+    for (uint i=inCount, end=inCount+outCount; i < end; ++i)
     {
-        for (LinkedList<uint>::Itenerator it = audio.connectedOut1.begin(); it.valid(); it.next())
-        {
-            const uint& port(it.getValue(0));
-            CARLA_SAFE_ASSERT_CONTINUE(port > 0);
-            CARLA_SAFE_ASSERT_CONTINUE(port <= outputs);
+        const RackGraphRoutes::Route& route(table->routes[i]);
 
-            FloatVectorOperations::add(outBuf[port-1], audio.outBuf[0], iframes);
-        }
-    }
-
-    if (audio.connectedOut2.count() != 0)
-    {
-        for (LinkedList<uint>::Itenerator it = audio.connectedOut2.begin(); it.valid(); it.next())
-        {
-            const uint& port(it.getValue(0));
-            CARLA_SAFE_ASSERT_CONTINUE(port > 0);
-            CARLA_SAFE_ASSERT_CONTINUE(port <= outputs);
-
-            FloatVectorOperations::add(outBuf[port-1], audio.outBuf[1], iframes);
-        }
+        FloatVectorOperations::add(outBuf[route.dst], audio.outBuf[route.src], iframes);
     }
 }
 
@@ -913,6 +1104,28 @@ void removeNodeFromPatchbay(CarlaEngine* const engine, const uint32_t groupId, c
 
 // -----------------------------------------------------------------------
 
+// absolute peak of all channels, per-channel peaks of the first 2 channels are stored in 'peaks'
+static inline
+float getAudioPeaks(float* const* const buffers, const int numChan, const int numSamples, float peaks[2]) noexcept
+{
+    float maxPeak = 0.0f;
+
+    for (int i=0; i<numChan; ++i)
+    {
+        const juce::Range<float> range(FloatVectorOperations::findMinAndMax(buffers[i], numSamples));
+        const float peak(carla_maxLimited<float>(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0f));
+
+        if (i < 2)
+            peaks[i] = peak;
+        if (peak > maxPeak)
+            maxPeak = peak;
+    }
+
+    return maxPeak;
+}
+
+// -----------------------------------------------------------------------
+
 class CarlaPluginInstance : public AudioPluginInstance
 {
 public:
@@ -994,11 +1207,11 @@ public:
 
         if (CarlaEngineEventPort* const port = fPlugin->getDefaultEventInPort())
         {
-            EngineEvent* const engineEvents(port->fBuffer);
+            EngineEventBuffer* const engineEvents(port->fBuffer);
             CARLA_SAFE_ASSERT_RETURN(engineEvents != nullptr,);
 
-            carla_zeroStruct<EngineEvent>(engineEvents, kMaxEngineEventInternalCount);
-            fillEngineEventsFromJuceMidiBuffer(engineEvents, midi);
+            engineEvents->clear();
+            fillEngineEventsFromJuceMidiBuffer(*engineEvents, midi);
         }
 
         midi.clear();
@@ -1020,46 +1233,49 @@ public:
             float inPeaks[2] = { 0.0f };
             float outPeaks[2] = { 0.0f };
 
-            for (int i=0; i<numChan; ++i)
-            {
-                for (uint32_t j=0; j < bufferSize; ++j)
-                {
-                    const float absV(std::abs(audioBuffers[i][j]));
+            const float inPeak(getAudioPeaks(audioBuffers, numChan, audio.getNumSamples(), inPeaks));
+            /**/  float outPeak = 0.0f;
 
-                    if (absV > inPeaks[i])
-                        inPeaks[i] = absV;
-                }
+            if (fPlugin->isSleepingOnSilence(inPeak))
+            {
+                audio.clear();
+                engine->setPluginProcessTime(fPlugin->getId(), 0.0, bufferSize);
             }
-
-            fPlugin->process(const_cast<const float**>(audioBuffers), audioBuffers, nullptr, nullptr, bufferSize);
-
-            for (int i=0; i<numChan; ++i)
+            else
             {
-                for (uint32_t j=0; j < bufferSize; ++j)
-                {
-                    const float absV(std::abs(audioBuffers[i][j]));
+                const juce::int64 startTicks(Time::getHighResolutionTicks());
+                fPlugin->process(const_cast<const float**>(audioBuffers), audioBuffers, nullptr, nullptr, bufferSize);
+                engine->setPluginProcessTime(fPlugin->getId(), Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()-startTicks), bufferSize);
 
-                    if (absV > outPeaks[i])
-                        outPeaks[i] = absV;
-                }
+                outPeak = getAudioPeaks(audioBuffers, numChan, audio.getNumSamples(), outPeaks);
             }
 
+            fPlugin->updateSilenceState(inPeak, outPeak, bufferSize);
+
             engine->setPluginPeaks(fPlugin->getId(), inPeaks, outPeaks);
         }
+        else if (fPlugin->isSleepingOnSilence(0.0f))
+        {
+            engine->setPluginProcessTime(fPlugin->getId(), 0.0, bufferSize);
+        }
         else
         {
+            const juce::int64 startTicks(Time::getHighResolutionTicks());
             fPlugin->process(nullptr, nullptr, nullptr, nullptr, bufferSize);
+            engine->setPluginProcessTime(fPlugin->getId(), Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()-startTicks), bufferSize);
+
+            fPlugin->updateSilenceState(0.0f, 0.0f, bufferSize);
         }
 
         midi.clear();
 
         if (CarlaEngineEventPort* const port = fPlugin->getDefaultEventOutPort())
         {
-            /*const*/ EngineEvent* const engineEvents(port->fBuffer);
+            EngineEventBuffer* const engineEvents(port->fBuffer);
             CARLA_SAFE_ASSERT_RETURN(engineEvents != nullptr,);
 
-            fillJuceMidiBufferFromEngineEvents(midi, engineEvents);
-            carla_zeroStruct<EngineEvent>(engineEvents, kMaxEngineEventInternalCount);
+            fillJuceMidiBufferFromEngineEvents(midi, *engineEvents);
+            engineEvents->clear();
         }
 
         fPlugin->unlock();
@@ -1120,10 +1336,332 @@ private:
     CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CarlaPluginInstance)
 };
 
+// -----------------------------------------------------------------------
+// Patchbay Process Schedule
+
+enum PatchbayScheduleNodeType {
+    kPatchbayScheduleNodePlugin,
+    kPatchbayScheduleNodeAudioIn,
+    kPatchbayScheduleNodeAudioOut,
+    kPatchbayScheduleNodeMidiIn,
+    kPatchbayScheduleNodeMidiOut
+};
+
+struct PatchbayScheduleAudioLink {
+    uint source;
+    uint sourceChannel;
+    uint targetChannel;
+};
+
+struct PatchbayScheduleNode {
+    uint nodeId;
+    PatchbayScheduleNodeType type;
+    AudioProcessor* proc;
+    AudioSampleBuffer audio;
+    MidiBuffer midi;
+    Array<PatchbayScheduleAudioLink> audioLinks;
+    Array<uint> midiLinks;
+
+    PatchbayScheduleNode(const uint id, const PatchbayScheduleNodeType t, AudioProcessor* const p)
+        : nodeId(id),
+          type(t),
+          proc(p),
+          audio(),
+          midi(),
+          audioLinks(),
+          midiLinks() {}
+
+    CARLA_DECLARE_NON_COPY_STRUCT(PatchbayScheduleNode)
+};
+
+/*
+ * Immutable processing order of the patchbay graph, built from the current connections.
+ * Each plugin node sums its inputs into its own buffers, so independent nodes can run in parallel.
+ */
+class PatchbayProcessSchedule : public EngineProcessGraph::Callback
+{
+public:
+    PatchbayProcessSchedule(PatchbayGraph& graph, const uint maxNodes)
+        : fNodes(),
+          fNodeIds(),
+          fGraph(),
+          kInputs(graph.inputs),
+          kOutputs(graph.outputs),
+          fInputs(),
+          fOutBuf(nullptr),
+          fFrames(0),
+          leakDetector_PatchbayProcessSchedule()
+    {
+        const int bufferSize(graph.graph.getBlockSize());
+
+        fInputs.setSize(static_cast<int>(jmax(1U, kInputs)), bufferSize);
+
+        for (int i=0, count=graph.graph.getNumNodes(); i<count; ++i)
+        {
+            AudioProcessorGraph::Node* const node(graph.graph.getNode(i));
+            CARLA_SAFE_ASSERT_CONTINUE(node != nullptr);
+
+            AudioProcessor* const proc(node->getProcessor());
+            CARLA_SAFE_ASSERT_CONTINUE(proc != nullptr);
+
+            PatchbayScheduleNodeType type = kPatchbayScheduleNodePlugin;
+
+            if (AudioProcessorGraph::AudioGraphIOProcessor* const ioProc = dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*>(proc))
+            {
+                switch (ioProc->getType())
+                {
+                case AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode:
+                    type = kPatchbayScheduleNodeAudioIn;
+                    break;
+                case AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode:
+                    type = kPatchbayScheduleNodeAudioOut;
+                    break;
+                case AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode:
+                    type = kPatchbayScheduleNodeMidiIn;
+                    break;
+                case AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode:
+                    type = kPatchbayScheduleNodeMidiOut;
+                    break;
+                }
+            }
+
+            PatchbayScheduleNode* const sNode(new PatchbayScheduleNode(node->nodeId, type, proc));
+
+            if (type == kPatchbayScheduleNodePlugin)
+                sNode->audio.setSize(jmax(1, proc->getNumInputChannels(), proc->getNumOutputChannels()), bufferSize);
+
+            if (type != kPatchbayScheduleNodeAudioIn && type != kPatchbayScheduleNodeAudioOut)
+            {
+                sNode->midi.ensureSize(kMaxEngineEventInternalCount*2);
+                sNode->midi.clear();
+            }
+
+            fNodes.add(sNode);
+            fNodeIds.add(node->nodeId);
+        }
+
+        CARLA_SAFE_ASSERT_RETURN(static_cast<uint>(fNodes.size()) <= maxNodes,);
+
+        Array<uint> edgeSources, edgeTargets;
+
+        for (LinkedList<ConnectionToId>::Itenerator it=graph.connections.list.begin(); it.valid(); it.next())
+        {
+            static const ConnectionToId fallback = { 0, 0, 0, 0, 0 };
+
+            const ConnectionToId& connectionToId(it.getValue(fallback));
+            CARLA_SAFE_ASSERT_CONTINUE(connectionToId.id != 0);
+
+            const int source(getNodeIndex(connectionToId.groupA));
+            const int target(getNodeIndex(connectionToId.groupB));
+            CARLA_SAFE_ASSERT_CONTINUE(source >= 0 && target >= 0);
+
+            PatchbayScheduleNode& sourceNode(*fNodes.getUnchecked(source));
+            PatchbayScheduleNode& targetNode(*fNodes.getUnchecked(target));
+
+            if (connectionToId.portA == kMidiOutputPortOffset && connectionToId.portB == kMidiInputPortOffset)
+            {
+                CARLA_SAFE_ASSERT_CONTINUE(sourceNode.type == kPatchbayScheduleNodePlugin || sourceNode.type == kPatchbayScheduleNodeMidiIn);
+                CARLA_SAFE_ASSERT_CONTINUE(targetNode.type == kPatchbayScheduleNodePlugin || targetNode.type == kPatchbayScheduleNodeMidiOut);
+
+                targetNode.midiLinks.add(static_cast<uint>(source));
+            }
+            else if (connectionToId.portA >= kAudioOutputPortOffset && connectionToId.portA < kMidiInputPortOffset &&
+                     connectionToId.portB >= kAudioInputPortOffset  && connectionToId.portB < kAudioOutputPortOffset)
+            {
+                const PatchbayScheduleAudioLink link = {
+                    static_cast<uint>(source),
+                    connectionToId.portA - kAudioOutputPortOffset,
+                    connectionToId.portB - kAudioInputPortOffset
+                };
+
+                if (sourceNode.type == kPatchbayScheduleNodeAudioIn)
+                {
+                    CARLA_SAFE_ASSERT_CONTINUE(link.sourceChannel < kInputs);
+                }
+                else
+                {
+                    CARLA_SAFE_ASSERT_CONTINUE(sourceNode.type == kPatchbayScheduleNodePlugin);
+                    CARLA_SAFE_ASSERT_CONTINUE(link.sourceChannel < static_cast<uint>(sourceNode.audio.getNumChannels()));
+                }
+
+                if (targetNode.type == kPatchbayScheduleNodeAudioOut)
+                {
+                    CARLA_SAFE_ASSERT_CONTINUE(link.targetChannel < kOutputs);
+                }
+                else
+                {
+                    CARLA_SAFE_ASSERT_CONTINUE(targetNode.type == kPatchbayScheduleNodePlugin);
+                    CARLA_SAFE_ASSERT_CONTINUE(link.targetChannel < static_cast<uint>(targetNode.audio.getNumChannels()));
+                }
+
+                targetNode.audioLinks.add(link);
+            }
+            else
+            {
+                carla_stderr2("PatchbayProcessSchedule - invalid connection %u:%u -> %u:%u",
+                              connectionToId.groupA, connectionToId.portA, connectionToId.groupB, connectionToId.portB);
+                continue;
+            }
+
+            edgeSources.add(static_cast<uint>(source));
+            edgeTargets.add(static_cast<uint>(target));
+        }
+
+        fGraph = new EngineProcessGraph(static_cast<uint>(fNodes.size()),
+                                        edgeSources.getRawDataPointer(), edgeTargets.getRawDataPointer(),
+                                        static_cast<uint>(edgeSources.size()));
+    }
+
+    // false when the graph contains feedback loops, which only the juce graph can handle
+    bool isValid() const noexcept
+    {
+        return fGraph != nullptr && fGraph->isValid();
+    }
+
+    // called from the audio thread after process()
+    void publishTimings(EngineProcessTimings& timings) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(isValid(),);
+
+        timings.publish(*fGraph, fNodeIds.getRawDataPointer());
+    }
+
+    void process(EngineProcessPool& pool, const EngineEventBuffer& eventsIn, EngineEventBuffer& eventsOut, const float* const* const inBuf, float* const* const outBuf, const int frames)
+    {
+        CARLA_SAFE_ASSERT_RETURN(frames <= fInputs.getNumSamples(),);
+
+        fOutBuf = outBuf;
+        fFrames = frames;
+
+        // host buffers can be shared between inputs and outputs, copy inputs before clearing
+        for (uint i=0; i < kInputs; ++i)
+            FloatVectorOperations::copy(fInputs.getWritePointer(static_cast<int>(i)), inBuf[i], frames);
+
+        for (uint i=0; i < kOutputs; ++i)
+            FloatVectorOperations::clear(outBuf[i], frames);
+
+        PatchbayScheduleNode* midiOutNode = nullptr;
+
+        for (int i=0, count=fNodes.size(); i<count; ++i)
+        {
+            PatchbayScheduleNode* const sNode(fNodes.getUnchecked(i));
+
+            if (sNode->type == kPatchbayScheduleNodeMidiIn)
+            {
+                sNode->midi.clear();
+                fillJuceMidiBufferFromEngineEvents(sNode->midi, eventsIn);
+            }
+            else if (sNode->type == kPatchbayScheduleNodeMidiOut)
+            {
+                midiOutNode = sNode;
+            }
+        }
+
+        pool.process(*fGraph, this);
+
+        eventsOut.clear();
+
+        if (midiOutNode != nullptr)
+        {
+            fillEngineEventsFromJuceMidiBuffer(eventsOut, midiOutNode->midi);
+            midiOutNode->midi.clear();
+        }
+    }
+
+    // called from the pool threads, once all inputs of this node are ready
+    void processGraphNode(const uint index) override
+    {
+        PatchbayScheduleNode& sNode(*fNodes.getUnchecked(static_cast<int>(index)));
+
+        switch (sNode.type)
+        {
+        case kPatchbayScheduleNodeAudioIn:
+        case kPatchbayScheduleNodeMidiIn:
+            break;
+
+        case kPatchbayScheduleNodeAudioOut:
+            for (int i=0, count=sNode.audioLinks.size(); i<count; ++i)
+            {
+                const PatchbayScheduleAudioLink& link(sNode.audioLinks.getReference(i));
+                FloatVectorOperations::add(fOutBuf[link.targetChannel], getSourceBuffer(link), fFrames);
+            }
+            break;
+
+        case kPatchbayScheduleNodeMidiOut:
+            sNode.midi.clear();
+            mergeMidiLinks(sNode);
+            break;
+
+        case kPatchbayScheduleNodePlugin: {
+            const int numChannels(sNode.audio.getNumChannels());
+
+            for (int i=0; i<numChannels; ++i)
+                FloatVectorOperations::clear(sNode.audio.getWritePointer(i), fFrames);
+
+            for (int i=0, count=sNode.audioLinks.size(); i<count; ++i)
+            {
+                const PatchbayScheduleAudioLink& link(sNode.audioLinks.getReference(i));
+                FloatVectorOperations::add(sNode.audio.getWritePointer(static_cast<int>(link.targetChannel)), getSourceBuffer(link), fFrames);
+            }
+
+            sNode.midi.clear();
+            mergeMidiLinks(sNode);
+
+            AudioSampleBuffer audio(sNode.audio.getArrayOfWritePointers(), numChannels, fFrames);
+            sNode.proc->processBlock(audio, sNode.midi);
+        }   break;
+        }
+    }
+
+private:
+    OwnedArray<PatchbayScheduleNode> fNodes;
+    Array<uint> fNodeIds;
+    ScopedPointer<EngineProcessGraph> fGraph;
+
+    const uint32_t kInputs;
+    const uint32_t kOutputs;
+
+    // copy of the graph inputs, valid during process()
+    AudioSampleBuffer fInputs;
+
+    // valid during process()
+    float* const* fOutBuf;
+    int fFrames;
+
+    int getNodeIndex(const uint nodeId) const noexcept
+    {
+        for (int i=0, count=fNodes.size(); i<count; ++i)
+        {
+            if (fNodes.getUnchecked(i)->nodeId == nodeId)
+                return i;
+        }
+
+        return -1;
+    }
+
+    const float* getSourceBuffer(const PatchbayScheduleAudioLink& link) const noexcept
+    {
+        const PatchbayScheduleNode& source(*fNodes.getUnchecked(static_cast<int>(link.source)));
+
+        if (source.type == kPatchbayScheduleNodeAudioIn)
+            return fInputs.getReadPointer(static_cast<int>(link.sourceChannel));
+
+        return source.audio.getReadPointer(static_cast<int>(link.sourceChannel));
+    }
+
+    void mergeMidiLinks(PatchbayScheduleNode& sNode) const
+    {
+        for (int i=0, count=sNode.midiLinks.size(); i<count; ++i)
+            sNode.midi.addEvents(fNodes.getUnchecked(static_cast<int>(sNode.midiLinks.getUnchecked(i)))->midi, 0, fFrames, 0);
+    }
+
+    CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PatchbayProcessSchedule)
+};
+
 // -----------------------------------------------------------------------
 // Patchbay Graph
 
-PatchbayGraph::PatchbayGraph(const int bufferSize, const double sampleRate, const uint32_t ins, const uint32_t outs)
+PatchbayGraph::PatchbayGraph(const int bufferSize, const double sampleRate, const uint32_t ins, const uint32_t outs, const uint processThreads)
     : connections(),
       graph(),
       audioBuffer(),
@@ -1131,7 +1669,11 @@ PatchbayGraph::PatchbayGraph(const int bufferSize, const double sampleRate, cons
       inputs(carla_fixValue(0U, MAX_PATCHBAY_PLUGINS-2, ins)),
       outputs(carla_fixValue(0U, MAX_PATCHBAY_PLUGINS-2, outs)),
       ignorePathbay(false),
-      retCon()
+      retCon(),
+      processPool(nullptr),
+      processTimings(nullptr),
+      schedule(nullptr),
+      scheduleMutex()
 {
     graph.setPlayConfigDetails(static_cast<int>(inputs), static_cast<int>(outputs), sampleRate, bufferSize);
     graph.prepareToPlay(sampleRate, bufferSize);
@@ -1176,10 +1718,26 @@ PatchbayGraph::PatchbayGraph(const int bufferSize, const double sampleRate, cons
         node->properties.set("isAudio", false);
         node->properties.set("isMIDI", true);
     }
+
+    if (processThreads > 1)
+    {
+        processPool = new EngineProcessPool(processThreads, MAX_PATCHBAY_PLUGINS+4);
+        processTimings = new EngineProcessTimings(MAX_PATCHBAY_PLUGINS+4);
+        rebuildSchedule();
+    }
 }
 
 PatchbayGraph::~PatchbayGraph()
 {
+    if (processPool != nullptr)
+    {
+        clearSchedule();
+        delete processPool;
+        processPool = nullptr;
+        delete processTimings;
+        processTimings = nullptr;
+    }
+
     clearConnections();
     graph.releaseResources();
     graph.clear();
@@ -1188,9 +1746,11 @@ PatchbayGraph::~PatchbayGraph()
 
 void PatchbayGraph::setBufferSize(const int bufferSize)
 {
+    clearSchedule();
     graph.releaseResources();
     graph.prepareToPlay(graph.getSampleRate(), bufferSize);
     audioBuffer.setSize(audioBuffer.getNumChannels(), bufferSize);
+    rebuildSchedule();
 }
 
 void PatchbayGraph::setSampleRate(const double sampleRate)
@@ -1220,6 +1780,8 @@ void PatchbayGraph::addPlugin(CarlaPlugin* const plugin)
 
     if (! ignorePathbay)
         addNodeToPatchbay(plugin->getEngine(), node->nodeId, static_cast<int>(plugin->getId()), instance);
+
+    rebuildSchedule();
 }
 
 void PatchbayGraph::replacePlugin(CarlaPlugin* const oldPlugin, CarlaPlugin* const newPlugin)
@@ -1235,6 +1797,9 @@ void PatchbayGraph::replacePlugin(CarlaPlugin* const oldPlugin, CarlaPlugin* con
     AudioProcessorGraph::Node* const oldNode(graph.getNodeForId(oldPlugin->getPatchbayNodeId()));
     CARLA_SAFE_ASSERT_RETURN(oldNode != nullptr,);
 
+    // the old instance is about to be deleted, make sure the audio thread no longer uses it
+    clearSchedule();
+
     if (! ignorePathbay)
     {
         disconnectGroup(engine, oldNode->nodeId);
@@ -1254,6 +1819,8 @@ void PatchbayGraph::replacePlugin(CarlaPlugin* const oldPlugin, CarlaPlugin* con
 
     if (! ignorePathbay)
         addNodeToPatchbay(newPlugin->getEngine(), node->nodeId, static_cast<int>(newPlugin->getId()), instance);
+
+    rebuildSchedule();
 }
 
 void PatchbayGraph::removePlugin(CarlaPlugin* const plugin)
@@ -1267,6 +1834,8 @@ void PatchbayGraph::removePlugin(CarlaPlugin* const plugin)
     AudioProcessorGraph::Node* const node(graph.getNodeForId(plugin->getPatchbayNodeId()));
     CARLA_SAFE_ASSERT_RETURN(node != nullptr,);
 
+    clearSchedule();
+
     if (! ignorePathbay)
     {
         disconnectGroup(engine, node->nodeId);
@@ -1287,6 +1856,8 @@ void PatchbayGraph::removePlugin(CarlaPlugin* const plugin)
     }
 
     CARLA_SAFE_ASSERT_RETURN(graph.removeNode(node->nodeId),);
+
+    rebuildSchedule();
 }
 
 void PatchbayGraph::removeAllPlugins(CarlaEngine* const engine)
@@ -1294,6 +1865,8 @@ void PatchbayGraph::removeAllPlugins(CarlaEngine* const engine)
     CARLA_SAFE_ASSERT_RETURN(engine != nullptr,);
     carla_debug("PatchbayGraph::removeAllPlugins(%p)", engine);
 
+    clearSchedule();
+
     for (uint i=0, count=engine->getCurrentPluginCount(); i<count; ++i)
     {
         CarlaPlugin* const plugin(engine->getPlugin(i));
@@ -1310,6 +1883,8 @@ void PatchbayGraph::removeAllPlugins(CarlaEngine* const engine)
 
         graph.removeNode(node->nodeId);
     }
+
+    rebuildSchedule();
 }
 
 bool PatchbayGraph::connect(CarlaEngine* const engine, const uint groupA, const uint portA, const uint groupB, const uint portB) noexcept
@@ -1340,6 +1915,7 @@ bool PatchbayGraph::connect(CarlaEngine* const engine, const uint groupA, const
     engine->callback(ENGINE_CALLBACK_PATCHBAY_CONNECTION_ADDED, connectionToId.id, 0, 0, 0.0f, strBuf);
 
     connections.list.append(connectionToId);
+    rebuildSchedule();
     return true;
 }
 
@@ -1372,6 +1948,7 @@ bool PatchbayGraph::disconnect(CarlaEngine* const engine, const uint connectionI
         engine->callback(ENGINE_CALLBACK_PATCHBAY_CONNECTION_REMOVED, connectionToId.id, 0, 0, 0.0f, nullptr);
 
         connections.list.remove(it);
+        rebuildSchedule();
         return true;
     }
 
@@ -1410,6 +1987,8 @@ void PatchbayGraph::disconnectGroup(CarlaEngine* const engine, const uint groupI
 
         connections.list.remove(it);
     }
+
+    rebuildSchedule();
 }
 
 void PatchbayGraph::clearConnections()
@@ -1418,6 +1997,8 @@ void PatchbayGraph::clearConnections()
 
     for (int i=0, count=graph.getNumConnections(); i<count; ++i)
         graph.removeConnection(0);
+
+    rebuildSchedule();
 }
 
 void PatchbayGraph::refreshConnections(CarlaEngine* const engine)
@@ -1479,6 +2060,8 @@ void PatchbayGraph::refreshConnections(CarlaEngine* const engine)
 
         connections.list.append(connectionToId);
     }
+
+    rebuildSchedule();
 }
 
 const char* const* PatchbayGraph::getConnections() const
@@ -1578,13 +2161,37 @@ bool PatchbayGraph::getGroupAndPortIdFromFullName(const char* const fullPortName
     return false;
 }
 
+bool PatchbayGraph::getNodeTiming(const uint groupId, EngineProcessNodeTiming& timing, float& criticalPathUsecs) const noexcept
+{
+    // never lock here, the audio thread would fall back to the juce graph
+    if (processTimings == nullptr)
+        return false;
+
+    return processTimings->get(groupId, timing, criticalPathUsecs);
+}
+
 void PatchbayGraph::process(CarlaEngine::ProtectedData* const data, const float* const* const inBuf, float* const* const outBuf, const int frames)
 {
     CARLA_SAFE_ASSERT_RETURN(data != nullptr,);
-    CARLA_SAFE_ASSERT_RETURN(data->events.in != nullptr,);
-    CARLA_SAFE_ASSERT_RETURN(data->events.out != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(data->events.in.isAllocated(),);
+    CARLA_SAFE_ASSERT_RETURN(data->events.out.isAllocated(),);
     CARLA_SAFE_ASSERT_RETURN(frames > 0,);
 
+    // use our own parallel scheduler when possible, falls back to juce while the graph is being changed
+    if (processPool != nullptr && scheduleMutex.tryLock())
+    {
+        if (schedule != nullptr)
+        {
+            schedule->process(*processPool, data->events.in, data->events.out, inBuf, outBuf, frames);
+            schedule->publishTimings(*processTimings);
+            scheduleMutex.unlock();
+            return;
+        }
+
+        processTimings->clear();
+        scheduleMutex.unlock();
+    }
+
     // put events in juce buffer
     {
         midiBuffer.clear();
@@ -1613,12 +2220,53 @@ void PatchbayGraph::process(CarlaEngine::ProtectedData* const data, const float*
 
     // put juce events in carla buffer
     {
-        carla_zeroStruct<EngineEvent>(data->events.out, kMaxEngineEventInternalCount);
+        data->events.out.clear();
         fillEngineEventsFromJuceMidiBuffer(data->events.out, midiBuffer);
         midiBuffer.clear();
     }
 }
 
+void PatchbayGraph::clearSchedule()
+{
+    if (processPool == nullptr)
+        return;
+
+    PatchbayProcessSchedule* oldSchedule;
+
+    {
+        const CarlaMutexLocker cml(scheduleMutex);
+        oldSchedule = schedule;
+        schedule = nullptr;
+    }
+
+    delete oldSchedule;
+}
+
+void PatchbayGraph::rebuildSchedule()
+{
+    if (processPool == nullptr)
+        return;
+
+    PatchbayProcessSchedule* newSchedule(new PatchbayProcessSchedule(*this, processPool->getMaxNodes()));
+
+    if (! newSchedule->isValid())
+    {
+        carla_stdout("PatchbayGraph::rebuildSchedule() - graph has feedback loops, using single-threaded processing");
+        delete newSchedule;
+        newSchedule = nullptr;
+    }
+
+    PatchbayProcessSchedule* oldSchedule;
+
+    {
+        const CarlaMutexLocker cml(scheduleMutex);
+        oldSchedule = schedule;
+        schedule = newSchedule;
+    }
+
+    delete oldSchedule;
+}
+
 // -----------------------------------------------------------------------
 // InternalGraph
 
@@ -1635,7 +2283,7 @@ EngineInternalGraph::~EngineInternalGraph() noexcept
     CARLA_SAFE_ASSERT(fRack == nullptr);
 }
 
-void EngineInternalGraph::create(const bool isRack, const double sampleRate, const uint32_t bufferSize, const uint32_t inputs, const uint32_t outputs)
+void EngineInternalGraph::create(const bool isRack, const double sampleRate, const uint32_t bufferSize, const uint32_t inputs, const uint32_t outputs, const uint processThreads)
 {
     fIsRack = isRack;
 
@@ -1647,7 +2295,7 @@ void EngineInternalGraph::create(const bool isRack, const double sampleRate, con
     else
     {
         CARLA_SAFE_ASSERT_RETURN(fPatchbay == nullptr,);
-        fPatchbay = new PatchbayGraph(static_cast<int>(bufferSize), sampleRate, inputs, outputs);
+        fPatchbay = new PatchbayGraph(static_cast<int>(bufferSize), sampleRate, inputs, outputs, processThreads);
     }
 
     fIsReady = true;
@@ -1863,6 +2511,19 @@ bool CarlaEngine::patchbayRefresh(const bool external)
     return true;
 }
 
+bool CarlaEngine::getPatchbayGroupTiming(const uint groupId, EngineProcessNodeTiming& timing, float& criticalPathUsecs) const
+{
+    CARLA_SAFE_ASSERT_RETURN(pData->graph.isReady(), false);
+
+    if (pData->options.processMode != ENGINE_PROCESS_MODE_PATCHBAY)
+        return false;
+
+    PatchbayGraph* const graph = pData->graph.getPatchbayGraph();
+    CARLA_SAFE_ASSERT_RETURN(graph != nullptr, false);
+
+    return graph->getNodeTiming(groupId, timing, criticalPathUsecs);
+}
+
 // -----------------------------------------------------------------------
 
 const char* const* CarlaEngine::getPatchbayConnections() const
@@ -19,6 +19,7 @@
 #define CARLA_ENGINE_GRAPH_HPP_INCLUDED
 
 #include "CarlaEngine.hpp"
+#include "CarlaEngineProcessPool.hpp"
 #include "CarlaMutex.hpp"
 #include "CarlaPatchbayUtils.hpp"
 #include "CarlaStringList.hpp"
@@ -54,6 +55,33 @@ enum RackGraphCarlaPortIds {
     RACK_GRAPH_CARLA_PORT_MAX        = 7
 };
 
+// -----------------------------------------------------------------------
+// RackGraphRoutes
+
+/*
+ * Flat audio routing table of the rack graph, compiled from the connection lists and never modified once published.
+ * Every connection change publishes a new table, the audio thread picks up the newest one each cycle without locking.
+ * Older tables are deleted on a later change, once the audio thread no longer uses them.
+ */
+struct RackGraphRoutes {
+    struct Route {
+        uint src; // external input port, or rack output channel
+        uint dst; // rack input channel, or external output port
+    };
+
+    Route* routes; // inCount + outCount entries, inputs first and grouped by rack channel
+    uint inCount;
+    uint outCount;
+    uint serial;
+
+    RackGraphRoutes* older; // previous tables not yet reclaimed
+
+    RackGraphRoutes(const uint count);
+    ~RackGraphRoutes() noexcept;
+
+    CARLA_DECLARE_NON_COPY_STRUCT(RackGraphRoutes)
+};
+
 // -----------------------------------------------------------------------
 // RackGraph
 
@@ -65,11 +93,13 @@ struct RackGraph {
     mutable CharStringListPtr retCon;
 
     struct Audio {
-        CarlaRecursiveMutex mutex;
+        CarlaRecursiveMutex mutex; // for the connection lists, not used by the audio thread
         LinkedList<uint> connectedIn1;
         LinkedList<uint> connectedIn2;
         LinkedList<uint> connectedOut1;
         LinkedList<uint> connectedOut2;
+        juce::Atomic<RackGraphRoutes*> routes;   // newest routing table, with older ones chained
+        juce::Atomic<int>              rtSerial; // serial of the routing table used by the audio thread
         float* inBuf[2];
         float* inBufTmp[2];
         float* outBuf[2];
@@ -108,11 +138,19 @@ struct RackGraph {
 
     // extended, will call process() in the middle
     void processHelper(CarlaEngine::ProtectedData* const data, const float* const* const inBuf, float* const* const outBuf, const uint32_t frames);
+
+    // compile the audio connection lists into a new routing table, must be called with audio.mutex locked
+    void publishRoutes() noexcept;
+
+    // delete routing tables the audio thread is done with, or all of them
+    void reclaimRoutes(const bool all) noexcept;
 };
 
 // -----------------------------------------------------------------------
 // PatchbayGraph
 
+class PatchbayProcessSchedule;
+
 struct PatchbayGraph  {
     PatchbayConnectionList connections;
     AudioProcessorGraph graph;
@@ -123,7 +161,13 @@ struct PatchbayGraph  {
     bool ignorePathbay;
     mutable CharStringListPtr retCon;
 
-    PatchbayGraph(const int bufferSize, const double sampleRate, const uint32_t inputs, const uint32_t outputs);
+    // parallel processing, null when running single-threaded
+    EngineProcessPool* processPool;
+    EngineProcessTimings* processTimings; // lock-free copy of the schedule timings, for the UI
+    PatchbayProcessSchedule* schedule;
+    CarlaMutex scheduleMutex;
+
+    PatchbayGraph(const int bufferSize, const double sampleRate, const uint32_t inputs, const uint32_t outputs, const uint processThreads);
     ~PatchbayGraph();
 
     void setBufferSize(const int bufferSize);
@@ -143,8 +187,13 @@ struct PatchbayGraph  {
 
     const char* const* getConnections() const;
     bool getGroupAndPortIdFromFullName(const char* const fullPortName, uint& groupId, uint& portId) const;
+    bool getNodeTiming(const uint groupId, EngineProcessNodeTiming& timing, float& criticalPathUsecs) const noexcept;
 
     void process(CarlaEngine::ProtectedData* const data, const float* const* const inBuf, float* const* const outBuf, const int frames);
+
+    // build processing order from current connections, called after every graph change
+    void clearSchedule();
+    void rebuildSchedule();
 };
 
 // -----------------------------------------------------------------------
@@ -30,28 +30,19 @@ CARLA_BACKEND_START_NAMESPACE
 // InternalEvents
 
 EngineInternalEvents::EngineInternalEvents() noexcept
-    : in(nullptr),
-      out(nullptr) {}
+    : in(),
+      out() {}
 
 EngineInternalEvents::~EngineInternalEvents() noexcept
 {
-    CARLA_SAFE_ASSERT(in == nullptr);
-    CARLA_SAFE_ASSERT(out == nullptr);
+    CARLA_SAFE_ASSERT(! in.isAllocated());
+    CARLA_SAFE_ASSERT(! out.isAllocated());
 }
 
 void EngineInternalEvents::clear() noexcept
 {
-    if (in != nullptr)
-    {
-        delete[] in;
-        in = nullptr;
-    }
-
-    if (out != nullptr)
-    {
-        delete[] out;
-        out = nullptr;
-    }
+    in.free();
+    out.free();
 }
 
 // -----------------------------------------------------------------------
@@ -90,11 +81,123 @@ void EngineNextAction::clearAndReset() noexcept
     mutex.unlock();
 }
 
+// -----------------------------------------------------------------------
+// EngineDspLoadStats
+
+void EngineDspLoadStats::clear() noexcept
+{
+    carla_zeroStruct(*this);
+}
+
+void EngineDspLoadStats::add(const double seconds, const uint32_t frames, const double sampleRate) noexcept
+{
+    if (frames == 0 || sampleRate <= 0.0)
+        return;
+
+    const float load(static_cast<float>(seconds * sampleRate / static_cast<double>(frames) * 100.0));
+
+    if (cycles == 0)
+    {
+        average = load;
+        minimum = load;
+        maximum = load;
+    }
+    else
+    {
+        average += (load - average) * 0.1f;
+
+        if (load < minimum)
+            minimum = load;
+        if (load > maximum)
+            maximum = load;
+    }
+
+    if (load > 100.0f)
+        ++xruns;
+
+    const uint bucket(static_cast<uint>(load / 2.0f));
+    ++buckets[bucket < kEngineDspLoadBucketCount ? bucket : kEngineDspLoadBucketCount-1];
+
+    current = load;
+    ++cycles;
+}
+
+void EngineDspLoadStats::get(EngineDspLoad& load) const noexcept
+{
+    load.current = current;
+    load.average = average;
+    load.minimum = minimum;
+    load.maximum = maximum;
+    load.xruns   = xruns;
+    load.cycles  = cycles;
+
+    uint64_t total = 0;
+
+    for (uint i=0; i < kEngineDspLoadBucketCount; ++i)
+        total += buckets[i];
+
+    load.percentile95 = 0.0f;
+    load.percentile99 = 0.0f;
+
+    if (total == 0)
+        return;
+
+    const uint64_t limit95((total * 95 + 99) / 100);
+    const uint64_t limit99((total * 99 + 99) / 100);
+    uint64_t sum = 0;
+
+    for (uint i=0; i < kEngineDspLoadBucketCount; ++i)
+    {
+        sum += buckets[i];
+
+        // upper edge of the bucket, or the real maximum if lower
+        float value(maximum);
+
+        if (i+1 < kEngineDspLoadBucketCount && static_cast<float>(i+1) * 2.0f < maximum)
+            value = static_cast<float>(i+1) * 2.0f;
+
+        if (load.percentile95 == 0.0f && sum >= limit95)
+            load.percentile95 = value;
+
+        if (sum >= limit99)
+        {
+            load.percentile99 = value;
+            break;
+        }
+    }
+}
+
+#ifndef BUILD_BRIDGE
+// -----------------------------------------------------------------------
+// EnginePluginList
+
+EnginePluginList::EnginePluginList(const uint maxPluginNumber)
+    : plugins(new EnginePluginData[maxPluginNumber]),
+      count(0),
+      serial(0),
+      removed(new CarlaPlugin*[maxPluginNumber]),
+      removedCount(0),
+      older(nullptr)
+{
+    carla_zeroStruct(plugins, maxPluginNumber);
+    carla_zeroPointers(removed, maxPluginNumber);
+}
+
+EnginePluginList::~EnginePluginList() noexcept
+{
+    CARLA_SAFE_ASSERT(removedCount == 0);
+
+    delete[] plugins;
+    delete[] removed;
+}
+#endif
+
 // -----------------------------------------------------------------------
 // CarlaEngine::ProtectedData
 
 CarlaEngine::ProtectedData::ProtectedData(CarlaEngine* const engine) noexcept
     : thread(engine),
+      workers(),
 #ifdef HAVE_LIBLO
       osc(engine),
       oscData(nullptr),
@@ -118,13 +221,18 @@ CarlaEngine::ProtectedData::ProtectedData(CarlaEngine* const engine) noexcept
       timeInfo(),
 #ifndef BUILD_BRIDGE
       plugins(nullptr),
+      pluginList(nullptr),
+      rtPluginList(nullptr),
+      rtPluginListSerial(0),
+      pluginListMutex(),
 #endif
       events(),
 #ifndef BUILD_BRIDGE
       graph(),
 #endif
       time(),
-      nextAction()
+      nextAction(),
+      dspLoad()
 {
 #ifdef BUILD_BRIDGE
     carla_zeroStruct(plugins, 1);
@@ -139,6 +247,7 @@ CarlaEngine::ProtectedData::~ProtectedData() noexcept
     CARLA_SAFE_ASSERT(isIdling == 0);
 #ifndef BUILD_BRIDGE
     CARLA_SAFE_ASSERT(plugins == nullptr);
+    CARLA_SAFE_ASSERT(pluginList.get() == nullptr);
 #endif
 }
 
@@ -150,8 +259,8 @@ bool CarlaEngine::ProtectedData::init(const char* const clientName)
 #ifdef HAVE_LIBLO
     CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(oscData == nullptr, "Invalid engine internal data (err #2)");
 #endif
-    CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(events.in  == nullptr, "Invalid engine internal data (err #4)");
-    CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(events.out == nullptr, "Invalid engine internal data (err #5)");
+    CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(! events.in.isAllocated(),  "Invalid engine internal data (err #4)");
+    CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(! events.out.isAllocated(), "Invalid engine internal data (err #5)");
     CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(clientName != nullptr && clientName[0] != '\0', "Invalid client name");
 #ifndef BUILD_BRIDGE
     CARLA_SAFE_ASSERT_RETURN_INTERNAL_ERR(plugins == nullptr, "Invalid engine internal data (err #3)");
@@ -183,8 +292,12 @@ bool CarlaEngine::ProtectedData::init(const char* const clientName)
     case ENGINE_PROCESS_MODE_CONTINUOUS_RACK:
     case ENGINE_PROCESS_MODE_PATCHBAY:
     case ENGINE_PROCESS_MODE_BRIDGE:
-        events.in  = new EngineEvent[kMaxEngineEventInternalCount];
-        events.out = new EngineEvent[kMaxEngineEventInternalCount];
+        if (! (events.in.alloc() && events.out.alloc()))
+        {
+            events.clear();
+            lastError = "Failed to allocate event buffers";
+            return false;
+        }
         break;
     default:
         break;
@@ -196,6 +309,7 @@ bool CarlaEngine::ProtectedData::init(const char* const clientName)
     name.toBasic();
 
     timeInfo.clear();
+    dspLoad.clear();
 
 #ifdef HAVE_LIBLO
     osc.init(clientName);
@@ -205,12 +319,17 @@ bool CarlaEngine::ProtectedData::init(const char* const clientName)
 #endif
 
 #ifndef BUILD_BRIDGE
-    plugins = new EnginePluginData[maxPluginNumber];
-    carla_zeroStruct(plugins, maxPluginNumber);
+    EnginePluginList* const list(new EnginePluginList(maxPluginNumber));
+
+    plugins            = list->plugins;
+    pluginList         = list;
+    rtPluginList       = list;
+    rtPluginListSerial = 0;
 #endif
 
     nextAction.ready();
     thread.startThread();
+    workers.startThreads();
 
     return true;
 }
@@ -222,9 +341,15 @@ void CarlaEngine::ProtectedData::close()
     CARLA_SAFE_ASSERT(nextPluginId == maxPluginNumber);
     CARLA_SAFE_ASSERT(nextAction.opcode == kEnginePostActionNull);
 
+#ifndef BUILD_BRIDGE
+    // audio has stopped at this point, delete any pending plugins
+    reclaimPluginLists(true);
+#endif
+
     aboutToClose = true;
 
     thread.stopThread(500);
+    workers.stopThreads();
     nextAction.ready();
 
 #ifdef HAVE_LIBLO
@@ -238,10 +363,15 @@ void CarlaEngine::ProtectedData::close()
     nextPluginId    = 0;
 
 #ifndef BUILD_BRIDGE
-    if (plugins != nullptr)
+    if (EnginePluginList* const list = pluginList.get())
     {
-        delete[] plugins;
-        plugins = nullptr;
+        CARLA_SAFE_ASSERT(list->older == nullptr);
+
+        pluginList   = nullptr;
+        rtPluginList = nullptr;
+        plugins      = nullptr;
+
+        delete list;
     }
 #endif
 
@@ -251,91 +381,152 @@ void CarlaEngine::ProtectedData::close()
 
 // -----------------------------------------------------------------------
 
-#ifndef BUILD_BRIDGE
-void CarlaEngine::ProtectedData::doPluginRemove() noexcept
+void CarlaEngine::ProtectedData::doNextPluginAction(const bool unlock) noexcept
 {
-    CARLA_SAFE_ASSERT_RETURN(curPluginCount > 0,);
-    CARLA_SAFE_ASSERT_RETURN(nextAction.pluginId < curPluginCount,);
-    --curPluginCount;
+    switch (nextAction.opcode)
+    {
+    case kEnginePostActionNull:
+        break;
+    case kEnginePostActionZeroCount:
+        curPluginCount = 0;
+        break;
+    }
 
-    // move all plugins 1 spot backwards
-    for (uint i=nextAction.pluginId; i < curPluginCount; ++i)
+    nextAction.opcode   = kEnginePostActionNull;
+    nextAction.pluginId = 0;
+    nextAction.value    = 0;
+
+    if (unlock)
     {
-        CarlaPlugin* const plugin(plugins[i+1].plugin);
+        nextAction.mutex.tryLock();
+        nextAction.mutex.unlock();
+    }
+}
+
+#ifndef BUILD_BRIDGE
+// -----------------------------------------------------------------------
 
-        CARLA_SAFE_ASSERT_BREAK(plugin != nullptr);
+EnginePluginList* CarlaEngine::ProtectedData::copyPluginList() const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(plugins != nullptr, nullptr);
+    CARLA_SAFE_ASSERT_RETURN(maxPluginNumber > 0, nullptr);
 
-        plugin->setId(i);
+    EnginePluginList* list;
 
-        plugins[i].plugin      = plugin;
-        plugins[i].insPeak[0]  = 0.0f;
-        plugins[i].insPeak[1]  = 0.0f;
-        plugins[i].outsPeak[0] = 0.0f;
-        plugins[i].outsPeak[1] = 0.0f;
-    }
+    try {
+        list = new EnginePluginList(maxPluginNumber);
+    } CARLA_SAFE_EXCEPTION_RETURN("new EnginePluginList", nullptr);
 
-    const uint id(curPluginCount);
+    carla_copyStruct(list->plugins, plugins, maxPluginNumber);
+    list->count = curPluginCount;
 
-    // reset last plugin (now removed)
-    plugins[id].plugin      = nullptr;
-    plugins[id].insPeak[0]  = 0.0f;
-    plugins[id].insPeak[1]  = 0.0f;
-    plugins[id].outsPeak[0] = 0.0f;
-    plugins[id].outsPeak[1] = 0.0f;
+    return list;
 }
 
-void CarlaEngine::ProtectedData::doPluginsSwitch() noexcept
+void CarlaEngine::ProtectedData::publishPluginList(EnginePluginList* const list, const bool rtRunning) noexcept
 {
-    CARLA_SAFE_ASSERT_RETURN(curPluginCount >= 2,);
+    CARLA_SAFE_ASSERT_RETURN(list != nullptr,);
 
-    const uint idA(nextAction.pluginId);
-    const uint idB(nextAction.value);
+    {
+        const CarlaMutexLocker cml(pluginListMutex);
+
+        EnginePluginList* const newest(pluginList.get());
+        CARLA_SAFE_ASSERT_RETURN(newest != nullptr,);
+
+        list->serial = newest->serial + 1;
+        list->older  = newest;
+
+        // keep count and data valid for non-RT readers in between
+        if (list->count < curPluginCount)
+        {
+            curPluginCount = list->count;
+            plugins        = list->plugins;
+        }
+        else
+        {
+            plugins        = list->plugins;
+            curPluginCount = list->count;
+        }
+
+        pluginList = list;
+    }
 
-    CARLA_SAFE_ASSERT_RETURN(idA < curPluginCount,);
-    CARLA_SAFE_ASSERT_RETURN(idB < curPluginCount,);
-    CARLA_SAFE_ASSERT_RETURN(plugins[idA].plugin != nullptr,);
-    CARLA_SAFE_ASSERT_RETURN(plugins[idB].plugin != nullptr,);
+    // plugins that moved get their new Ids, the audio thread does not need them to match its list
+    for (uint i=0; i < list->count; ++i)
+    {
+        CarlaPlugin* const plugin(list->plugins[i].plugin);
 
-#if 0
-    std::swap(plugins[idA].plugin, plugins[idB].plugin);
-#else
-    CarlaPlugin* const tmp(plugins[idA].plugin);
+        if (plugin != nullptr && plugin->getId() != i)
+            plugin->setId(i);
+    }
 
-    plugins[idA].plugin = plugins[idB].plugin;
-    plugins[idB].plugin = tmp;
-#endif
+    reclaimPluginLists(! rtRunning);
 }
-#endif
 
-void CarlaEngine::ProtectedData::doNextPluginAction(const bool unlock) noexcept
+void CarlaEngine::ProtectedData::updateRtPluginList() noexcept
 {
-    switch (nextAction.opcode)
+    const EnginePluginList* const list(pluginList.get());
+
+    if (list == rtPluginList || list == nullptr)
+        return;
+
+    rtPluginList       = list;
+    rtPluginListSerial = static_cast<int>(list->serial);
+}
+
+void CarlaEngine::ProtectedData::reclaimPluginLists(const bool force) noexcept
+{
+    const CarlaMutexLocker cml(pluginListMutex);
+
+    EnginePluginList* const newest(pluginList.get());
+    CARLA_SAFE_ASSERT_RETURN(newest != nullptr,);
+
+    if (force)
     {
-    case kEnginePostActionNull:
-        break;
-    case kEnginePostActionZeroCount:
-        curPluginCount = 0;
-        break;
-#ifndef BUILD_BRIDGE
-    case kEnginePostActionRemovePlugin:
-        doPluginRemove();
-        break;
-    case kEnginePostActionSwitchPlugins:
-        doPluginsSwitch();
-        break;
-#endif
+        rtPluginList       = newest;
+        rtPluginListSerial = static_cast<int>(newest->serial);
     }
 
-    nextAction.opcode   = kEnginePostActionNull;
-    nextAction.pluginId = 0;
-    nextAction.value    = 0;
+    const uint rtSerial(static_cast<uint>(rtPluginListSerial.get()));
 
-    if (unlock)
+    for (EnginePluginList* list = newest; list != nullptr; list = list->older)
     {
-        nextAction.mutex.tryLock();
-        nextAction.mutex.unlock();
+        if (list->serial > rtSerial)
+            continue;
+
+        // the audio thread is using 'list' or a newer one, removed plugins are now unused
+        for (uint i=0; i < list->removedCount; ++i)
+        {
+            CarlaPlugin* const plugin(list->removed[i]);
+            list->removed[i] = nullptr;
+
+            try {
+                delete plugin;
+            } CARLA_SAFE_EXCEPTION("delete removed plugin");
+        }
+
+        list->removedCount = 0;
+    }
+
+    for (EnginePluginList* list = newest; list != nullptr; list = list->older)
+    {
+        if (list->serial > rtSerial)
+            continue;
+
+        // everything older than the list in use by the audio thread can go
+        EnginePluginList* old(list->older);
+        list->older = nullptr;
+
+        for (; old != nullptr;)
+        {
+            EnginePluginList* const older(old->older);
+            delete old;
+            old = older;
+        }
+        break;
     }
 }
+#endif
 
 // -----------------------------------------------------------------------
 // ScopedActionLock
@@ -22,6 +22,8 @@
 #include "CarlaEngineThread.hpp"
 #include "CarlaEngineUtils.hpp"
 
+#include "juce_core.h"
+
 // FIXME only use CARLA_PREVENT_HEAP_ALLOCATION for structs
 // maybe separate macro
 
@@ -40,8 +42,8 @@ CARLA_BACKEND_START_NAMESPACE
 // InternalEvents
 
 struct EngineInternalEvents {
-    EngineEvent* in;
-    EngineEvent* out;
+    EngineEventBuffer in;
+    EngineEventBuffer out;
 
     EngineInternalEvents() noexcept;
     ~EngineInternalEvents() noexcept;
@@ -63,7 +65,7 @@ public:
     EngineInternalGraph() noexcept;
     ~EngineInternalGraph() noexcept;
 
-    void create(const bool isRack, const double sampleRate, const uint32_t bufferSize, const uint32_t inputs, const uint32_t outputs);
+    void create(const bool isRack, const double sampleRate, const uint32_t bufferSize, const uint32_t inputs, const uint32_t outputs, const uint processThreads);
     void destroy() noexcept;
 
     void setBufferSize(const uint32_t bufferSize);
@@ -119,11 +121,7 @@ struct EngineInternalTime {
 
 enum EnginePostAction {
     kEnginePostActionNull = 0,
-    kEnginePostActionZeroCount,    // set curPluginCount to 0
-#ifndef BUILD_BRIDGE
-    kEnginePostActionRemovePlugin, // remove a plugin
-    kEnginePostActionSwitchPlugins // switch between 2 plugins
-#endif
+    kEnginePostActionZeroCount // set curPluginCount to 0
 };
 
 struct EngineNextAction {
@@ -140,6 +138,35 @@ struct EngineNextAction {
     CARLA_DECLARE_NON_COPY_STRUCT(EngineNextAction)
 };
 
+// -----------------------------------------------------------------------
+// EngineDspLoadStats
+
+// number of 2% wide load buckets used for percentiles, the last one also takes anything above 200%
+const uint kEngineDspLoadBucketCount = 101;
+
+/*
+ * Processing load accumulator, written by a single audio thread and read from any other.
+ * There are no locks, readers may see a cycle half-way through being added.
+ * Plain struct, zeroing it is the same as clear().
+ */
+struct EngineDspLoadStats {
+    float    current;
+    float    average;
+    float    minimum;
+    float    maximum;
+    uint32_t xruns;
+    uint32_t cycles;
+    uint32_t buckets[kEngineDspLoadBucketCount];
+
+    void clear() noexcept;
+
+    // add one cycle which took 'seconds' to process 'frames'
+    // @note RT call
+    void add(const double seconds, const uint32_t frames, const double sampleRate) noexcept;
+
+    void get(EngineDspLoad& load) const noexcept;
+};
+
 // -----------------------------------------------------------------------
 // EnginePluginData
 
@@ -147,13 +174,48 @@ struct EnginePluginData {
     CarlaPlugin* plugin;
     float insPeak[2];
     float outsPeak[2];
+    EngineDspLoadStats dspLoad;
+};
+
+#ifndef BUILD_BRIDGE
+// -----------------------------------------------------------------------
+// EnginePluginList
+
+/*
+ * Snapshot of the plugin list.
+ * Plugin add/remove/switch create a new copy and publish it (read-copy-update), the plugins
+ * and count of a list are never modified once published.
+ * Peaks and DSP load are written by the audio thread into the list it is using, and copied
+ * into the next list when that is created.
+ * The audio thread picks up the newest list between cycles, older lists and the plugins removed
+ * from them are deleted on the idle thread after the audio thread stopped using them.
+ * Plugin Ids follow the newest list as soon as it is published, so the audio thread can run one
+ * more cycle with the previous list where moved plugins write their peaks and load in the wrong
+ * entry, that list is thrown away right after.
+ */
+struct EnginePluginList {
+    EnginePluginData* plugins; // maxPluginNumber entries
+    uint count;
+    uint serial;
+
+    CarlaPlugin** removed;     // plugins to delete once the audio thread uses this list
+    uint removedCount;
+
+    EnginePluginList* older;   // previous lists not yet reclaimed
+
+    EnginePluginList(const uint maxPluginNumber);
+    ~EnginePluginList() noexcept;
+
+    CARLA_DECLARE_NON_COPY_STRUCT(EnginePluginList)
 };
+#endif
 
 // -----------------------------------------------------------------------
 // CarlaEngineProtectedData
 
 struct CarlaEngine::ProtectedData {
-    CarlaEngineThread thread;
+    CarlaEngineThread     thread;
+    CarlaEngineWorkerPool workers;
 
 #ifdef HAVE_LIBLO
     CarlaEngineOsc osc;
@@ -189,7 +251,12 @@ struct CarlaEngine::ProtectedData {
 #ifdef BUILD_BRIDGE
     EnginePluginData plugins[1];
 #else
-    EnginePluginData* plugins;
+    EnginePluginData* plugins; // newest plugin list, for non-RT threads
+
+    juce::Atomic<EnginePluginList*> pluginList;         // newest plugin list, with older ones chained
+    const EnginePluginList*         rtPluginList;       // plugin list used by the audio thread
+    juce::Atomic<int>               rtPluginListSerial;
+    CarlaMutex                      pluginListMutex;
 #endif
 
     EngineInternalEvents events;
@@ -198,6 +265,7 @@ struct CarlaEngine::ProtectedData {
 #endif
     EngineInternalTime   time;
     EngineNextAction     nextAction;
+    EngineDspLoadStats   dspLoad; // full audio cycle
 
     // -------------------------------------------------------------------
 
@@ -211,10 +279,27 @@ struct CarlaEngine::ProtectedData {
 
     // -------------------------------------------------------------------
 
-    void doPluginRemove() noexcept;
-    void doPluginsSwitch() noexcept;
     void doNextPluginAction(const bool unlock) noexcept;
 
+#ifndef BUILD_BRIDGE
+    // -------------------------------------------------------------------
+    // plugin list, read-copy-update
+
+    // create a copy of the newest plugin list, returns null on failure
+    EnginePluginList* copyPluginList() const noexcept;
+
+    // make 'list' the newest plugin list, takes ownership
+    // plugin Ids are updated to match it, if the audio thread is not running the list is used right away
+    void publishPluginList(EnginePluginList* const list, const bool rtRunning) noexcept;
+
+    // called by the audio thread between cycles
+    void updateRtPluginList() noexcept;
+
+    // delete lists and plugins no longer in use by the audio thread
+    // 'force' is only valid when the audio thread is stopped
+    void reclaimPluginLists(const bool force) noexcept;
+#endif
+
     // -------------------------------------------------------------------
 
     //friend class ScopedActionLock;
@@ -231,15 +316,21 @@ class PendingRtEventsRunner
 {
 public:
     PendingRtEventsRunner(CarlaEngine* const engine) noexcept
-        : fEngine(engine) {}
+        : fEngine(engine),
+          fStartTicks(juce::Time::getHighResolutionTicks()) {}
 
     ~PendingRtEventsRunner() noexcept
     {
         fEngine->runPendingRtEvents();
+
+        if (! fEngine->isOffline())
+            fEngine->pData->dspLoad.add(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks()-fStartTicks),
+                                        fEngine->pData->bufferSize, fEngine->pData->sampleRate);
     }
 
 private:
     CarlaEngine* const fEngine;
+    const juce::int64  fStartTicks;
 
     CARLA_PREVENT_HEAP_ALLOCATION
     CARLA_DECLARE_NON_COPY_CLASS(PendingRtEventsRunner)
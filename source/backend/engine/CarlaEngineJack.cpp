@@ -16,6 +16,7 @@
  */
 
 #include "CarlaEngineInternal.hpp"
+#include "CarlaEngineProcessPool.hpp"
 #include "CarlaPlugin.hpp"
 
 #include "CarlaBackendUtils.hpp"
@@ -44,6 +45,7 @@
 using juce::FloatVectorOperations;
 using juce::String;
 using juce::StringArray;
+using juce::Time;
 
 CARLA_BACKEND_START_NAMESPACE
 
@@ -647,10 +649,16 @@ private:
 // Jack Engine
 
 class CarlaEngineJack : public CarlaEngine
+#ifndef BUILD_BRIDGE
+                      , public EngineProcessGraph::Callback
+#endif
 {
 public:
     CarlaEngineJack()
         : CarlaEngine(),
+#ifndef BUILD_BRIDGE
+          EngineProcessGraph::Callback(),
+#endif
           fClient(nullptr),
           fTransportPos(),
           fTransportState(JackTransportStopped),
@@ -664,6 +672,9 @@ public:
           fUsedConnections(),
           fNewGroups(),
           fRetConns(),
+          fProcessPool(nullptr),
+          fProcessGraph(nullptr),
+          fProcessFrames(0),
 #endif
           leakDetector_CarlaEngineJack()
     {
@@ -687,6 +698,9 @@ public:
         CARLA_SAFE_ASSERT(fClient == nullptr);
 
 #ifndef BUILD_BRIDGE
+        CARLA_SAFE_ASSERT(fProcessPool == nullptr);
+        CARLA_SAFE_ASSERT(fProcessGraph == nullptr);
+
         fUsedGroups.clear();
         fUsedPorts.clear();
         fUsedConnections.clear();
@@ -816,14 +830,20 @@ public:
 
             if (pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK)
             {
-                pData->graph.create(true, pData->sampleRate, pData->bufferSize, 0, 0);
+                pData->graph.create(true, pData->sampleRate, pData->bufferSize, 0, 0, 0);
             }
             else
             {
-                pData->graph.create(false, pData->sampleRate, pData->bufferSize, 2, 2);
+                pData->graph.create(false, pData->sampleRate, pData->bufferSize, 2, 2, pData->options.processThreads);
                 patchbayRefresh(false);
             }
         }
+        else if (pData->options.processMode == ENGINE_PROCESS_MODE_SINGLE_CLIENT && pData->options.processThreads > 1)
+        {
+            // plugins have their own ports and do not depend on each other, a graph without edges is enough
+            fProcessGraph = new EngineProcessGraph(pData->maxPluginNumber, nullptr, nullptr, 0);
+            fProcessPool  = new EngineProcessPool(pData->options.processThreads, pData->maxPluginNumber);
+        }
 
         if (jackbridge_activate(fClient))
         {
@@ -837,6 +857,8 @@ public:
             pData->graph.destroy();
         }
 
+        deleteProcessPool();
+
         pData->close();
         jackbridge_client_close(fClient);
         fClient = nullptr;
@@ -887,6 +909,8 @@ public:
             pData->graph.destroy();
         }
 
+        deleteProcessPool();
+
         // close client
         if (deactivated)
             jackbridge_client_close(fClient);
@@ -1362,7 +1386,11 @@ protected:
             plugin->unlock();
         }
 #else
-        if (pData->curPluginCount == 0 && pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK)
+        CARLA_SAFE_ASSERT_RETURN(pData->rtPluginList != nullptr,);
+
+        const EnginePluginList* const pluginList(pData->rtPluginList);
+
+        if (pluginList->count == 0 && pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK)
         {
             // pass-through
             // TODO MIDI as well
@@ -1381,9 +1409,16 @@ protected:
 
         if (pData->options.processMode == ENGINE_PROCESS_MODE_SINGLE_CLIENT)
         {
-            for (uint i=0; i < pData->curPluginCount; ++i)
+            if (fProcessPool != nullptr && pluginList->count > 1)
             {
-                CarlaPlugin* const plugin(pData->plugins[i].plugin);
+                fProcessFrames = nframes;
+                fProcessPool->process(*fProcessGraph, this);
+                return;
+            }
+
+            for (uint i=0; i < pluginList->count; ++i)
+            {
+                CarlaPlugin* const plugin(pluginList->plugins[i].plugin);
 
                 if (plugin != nullptr && plugin->isEnabled() && plugin->tryLock(fFreewheel))
                 {
@@ -1396,8 +1431,8 @@ protected:
         else if (pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK ||
                  pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
         {
-            CARLA_SAFE_ASSERT_RETURN(pData->events.in  != nullptr,);
-            CARLA_SAFE_ASSERT_RETURN(pData->events.out != nullptr,);
+            CARLA_SAFE_ASSERT_RETURN(pData->events.in.isAllocated(),);
+            CARLA_SAFE_ASSERT_RETURN(pData->events.out.isAllocated(),);
 
             // get buffers from jack
             float* const audioIn1  = (float*)jackbridge_port_get_buffer(fRackPorts[kRackPortAudioIn1], nframes);
@@ -1422,12 +1457,10 @@ protected:
             /**/  float* outBuf[2] = { audioOut1, audioOut2 };
 
             // initialize events
-            carla_zeroStruct<EngineEvent>(pData->events.in,  kMaxEngineEventInternalCount);
-            carla_zeroStruct<EngineEvent>(pData->events.out, kMaxEngineEventInternalCount);
+            pData->events.in.clear();
+            pData->events.out.clear();
 
             {
-                ushort engineEventIndex = 0;
-
                 jack_midi_event_t jackEvent;
                 const uint32_t jackEventCount(jackbridge_midi_get_event_count(eventIn));
 
@@ -1438,13 +1471,13 @@ protected:
 
                     CARLA_SAFE_ASSERT_CONTINUE(jackEvent.size <= 0xFF /* uint8_t max */);
 
-                    EngineEvent& engineEvent(pData->events.in[engineEventIndex++]);
-
-                    engineEvent.time = jackEvent.time;
-                    engineEvent.fillFromMidiData(static_cast<uint8_t>(jackEvent.size), jackEvent.buffer);
+                    EngineEvent* const engineEvent(pData->events.in.append());
 
-                    if (engineEventIndex >= kMaxEngineEventInternalCount)
+                    if (engineEvent == nullptr)
                         break;
+
+                    engineEvent->time = jackEvent.time;
+                    engineEvent->fillFromMidiData(static_cast<uint8_t>(jackEvent.size), jackEvent.buffer);
                 }
             }
 
@@ -1461,14 +1494,11 @@ protected:
                 uint8_t        data[3] = { 0, 0, 0 };
                 const uint8_t* dataPtr = data;
 
-                for (ushort i=0; i < kMaxEngineEventInternalCount; ++i)
+                for (uint32_t i=0; i < pData->events.out.count; ++i)
                 {
-                    const EngineEvent& engineEvent(pData->events.out[i]);
-
-                    if (engineEvent.type == kEngineEventTypeNull)
-                        break;
+                    const EngineEvent& engineEvent(pData->events.out.data[i]);
 
-                    else if (engineEvent.type == kEngineEventTypeControl)
+                    if (engineEvent.type == kEngineEventTypeControl)
                     {
                         const EngineControlEvent& ctrlEvent(engineEvent.ctrl);
                         ctrlEvent.convertToMidiData(engineEvent.channel, size, data);
@@ -1773,6 +1803,27 @@ private:
 
     mutable CharStringListPtr fRetConns;
 
+    // single-client parallel processing
+    EngineProcessPool*  fProcessPool;
+    EngineProcessGraph* fProcessGraph;
+    uint32_t            fProcessFrames;
+
+    void deleteProcessPool() noexcept
+    {
+        // pool first, its threads might still reference the graph
+        if (fProcessPool != nullptr)
+        {
+            delete fProcessPool;
+            fProcessPool = nullptr;
+        }
+
+        if (fProcessGraph != nullptr)
+        {
+            delete fProcessGraph;
+            fProcessGraph = nullptr;
+        }
+    }
+
     bool findPluginIdAndIcon(const char* const clientName, int& pluginId, PatchbayIcon& icon) noexcept
     {
         carla_debug("CarlaEngineJack::findPluginIdAndIcon(\"%s\", ...)", clientName);
@@ -2037,7 +2088,9 @@ private:
             }
         }
 
+        const juce::int64 startTicks(Time::getHighResolutionTicks());
         plugin->process(audioIn, audioOut, cvIn, cvOut, nframes);
+        setPluginProcessTime(plugin->getId(), Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()-startTicks), nframes);
 
         for (uint32_t i=0; i < audioOutCount && i < 2; ++i)
         {
@@ -2053,6 +2106,26 @@ private:
         setPluginPeaks(plugin->getId(), inPeaks, outPeaks);
     }
 
+#ifndef BUILD_BRIDGE
+    // called from the process pool threads, one node per plugin
+    void processGraphNode(const uint index) override
+    {
+        const EnginePluginList* const pluginList(pData->rtPluginList);
+
+        if (index >= pluginList->count)
+            return;
+
+        CarlaPlugin* const plugin(pluginList->plugins[index].plugin);
+
+        if (plugin != nullptr && plugin->isEnabled() && plugin->tryLock(fFreewheel))
+        {
+            plugin->initBuffers();
+            processPlugin(plugin, fProcessFrames);
+            plugin->unlock();
+        }
+    }
+#endif
+
     // -------------------------------------------------------------------
 
     #define handlePtr ((CarlaEngineJack*)arg)
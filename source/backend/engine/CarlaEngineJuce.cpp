@@ -181,7 +181,7 @@ public:
         pData->bufferSize = static_cast<uint32_t>(fDevice->getCurrentBufferSizeSamples());
         pData->sampleRate = fDevice->getCurrentSampleRate();
 
-        pData->graph.create(pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK, pData->sampleRate, pData->bufferSize, static_cast<uint32_t>(inputNames.size()), static_cast<uint32_t>(outputNames.size()));
+        pData->graph.create(pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK, pData->sampleRate, pData->bufferSize, static_cast<uint32_t>(inputNames.size()), static_cast<uint32_t>(outputNames.size()), pData->options.processThreads);
 
         fDevice->start(this);
 
@@ -512,35 +512,34 @@ protected:
             FloatVectorOperations::clear(outputChannelData[i], numSamples);
 
         // initialize events
-        carla_zeroStruct<EngineEvent>(pData->events.in,  kMaxEngineEventInternalCount);
-        carla_zeroStruct<EngineEvent>(pData->events.out, kMaxEngineEventInternalCount);
+        pData->events.in.clear();
+        pData->events.out.clear();
 
         if (fMidiInEvents.mutex.tryLock())
         {
-            uint32_t engineEventIndex = 0;
             fMidiInEvents.splice();
 
             for (LinkedList<RtMidiEvent>::Itenerator it = fMidiInEvents.data.begin(); it.valid(); it.next())
             {
                 const RtMidiEvent& midiEvent(it.getValue());
-                EngineEvent&       engineEvent(pData->events.in[engineEventIndex++]);
+                EngineEvent* const engineEvent(pData->events.in.append());
+
+                if (engineEvent == nullptr)
+                    break;
 
                 if (midiEvent.time < pData->timeInfo.frame)
                 {
-                    engineEvent.time = 0;
+                    engineEvent->time = 0;
                 }
                 else if (midiEvent.time >= pData->timeInfo.frame + nframes)
                 {
-                    carla_stderr("MIDI Event in the future!, %i vs %i", engineEvent.time, pData->timeInfo.frame);
-                    engineEvent.time = static_cast<uint32_t>(pData->timeInfo.frame) + nframes - 1;
+                    carla_stderr("MIDI Event in the future!, %i vs %i", engineEvent->time, pData->timeInfo.frame);
+                    engineEvent->time = static_cast<uint32_t>(pData->timeInfo.frame) + nframes - 1;
                 }
                 else
-                    engineEvent.time = static_cast<uint32_t>(midiEvent.time - pData->timeInfo.frame);
-
-                engineEvent.fillFromMidiData(midiEvent.size, midiEvent.data);
+                    engineEvent->time = static_cast<uint32_t>(midiEvent.time - pData->timeInfo.frame);
 
-                if (engineEventIndex >= kMaxEngineEventInternalCount)
-                    break;
+                engineEvent->fillFromMidiData(midiEvent.size, midiEvent.data);
             }
 
             fMidiInEvents.data.clear();
@@ -557,14 +556,11 @@ protected:
             uint8_t        data[3] = { 0, 0, 0 };
             const uint8_t* dataPtr = data;
 
-            for (ushort i=0; i < kMaxEngineEventInternalCount; ++i)
+            for (uint32_t i=0; i < pData->events.out.count; ++i)
             {
-                const EngineEvent& engineEvent(pData->events.out[i]);
-
-                if (engineEvent.type == kEngineEventTypeNull)
-                    break;
+                const EngineEvent& engineEvent(pData->events.out.data[i]);
 
-                else if (engineEvent.type == kEngineEventTypeControl)
+                if (engineEvent.type == kEngineEventTypeControl)
                 {
                     const EngineControlEvent& ctrlEvent(engineEvent.ctrl);
                     ctrlEvent.convertToMidiData(engineEvent.channel, size, data);
@@ -593,7 +593,7 @@ public:
             pData->options.preferPluginBridges = false;
             pData->options.preferUiBridges     = false;
             init("Carla-Patchbay");
-            pData->graph.create(false, pData->sampleRate, pData->bufferSize, inChan, outChan);
+            pData->graph.create(false, pData->sampleRate, pData->bufferSize, inChan, outChan, pData->options.processThreads);
         }
         else
         {
@@ -605,7 +605,7 @@ public:
             pData->options.preferPluginBridges = false;
             pData->options.preferUiBridges     = false;
             init("Carla-Rack");
-            pData->graph.create(true, pData->sampleRate, pData->bufferSize, 0, 0);
+            pData->graph.create(true, pData->sampleRate, pData->bufferSize, 0, 0, 0);
         }
 
         if (pData->options.resourceDir != nullptr)
@@ -1295,7 +1295,7 @@ protected:
         // ---------------------------------------------------------------
         // Do nothing if no plugins and rack mode
 
-        if (pData->curPluginCount == 0 && ! kIsPatchbay)
+        if ((pData->rtPluginList == nullptr || pData->rtPluginList->count == 0) && ! kIsPatchbay)
         {
             FloatVectorOperations::copy(outBuffer[0], inBuffer[0], static_cast<int>(frames));
             FloatVectorOperations::copy(outBuffer[1], inBuffer[1], static_cast<int>(frames));
@@ -1305,26 +1305,22 @@ protected:
         // ---------------------------------------------------------------
         // initialize events
 
-        carla_zeroStruct<EngineEvent>(pData->events.in,  kMaxEngineEventInternalCount);
-        carla_zeroStruct<EngineEvent>(pData->events.out, kMaxEngineEventInternalCount);
+        pData->events.in.clear();
+        pData->events.out.clear();
 
         // ---------------------------------------------------------------
         // events input (before processing)
 
+        for (uint32_t i=0; i < midiEventCount; ++i)
         {
-            uint32_t engineEventIndex = 0;
+            const NativeMidiEvent& midiEvent(midiEvents[i]);
+            EngineEvent* const     engineEvent(pData->events.in.append());
 
-            for (uint32_t i=0; i < midiEventCount && engineEventIndex < kMaxEngineEventInternalCount; ++i)
-            {
-                const NativeMidiEvent& midiEvent(midiEvents[i]);
-                EngineEvent&           engineEvent(pData->events.in[engineEventIndex++]);
-
-                engineEvent.time = midiEvent.time;
-                engineEvent.fillFromMidiData(midiEvent.size, midiEvent.data);
+            if (engineEvent == nullptr)
+                break;
 
-                if (engineEventIndex >= kMaxEngineEventInternalCount)
-                    break;
-            }
+            engineEvent->time = midiEvent.time;
+            engineEvent->fillFromMidiData(midiEvent.size, midiEvent.data);
         }
 
         if (kIsPatchbay)
@@ -1351,17 +1347,14 @@ protected:
         // ---------------------------------------------------------------
         // events output (after processing)
 
-        carla_zeroStruct<EngineEvent>(pData->events.in, kMaxEngineEventInternalCount);
+        pData->events.in.clear();
 
         {
             NativeMidiEvent midiEvent;
 
-            for (uint32_t i=0; i < kMaxEngineEventInternalCount; ++i)
+            for (uint32_t i=0; i < pData->events.out.count; ++i)
             {
-                const EngineEvent& engineEvent(pData->events.out[i]);
-
-                if (engineEvent.type == kEngineEventTypeNull)
-                    break;
+                const EngineEvent& engineEvent(pData->events.out.data[i]);
 
                 midiEvent.time = engineEvent.time;
 
@@ -2015,6 +2008,7 @@ const NativePluginDescriptor* carla_get_native_patchbay_plugin()
 CARLA_BACKEND_START_NAMESPACE
 
 CarlaEngine* CarlaEngine::newJack() { return nullptr; }
+CarlaEngine* CarlaEngine::newOffline() { return nullptr; }
 
 # if defined(CARLA_OS_MAC) || defined(CARLA_OS_WIN)
 CarlaEngine*       CarlaEngine::newJuce(const AudioApi)           { return nullptr; }
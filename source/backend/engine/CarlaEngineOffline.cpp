@@ -0,0 +1,351 @@
+/*
+ * Carla Plugin Host
+ * Copyright (C) 2011-2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "CarlaEngineGraph.hpp"
+#include "CarlaEngineInternal.hpp"
+#include "CarlaBackendUtils.hpp"
+
+#include "juce_audio_formats.h"
+
+using juce::AudioFormat;
+using juce::AudioFormatWriter;
+using juce::AudioSampleBuffer;
+using juce::File;
+using juce::FileOutputStream;
+using juce::FlacAudioFormat;
+using juce::ScopedPointer;
+using juce::StringPairArray;
+using juce::WavAudioFormat;
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -------------------------------------------------------------------------------------------------------------------
+
+// audio channels of the offline engine, fixed to stereo
+static const uint kOfflineChannelCount = 2;
+
+// send a progress callback every this many blocks
+static const uint kOfflineProgressInterval = 32;
+
+// -------------------------------------------------------------------------------------------------------------------
+// Offline Engine
+
+/*
+ * Engine driver without any audio device.
+ * Nothing is processed until 'renderToFile()' is called, which then pulls blocks as fast as the CPU allows.
+ */
+class CarlaEngineOffline : public CarlaEngine
+{
+public:
+    CarlaEngineOffline()
+        : CarlaEngine(),
+          fIsReady(false),
+          fRenderMutex(),
+          fAudioBufIn(),
+          fAudioBufOut(),
+          leakDetector_CarlaEngineOffline()
+    {
+        carla_debug("CarlaEngineOffline::CarlaEngineOffline()");
+
+        // we own the timeline
+        pData->options.transportMode = ENGINE_TRANSPORT_MODE_INTERNAL;
+    }
+
+    ~CarlaEngineOffline() override
+    {
+        CARLA_SAFE_ASSERT(! fIsReady);
+        carla_debug("CarlaEngineOffline::~CarlaEngineOffline()");
+    }
+
+    // -------------------------------------
+
+    bool init(const char* const clientName) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(! fIsReady, false);
+        CARLA_SAFE_ASSERT_RETURN(clientName != nullptr && clientName[0] != '\0', false);
+        carla_debug("CarlaEngineOffline::init(\"%s\")", clientName);
+
+        if (pData->options.processMode != ENGINE_PROCESS_MODE_CONTINUOUS_RACK && pData->options.processMode != ENGINE_PROCESS_MODE_PATCHBAY)
+        {
+            setLastError("Invalid process mode");
+            return false;
+        }
+
+        if (pData->options.audioBufferSize == 0 || pData->options.audioSampleRate == 0)
+        {
+            setLastError("Invalid buffer size or sample rate");
+            return false;
+        }
+
+        // the engine thread checks isRunning() as soon as it starts
+        fIsReady = true;
+
+        if (! pData->init(clientName))
+        {
+            close();
+            setLastError("Failed to init internal data");
+            return false;
+        }
+
+        pData->bufferSize = pData->options.audioBufferSize;
+        pData->sampleRate = pData->options.audioSampleRate;
+
+        fAudioBufIn.setSize(static_cast<int>(kOfflineChannelCount), static_cast<int>(pData->bufferSize));
+        fAudioBufOut.setSize(static_cast<int>(kOfflineChannelCount), static_cast<int>(pData->bufferSize));
+        fAudioBufIn.clear();
+
+        pData->graph.create(pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK, pData->sampleRate, pData->bufferSize, kOfflineChannelCount, kOfflineChannelCount, pData->options.processThreads);
+        pData->graph.setOffline(true);
+
+        patchbayRefresh(false);
+
+        callback(ENGINE_CALLBACK_ENGINE_STARTED, 0, pData->options.processMode, pData->options.transportMode, 0.0f, getCurrentDriverName());
+        return true;
+    }
+
+    bool close() override
+    {
+        carla_debug("CarlaEngineOffline::close()");
+
+        // wait for any pending render to finish
+        {
+            const CarlaMutexLocker cml(fRenderMutex);
+            fIsReady = false;
+        }
+
+        // clear engine data
+        CarlaEngine::close();
+
+        pData->graph.destroy();
+
+        fAudioBufIn.setSize(0, 0);
+        fAudioBufOut.setSize(0, 0);
+
+        return true;
+    }
+
+    void idle() noexcept override
+    {
+        // adopt the latest plugin list while not rendering, so removed plugins can be deleted
+        if (fRenderMutex.tryLock())
+        {
+            pData->updateRtPluginList();
+            fRenderMutex.unlock();
+        }
+
+        CarlaEngine::idle();
+    }
+
+    bool isRunning() const noexcept override
+    {
+        return fIsReady;
+    }
+
+    bool isOffline() const noexcept override
+    {
+        return true;
+    }
+
+    EngineType getType() const noexcept override
+    {
+        return kEngineTypeOffline;
+    }
+
+    const char* getCurrentDriverName() const noexcept override
+    {
+        return "Offline";
+    }
+
+    // -------------------------------------------------------------------
+    // Patchbay
+
+    bool patchbayRefresh(const bool /*external*/) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(pData->graph.isReady(), false);
+
+        if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
+        {
+            PatchbayGraph* const graph(pData->graph.getPatchbayGraph());
+            CARLA_SAFE_ASSERT_RETURN(graph != nullptr, false);
+
+            graph->refreshConnections(this);
+        }
+
+        // rack mode always renders the rack output directly, no connections to show
+
+        return true;
+    }
+
+    // -------------------------------------------------------------------
+    // Offline rendering
+
+    bool renderToFile(const char* const filename, const uint64_t startFrame, const uint64_t endFrame) override
+    {
+        CARLA_SAFE_ASSERT_RETURN_ERR(filename != nullptr && filename[0] != '\0', "Invalid filename");
+        CARLA_SAFE_ASSERT_RETURN_ERR(endFrame > startFrame, "Invalid frame range");
+        CARLA_SAFE_ASSERT_RETURN_ERR(pData->isIdling == 0, "An operation is still being processed, please wait for it to finish");
+        carla_debug("CarlaEngineOffline::renderToFile(\"%s\", " P_UINT64 ", " P_UINT64 ")", filename, startFrame, endFrame);
+
+        const CarlaMutexLocker cml(fRenderMutex);
+
+        if (! fIsReady)
+        {
+            setLastError("Engine is not running");
+            return false;
+        }
+
+        const File file(filename);
+
+        WavAudioFormat  wavFormat;
+        FlacAudioFormat flacFormat;
+        AudioFormat* format;
+
+        if (file.hasFileExtension(wavFormat.getFileExtensions().joinIntoString(";")))
+            format = &wavFormat;
+        else if (file.hasFileExtension(flacFormat.getFileExtensions().joinIntoString(";")))
+            format = &flacFormat;
+        else
+        {
+            setLastError("Unsupported file format, use WAV or FLAC");
+            return false;
+        }
+
+        file.deleteFile();
+
+        ScopedPointer<FileOutputStream> outStream(file.createOutputStream());
+
+        if (outStream == nullptr)
+        {
+            setLastError("Failed to create output file");
+            return false;
+        }
+
+        ScopedPointer<AudioFormatWriter> writer(format->createWriterFor(outStream, pData->sampleRate, kOfflineChannelCount, 24, StringPairArray(), 0));
+
+        if (writer == nullptr)
+        {
+            setLastError("Failed to create audio file writer");
+            return false;
+        }
+
+        // writer owns the stream now
+        outStream.release();
+
+        const bool     wasPlaying(pData->time.playing);
+        const uint64_t oldFrame(pData->time.frame);
+        const uint64_t totalFrames(endFrame - startFrame);
+        const uint32_t bufferSize(pData->bufferSize);
+
+        pData->time.playing = true;
+        pData->time.frame   = startFrame;
+
+        // progress frames are sent as int, very long renders report them in units of 2^progressShift frames
+        uint progressShift = 0;
+
+        for (; (totalFrames >> progressShift) > static_cast<uint64_t>(std::numeric_limits<int>::max()); ++progressShift) {}
+
+        bool ok = true;
+        uint blockCount = 0;
+
+        for (uint64_t framesDone = 0; framesDone < totalFrames; ++blockCount)
+        {
+            const uint64_t framesLeft(totalFrames - framesDone);
+            const uint32_t framesToWrite(framesLeft < bufferSize ? static_cast<uint32_t>(framesLeft) : bufferSize);
+
+            processBlock();
+
+            if (! writer->writeFromFloatArrays(fAudioBufOut.getArrayOfReadPointers(), static_cast<int>(kOfflineChannelCount), static_cast<int>(framesToWrite)))
+            {
+                setLastError("Failed to write to audio file");
+                ok = false;
+                break;
+            }
+
+            framesDone += framesToWrite;
+
+            if (blockCount % kOfflineProgressInterval == 0 || framesDone == totalFrames)
+                callback(ENGINE_CALLBACK_RENDER_PROGRESS, 0,
+                         static_cast<int>(framesDone >> progressShift), static_cast<int>(totalFrames >> progressShift),
+                         static_cast<float>(static_cast<double>(framesDone)/static_cast<double>(totalFrames)), nullptr);
+        }
+
+        writer = nullptr;
+
+        pData->time.playing     = wasPlaying;
+        pData->time.frame       = oldFrame;
+        pData->timeInfo.playing = wasPlaying;
+        pData->timeInfo.frame   = oldFrame;
+        pData->timeInfo.usecs   = 0;
+
+        return ok;
+    }
+
+    // -------------------------------------------------------------------
+
+private:
+    bool fIsReady;
+
+    // locked while rendering
+    CarlaMutex fRenderMutex;
+
+    AudioSampleBuffer fAudioBufIn;
+    AudioSampleBuffer fAudioBufOut;
+
+    // process a single block into fAudioBufOut, must be called with fRenderMutex locked
+    void processBlock()
+    {
+        // set time for this block, the runner below advances it afterwards
+        pData->timeInfo.playing = pData->time.playing;
+        pData->timeInfo.frame   = pData->time.frame;
+        pData->timeInfo.usecs   = static_cast<uint64_t>(static_cast<double>(pData->time.frame) / pData->sampleRate * 1000000.0);
+
+        const PendingRtEventsRunner prt(this);
+
+        const float* inBuf[kOfflineChannelCount];
+        /* */ float* outBuf[kOfflineChannelCount];
+
+        for (uint i=0; i < kOfflineChannelCount; ++i)
+        {
+            inBuf[i]  = fAudioBufIn.getReadPointer(static_cast<int>(i));
+            outBuf[i] = fAudioBufOut.getWritePointer(static_cast<int>(i));
+        }
+
+        fAudioBufOut.clear();
+
+        // initialize events
+        pData->events.in.clear();
+        pData->events.out.clear();
+
+        if (pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK)
+            pData->graph.processRack(pData, inBuf, outBuf, pData->bufferSize);
+        else
+            pData->graph.process(pData, inBuf, outBuf, pData->bufferSize);
+    }
+
+    CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CarlaEngineOffline)
+};
+
+// -----------------------------------------
+
+CarlaEngine* CarlaEngine::newOffline()
+{
+    return new CarlaEngineOffline();
+}
+
+// -----------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
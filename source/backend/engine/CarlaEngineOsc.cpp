@@ -351,7 +351,10 @@ int CarlaEngineOsc::handleMsgRegister(const bool isTCP, const int argc, const lo
         CarlaPlugin* const plugin(fEngine->getPluginUnchecked(i));
 
         if (plugin != nullptr && plugin->isEnabled())
+        {
             plugin->registerToOscClient();
+            plugin->refreshParameterOutputs();
+        }
     }
 
     return 0;
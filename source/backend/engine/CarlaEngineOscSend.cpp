@@ -388,6 +388,23 @@ void CarlaEngine::oscSend_control_set_peaks(const uint pluginId) const noexcept
     try_lo_send(pData->oscData->target, targetPath, "iffff", static_cast<int32_t>(pluginId), epData.insPeak[0], epData.insPeak[1], epData.outsPeak[0], epData.outsPeak[1]);
 }
 
+void CarlaEngine::oscSend_control_set_dsp_load(const uint pluginId) const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(pData->oscData != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(pData->oscData->path != nullptr && pData->oscData->path[0] != '\0',);
+    CARLA_SAFE_ASSERT_RETURN(pData->oscData->target != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(pluginId < pData->curPluginCount,);
+
+    EngineDspLoad load;
+    pData->plugins[pluginId].dspLoad.get(load);
+
+    char targetPath[std::strlen(pData->oscData->path)+14];
+    std::strcpy(targetPath, pData->oscData->path);
+    std::strcat(targetPath, "/set_dsp_load");
+    try_lo_send(pData->oscData->target, targetPath, "iffffffii", static_cast<int32_t>(pluginId), load.current, load.average, load.minimum, load.maximum,
+                load.percentile95, load.percentile99, static_cast<int32_t>(load.xruns), static_cast<int32_t>(load.cycles));
+}
+
 void CarlaEngine::oscSend_control_exit() const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->oscData != nullptr,);
@@ -90,7 +90,10 @@ CarlaEngineEventPort::CarlaEngineEventPort(const CarlaEngineClient& client, cons
     carla_debug("CarlaEngineEventPort::CarlaEngineEventPort(%s)", bool2str(isInputPort));
 
     if (kProcessMode == ENGINE_PROCESS_MODE_PATCHBAY)
-        fBuffer = new EngineEvent[kMaxEngineEventInternalCount];
+    {
+        fBuffer = new EngineEventBuffer();
+        fBuffer->alloc();
+    }
 }
 
 CarlaEngineEventPort::~CarlaEngineEventPort() noexcept
@@ -101,7 +104,7 @@ CarlaEngineEventPort::~CarlaEngineEventPort() noexcept
     {
         CARLA_SAFE_ASSERT_RETURN(fBuffer != nullptr,);
 
-        delete[] fBuffer;
+        delete fBuffer;
         fBuffer = nullptr;
     }
 }
@@ -110,8 +113,8 @@ void CarlaEngineEventPort::initBuffer() noexcept
 {
     if (kProcessMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK || kProcessMode == ENGINE_PROCESS_MODE_BRIDGE)
         fBuffer = kClient.getEngine().getInternalEventBuffer(kIsInput);
-    else if (kProcessMode == ENGINE_PROCESS_MODE_PATCHBAY && ! kIsInput)
-        carla_zeroStruct<EngineEvent>(fBuffer, kMaxEngineEventInternalCount);
+    else if (kProcessMode == ENGINE_PROCESS_MODE_PATCHBAY && ! kIsInput && fBuffer->isAllocated())
+        fBuffer->clear();
 }
 
 uint32_t CarlaEngineEventPort::getEventCount() const noexcept
@@ -120,15 +123,7 @@ uint32_t CarlaEngineEventPort::getEventCount() const noexcept
     CARLA_SAFE_ASSERT_RETURN(fBuffer != nullptr, 0);
     CARLA_SAFE_ASSERT_RETURN(kProcessMode != ENGINE_PROCESS_MODE_SINGLE_CLIENT && kProcessMode != ENGINE_PROCESS_MODE_MULTIPLE_CLIENTS, 0);
 
-    uint32_t i=0;
-
-    for (; i < kMaxEngineEventInternalCount; ++i)
-    {
-        if (fBuffer[i].type == kEngineEventTypeNull)
-            break;
-    }
-
-    return i;
+    return fBuffer->count;
 }
 
 const EngineEvent& CarlaEngineEventPort::getEvent(const uint32_t index) const noexcept
@@ -136,14 +131,14 @@ const EngineEvent& CarlaEngineEventPort::getEvent(const uint32_t index) const no
     CARLA_SAFE_ASSERT_RETURN(kIsInput, kFallbackEngineEvent);
     CARLA_SAFE_ASSERT_RETURN(fBuffer != nullptr, kFallbackEngineEvent);
     CARLA_SAFE_ASSERT_RETURN(kProcessMode != ENGINE_PROCESS_MODE_SINGLE_CLIENT && kProcessMode != ENGINE_PROCESS_MODE_MULTIPLE_CLIENTS, kFallbackEngineEvent);
-    CARLA_SAFE_ASSERT_RETURN(index < kMaxEngineEventInternalCount, kFallbackEngineEvent);
+    CARLA_SAFE_ASSERT_RETURN(index < fBuffer->count, kFallbackEngineEvent);
 
-    return fBuffer[index];
+    return fBuffer->data[index];
 }
 
 const EngineEvent& CarlaEngineEventPort::getEventUnchecked(const uint32_t index) const noexcept
 {
-    return fBuffer[index];
+    return fBuffer->data[index];
 }
 
 bool CarlaEngineEventPort::writeControlEvent(const uint32_t time, const uint8_t channel, const EngineControlEvent& ctrl) noexcept
@@ -164,26 +159,23 @@ bool CarlaEngineEventPort::writeControlEvent(const uint32_t time, const uint8_t
         CARLA_SAFE_ASSERT(! MIDI_IS_CONTROL_BANK_SELECT(param));
     }
 
-    for (uint32_t i=0; i < kMaxEngineEventInternalCount; ++i)
-    {
-        EngineEvent& event(fBuffer[i]);
-
-        if (event.type != kEngineEventTypeNull)
-            continue;
+    EngineEvent* const event(fBuffer->append());
 
-        event.type    = kEngineEventTypeControl;
-        event.time    = time;
-        event.channel = channel;
+    if (event == nullptr)
+    {
+        carla_stderr2("CarlaEngineEventPort::writeControlEvent() - buffer full");
+        return false;
+    }
 
-        event.ctrl.type  = type;
-        event.ctrl.param = param;
-        event.ctrl.value = carla_fixValue<float>(0.0f, 1.0f, value);
+    event->type    = kEngineEventTypeControl;
+    event->time    = time;
+    event->channel = channel;
 
-        return true;
-    }
+    event->ctrl.type  = type;
+    event->ctrl.param = param;
+    event->ctrl.value = carla_fixValue<float>(0.0f, 1.0f, value);
 
-    carla_stderr2("CarlaEngineEventPort::writeControlEvent() - buffer full");
-    return false;
+    return true;
 }
 
 bool CarlaEngineEventPort::writeMidiEvent(const uint32_t time, const uint8_t size, const uint8_t* const data) noexcept
@@ -205,33 +197,28 @@ bool CarlaEngineEventPort::writeMidiEvent(const uint32_t time, const uint8_t cha
     CARLA_SAFE_ASSERT_RETURN(size > 0 && size <= EngineMidiEvent::kDataSize, false);
     CARLA_SAFE_ASSERT_RETURN(data != nullptr, false);
 
-    for (uint32_t i=0; i < kMaxEngineEventInternalCount; ++i)
-    {
-        EngineEvent& event(fBuffer[i]);
-
-        if (event.type != kEngineEventTypeNull)
-            continue;
+    EngineEvent* const event(fBuffer->append());
 
-        event.type    = kEngineEventTypeMidi;
-        event.time    = time;
-        event.channel = channel;
+    if (event == nullptr)
+    {
+        carla_stderr2("CarlaEngineEventPort::writeMidiEvent() - buffer full");
+        return false;
+    }
 
-        event.midi.port = port;
-        event.midi.size = size;
+    event->type    = kEngineEventTypeMidi;
+    event->time    = time;
+    event->channel = channel;
 
-        event.midi.data[0] = uint8_t(MIDI_GET_STATUS_FROM_DATA(data));
+    event->midi.port = port;
+    event->midi.size = size;
 
-        uint8_t j=1;
-        for (; j < size; ++j)
-            event.midi.data[j] = data[j];
-        for (; j < EngineMidiEvent::kDataSize; ++j)
-            event.midi.data[j] = 0;
+    event->midi.data[0] = uint8_t(MIDI_GET_STATUS_FROM_DATA(data));
 
-        return true;
-    }
+    // remaining data bytes are already zero
+    for (uint8_t j=1; j < size; ++j)
+        event->midi.data[j] = data[j];
 
-    carla_stderr2("CarlaEngineEventPort::writeMidiEvent() - buffer full");
-    return false;
+    return true;
 }
 
 // -----------------------------------------------------------------------
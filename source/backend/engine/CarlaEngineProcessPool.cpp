@@ -0,0 +1,699 @@
+/*
+ * Carla Plugin Host
+ * Copyright (C) 2011-2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "CarlaEngineProcessPool.hpp"
+#include "CarlaMathUtils.hpp"
+#include "CarlaSemUtils.hpp"
+
+#ifdef __SSE2_MATH__
+# include <xmmintrin.h>
+#endif
+
+using juce::Atomic;
+using juce::Time;
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+static const uint kNoNode = static_cast<uint>(-1);
+
+// added to the cycle gate while no cycle is running, workers waking up late see it and stay out
+static const int kCycleClosed = 1 << 30;
+
+// how long to busy-wait for workers leaving a cycle before yielding to them
+static const uint kMaxCycleSpins = 1000;
+
+static inline
+void carla_cpu_relax() noexcept
+{
+#if defined(__SSE2__)
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__("pause");
+#endif
+}
+
+// -----------------------------------------------------------------------
+// EngineProcessGraph
+
+EngineProcessGraph::EngineProcessGraph(const uint nodeCount, const uint* const edgeSources, const uint* const edgeTargets, const uint edgeCount)
+    : fIsValid(false),
+      fNodeCount(nodeCount),
+      fIndegree(nullptr),
+      fSuccStart(nullptr),
+      fSucc(nullptr),
+      fOrder(nullptr),
+      fCritPred(nullptr),
+      fPending(nullptr),
+      fTimings(nullptr),
+      fCriticalPathUsecs(0.0f)
+{
+    CARLA_SAFE_ASSERT_RETURN(edgeCount == 0 || (edgeSources != nullptr && edgeTargets != nullptr),);
+
+    try {
+        fIndegree  = new uint[nodeCount+1];
+        fSuccStart = new uint[nodeCount+1];
+        fSucc      = new uint[edgeCount+1];
+        fOrder     = new uint[nodeCount+1];
+        fCritPred  = new uint[nodeCount+1];
+        fPending   = new Atomic<int>[nodeCount+1];
+        fTimings   = new EngineProcessNodeTiming[nodeCount+1];
+    } CARLA_SAFE_EXCEPTION_RETURN("EngineProcessGraph allocation",);
+
+    carla_zeroStruct<uint>(fIndegree,  nodeCount+1);
+    carla_zeroStruct<uint>(fSuccStart, nodeCount+1);
+
+    // count successors and inputs
+    for (uint i=0; i < edgeCount; ++i)
+    {
+        CARLA_SAFE_ASSERT_RETURN(edgeSources[i] < nodeCount,);
+        CARLA_SAFE_ASSERT_RETURN(edgeTargets[i] < nodeCount,);
+
+        ++fSuccStart[edgeSources[i]+1];
+        ++fIndegree[edgeTargets[i]];
+    }
+
+    for (uint i=0; i < nodeCount; ++i)
+        fSuccStart[i+1] += fSuccStart[i];
+
+    // fill successors, using fOrder as temporary write position
+    for (uint i=0; i < nodeCount; ++i)
+        fOrder[i] = fSuccStart[i];
+
+    for (uint i=0; i < edgeCount; ++i)
+        fSucc[fOrder[edgeSources[i]]++] = edgeTargets[i];
+
+    // topological sort, using fCritPred as temporary input counter
+    uint orderCount = 0;
+
+    for (uint i=0; i < nodeCount; ++i)
+    {
+        fCritPred[i] = fIndegree[i];
+
+        if (fIndegree[i] == 0)
+            fOrder[orderCount++] = i;
+    }
+
+    for (uint i=0; i < orderCount; ++i)
+    {
+        const uint node(fOrder[i]);
+
+        for (uint j=fSuccStart[node]; j < fSuccStart[node+1]; ++j)
+        {
+            if (--fCritPred[fSucc[j]] == 0)
+                fOrder[orderCount++] = fSucc[j];
+        }
+    }
+
+    // not all nodes were reached, we have a feedback loop
+    if (orderCount != nodeCount)
+        return;
+
+    for (uint i=0; i < nodeCount; ++i)
+        fCritPred[i] = kNoNode;
+
+    fIsValid = true;
+}
+
+EngineProcessGraph::~EngineProcessGraph()
+{
+    delete[] fIndegree;
+    delete[] fSuccStart;
+    delete[] fSucc;
+    delete[] fOrder;
+    delete[] fCritPred;
+    delete[] fPending;
+    delete[] fTimings;
+}
+
+bool EngineProcessGraph::isValid() const noexcept
+{
+    return fIsValid;
+}
+
+uint EngineProcessGraph::getNodeCount() const noexcept
+{
+    return fNodeCount;
+}
+
+const EngineProcessNodeTiming& EngineProcessGraph::getNodeTiming(const uint index) const noexcept
+{
+    static const EngineProcessNodeTiming kFallbackTiming;
+
+    CARLA_SAFE_ASSERT_RETURN(fIsValid, kFallbackTiming);
+    CARLA_SAFE_ASSERT_RETURN(index < fNodeCount, kFallbackTiming);
+
+    return fTimings[index];
+}
+
+float EngineProcessGraph::getCriticalPathUsecs() const noexcept
+{
+    return fCriticalPathUsecs;
+}
+
+void EngineProcessGraph::updateCriticalPath() noexcept
+{
+    // longest path through the graph, weighted by the average node times
+    float maxPath = 0.0f;
+    uint  maxNode = kNoNode;
+
+    for (uint i=0; i < fNodeCount; ++i)
+        fCritPred[i] = kNoNode;
+
+    for (uint i=0; i < fNodeCount; ++i)
+    {
+        const uint node(fOrder[i]);
+
+        float start = 0.0f;
+
+        if (fCritPred[node] != kNoNode)
+            start = fTimings[fCritPred[node]].pathUsecs;
+
+        const float path(start + fTimings[node].avgUsecs);
+
+        fTimings[node].pathUsecs = path;
+        fTimings[node].critical  = false;
+
+        if (path >= maxPath)
+        {
+            maxPath = path;
+            maxNode = node;
+        }
+
+        for (uint j=fSuccStart[node]; j < fSuccStart[node+1]; ++j)
+        {
+            const uint succ(fSucc[j]);
+
+            if (fCritPred[succ] == kNoNode || fTimings[fCritPred[succ]].pathUsecs < path)
+                fCritPred[succ] = node;
+        }
+    }
+
+    for (uint node = maxNode; node != kNoNode; node = fCritPred[node])
+        fTimings[node].critical = true;
+
+    fCriticalPathUsecs = maxPath;
+}
+
+// -----------------------------------------------------------------------
+// EngineProcessPool::Queue
+
+/*
+ * Work-stealing queue, owner pushes and pops at the bottom, others steal from the top.
+ * Queues are reset at the start of each cycle, and each node is pushed only once per cycle,
+ * so a plain array of 'maxNodes' size is enough and no wrap-around is needed.
+ */
+struct EngineProcessPool::Queue {
+    Atomic<int> top;
+    Atomic<int> bottom;
+    uint* items;
+
+    Queue() noexcept
+        : top(0),
+          bottom(0),
+          items(nullptr) {}
+
+    ~Queue()
+    {
+        delete[] items;
+    }
+
+    void reset() noexcept
+    {
+        top    = 0;
+        bottom = 0;
+    }
+
+    void push(const uint node) noexcept
+    {
+        const int b(bottom.get());
+        items[b] = node;
+        bottom = b+1;
+    }
+
+    int pop() noexcept
+    {
+        const int b(bottom.get()-1);
+        bottom = b;
+
+        const int t(top.get());
+
+        if (t > b)
+        {
+            bottom = b+1;
+            return -1;
+        }
+
+        int node = static_cast<int>(items[b]);
+
+        if (t == b)
+        {
+            // last item, race against stealers
+            if (! top.compareAndSetBool(t+1, t))
+                node = -1;
+            bottom = b+1;
+        }
+
+        return node;
+    }
+
+    int steal() noexcept
+    {
+        const int t(top.get());
+        const int b(bottom.get());
+
+        if (t >= b)
+            return -1;
+
+        const int node(static_cast<int>(items[t]));
+
+        if (! top.compareAndSetBool(t+1, t))
+            return -1;
+
+        return node;
+    }
+
+    CARLA_DECLARE_NON_COPY_STRUCT(Queue)
+};
+
+// -----------------------------------------------------------------------
+// EngineProcessPool::Worker
+
+class EngineProcessPool::Worker : public CarlaThread
+{
+public:
+    Worker(EngineProcessPool* const pool, const uint index) noexcept
+        : CarlaThread("CarlaEngineWorker"),
+          kPool(pool),
+          kIndex(index),
+          fSem(carla_sem_create()),
+          fSchedApplied(false) {}
+
+    ~Worker() override
+    {
+        if (fSem != nullptr)
+            carla_sem_destroy(fSem);
+    }
+
+    bool isReady() const noexcept
+    {
+        return fSem != nullptr && isThreadRunning();
+    }
+
+    void wakeUp() noexcept
+    {
+        carla_sem_post(fSem);
+    }
+
+    void stop() noexcept
+    {
+        signalThreadShouldExit();
+        wakeUp();
+        stopThread(2000);
+    }
+
+protected:
+    void run() noexcept override
+    {
+#ifdef __SSE2_MATH__
+        // Set FTZ and DAZ flags
+        _mm_setcsr(_mm_getcsr() | 0x8040);
+#endif
+
+        for (; ! shouldThreadExit();)
+        {
+            if (! carla_sem_timedwait(fSem, 1))
+                continue;
+            if (shouldThreadExit())
+                break;
+
+            if (! fSchedApplied && kPool->fSchedCaptured)
+            {
+                fSchedApplied = true;
+
+                if (kPool->fSchedPolicy != SCHED_OTHER)
+                {
+                    sched_param param;
+                    carla_zeroStruct(param);
+                    param.sched_priority = kPool->fSchedPriority;
+
+                    if (pthread_setschedparam(pthread_self(), kPool->fSchedPolicy, &param) != 0)
+                        carla_stderr("EngineProcessPool::Worker - failed to set realtime priority");
+                }
+            }
+
+            // the audio thread might have finished this cycle without us
+            if (! kPool->enterCycle())
+                continue;
+
+            kPool->runCycle(kIndex);
+            kPool->leaveCycle();
+        }
+    }
+
+private:
+    EngineProcessPool* const kPool;
+    const uint kIndex;
+
+    sem_t* fSem;
+    bool fSchedApplied;
+
+    CARLA_DECLARE_NON_COPY_CLASS(Worker)
+};
+
+// -----------------------------------------------------------------------
+// EngineProcessTimings
+
+struct EngineProcessTimings::Entry {
+    Atomic<uint>  nodeId;
+    Atomic<float> lastUsecs;
+    Atomic<float> avgUsecs;
+    Atomic<float> maxUsecs;
+    Atomic<float> pathUsecs;
+    Atomic<int>   critical;
+};
+
+EngineProcessTimings::EngineProcessTimings(const uint maxNodes)
+    : kMaxNodes(maxNodes),
+      fEntries(nullptr),
+      fSerial(0),
+      fNodeCount(0),
+      fCriticalPathUsecs(0.0f)
+{
+    fEntries = new Entry[maxNodes+1];
+}
+
+EngineProcessTimings::~EngineProcessTimings()
+{
+    delete[] fEntries;
+}
+
+void EngineProcessTimings::publish(const EngineProcessGraph& graph, const uint* const nodeIds) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(nodeIds != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(graph.fIsValid,);
+
+    const uint nodeCount(graph.fNodeCount < kMaxNodes ? graph.fNodeCount : kMaxNodes);
+
+    ++fSerial;
+
+    for (uint i=0; i < nodeCount; ++i)
+    {
+        const EngineProcessNodeTiming& timing(graph.fTimings[i]);
+        Entry& entry(fEntries[i]);
+
+        entry.nodeId    = nodeIds[i];
+        entry.lastUsecs = timing.lastUsecs;
+        entry.avgUsecs  = timing.avgUsecs;
+        entry.maxUsecs  = timing.maxUsecs;
+        entry.pathUsecs = timing.pathUsecs;
+        entry.critical  = timing.critical ? 1 : 0;
+    }
+
+    fNodeCount = static_cast<int>(nodeCount);
+    fCriticalPathUsecs = graph.fCriticalPathUsecs;
+
+    ++fSerial;
+}
+
+void EngineProcessTimings::clear() noexcept
+{
+    ++fSerial;
+    fNodeCount = 0;
+    fCriticalPathUsecs = 0.0f;
+    ++fSerial;
+}
+
+bool EngineProcessTimings::get(const uint nodeId, EngineProcessNodeTiming& timing, float& criticalPathUsecs) const noexcept
+{
+    for (int tries=0; tries < 16; ++tries)
+    {
+        const int serial(fSerial.get());
+
+        if (serial & 1)
+        {
+            carla_cpu_relax();
+            continue;
+        }
+
+        bool found = false;
+
+        for (int i=0, count=fNodeCount.get(); i < count; ++i)
+        {
+            const Entry& entry(fEntries[i]);
+
+            if (entry.nodeId.get() != nodeId)
+                continue;
+
+            timing.lastUsecs = entry.lastUsecs.get();
+            timing.avgUsecs  = entry.avgUsecs.get();
+            timing.maxUsecs  = entry.maxUsecs.get();
+            timing.pathUsecs = entry.pathUsecs.get();
+            timing.critical  = entry.critical.get() != 0;
+            criticalPathUsecs = fCriticalPathUsecs.get();
+            found = true;
+            break;
+        }
+
+        if (fSerial.get() == serial)
+            return found;
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------
+// EngineProcessPool
+
+EngineProcessPool::EngineProcessPool(const uint numThreads, const uint maxNodes)
+    : kNumThreads(carla_fixValue(1U, 64U, numThreads)),
+      kMaxNodes(maxNodes),
+      fQueues(nullptr),
+      fWorkers(nullptr),
+      fGraph(nullptr),
+      fCallback(nullptr),
+      fRemaining(0),
+      fCycleGate(kCycleClosed),
+      fSchedCaptured(false),
+      fSchedPolicy(SCHED_OTHER),
+      fSchedPriority(0)
+{
+    carla_debug("EngineProcessPool::EngineProcessPool(%u, %u)", numThreads, maxNodes);
+
+    fQueues = new Queue[kNumThreads];
+
+    for (uint i=0; i < kNumThreads; ++i)
+        fQueues[i].items = new uint[kMaxNodes+1];
+
+    fWorkers = new Worker*[kNumThreads];
+
+    for (uint i=1; i < kNumThreads; ++i)
+    {
+        fWorkers[i] = new Worker(this, i);
+        fWorkers[i]->startThread();
+    }
+
+    fWorkers[0] = nullptr;
+}
+
+EngineProcessPool::~EngineProcessPool()
+{
+    carla_debug("EngineProcessPool::~EngineProcessPool()");
+
+    for (uint i=1; i < kNumThreads; ++i)
+    {
+        fWorkers[i]->stop();
+        delete fWorkers[i];
+    }
+
+    delete[] fWorkers;
+    delete[] fQueues;
+}
+
+uint EngineProcessPool::getThreadCount() const noexcept
+{
+    return kNumThreads;
+}
+
+uint EngineProcessPool::getMaxNodes() const noexcept
+{
+    return kMaxNodes;
+}
+
+void EngineProcessPool::process(EngineProcessGraph& graph, EngineProcessGraph::Callback* const callback) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(graph.fIsValid,);
+    CARLA_SAFE_ASSERT_RETURN(graph.fNodeCount <= kMaxNodes,);
+    CARLA_SAFE_ASSERT_RETURN(callback != nullptr,);
+
+    if (graph.fNodeCount == 0)
+        return;
+
+    if (! fSchedCaptured)
+    {
+        sched_param param;
+        carla_zeroStruct(param);
+
+        if (pthread_getschedparam(pthread_self(), &fSchedPolicy, &param) == 0)
+            fSchedPriority = param.sched_priority;
+        else
+            fSchedPolicy = SCHED_OTHER;
+
+        fSchedCaptured = true;
+    }
+
+    fGraph    = &graph;
+    fCallback = callback;
+
+    // all workers are idle at this point, so we can touch their queues
+    for (uint i=0; i < kNumThreads; ++i)
+        fQueues[i].reset();
+
+    for (uint i=0, q=0; i < graph.fNodeCount; ++i)
+    {
+        graph.fPending[i] = static_cast<int>(graph.fIndegree[i]);
+
+        if (graph.fIndegree[i] != 0)
+            continue;
+
+        fQueues[q].push(i);
+
+        if (++q == kNumThreads)
+            q = 0;
+    }
+
+    fRemaining = static_cast<int>(graph.fNodeCount);
+
+    // open the cycle, a subtraction keeps the count of late workers that are just backing out
+    fCycleGate -= kCycleClosed;
+
+    for (uint i=1; i < kNumThreads; ++i)
+    {
+        if (fWorkers[i]->isReady())
+            fWorkers[i]->wakeUp();
+    }
+
+    // we pick up any node nobody else took, so this does not depend on workers waking up in time
+    runCycle(0);
+
+    // close the cycle, and only wait for the workers still inside it
+    // all nodes are done now, so those are only leaving runCycle()
+    fCycleGate += kCycleClosed;
+
+    for (uint spins=0; fCycleGate.get() != kCycleClosed; ++spins)
+    {
+        // one of them got preempted, let it run
+        if (spins >= kMaxCycleSpins)
+            juce::Thread::yield();
+        else
+            carla_cpu_relax();
+    }
+
+    graph.updateCriticalPath();
+
+    fGraph    = nullptr;
+    fCallback = nullptr;
+}
+
+bool EngineProcessPool::enterCycle() noexcept
+{
+    if (++fCycleGate < kCycleClosed)
+        return true;
+
+    --fCycleGate;
+    return false;
+}
+
+void EngineProcessPool::leaveCycle() noexcept
+{
+    --fCycleGate;
+}
+
+void EngineProcessPool::runCycle(const uint threadIndex) noexcept
+{
+    Queue& queue(fQueues[threadIndex]);
+
+    for (;;)
+    {
+        int node = queue.pop();
+
+        if (node < 0)
+            node = stealNode(threadIndex);
+
+        if (node >= 0)
+        {
+            runNode(threadIndex, static_cast<uint>(node));
+            continue;
+        }
+
+        if (fRemaining.get() <= 0)
+            break;
+
+        carla_cpu_relax();
+    }
+}
+
+void EngineProcessPool::runNode(const uint threadIndex, const uint node) noexcept
+{
+    EngineProcessGraph& graph(*fGraph);
+
+    const juce::int64 startTicks(Time::getHighResolutionTicks());
+
+    try {
+        fCallback->processGraphNode(node);
+    } CARLA_SAFE_EXCEPTION("EngineProcessPool processGraphNode");
+
+    const float usecs(static_cast<float>(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()-startTicks)*1000000.0));
+
+    EngineProcessNodeTiming& timing(graph.fTimings[node]);
+    timing.lastUsecs = usecs;
+    timing.avgUsecs  = (timing.avgUsecs > 0.0f) ? timing.avgUsecs + (usecs - timing.avgUsecs) * 0.1f : usecs;
+
+    if (usecs > timing.maxUsecs)
+        timing.maxUsecs = usecs;
+
+    // queue successors that have all their inputs ready, before marking this node as done
+    Queue& queue(fQueues[threadIndex]);
+
+    for (uint i=graph.fSuccStart[node]; i < graph.fSuccStart[node+1]; ++i)
+    {
+        const uint succ(graph.fSucc[i]);
+
+        if (--graph.fPending[succ] == 0)
+            queue.push(succ);
+    }
+
+    --fRemaining;
+}
+
+int EngineProcessPool::stealNode(const uint threadIndex) noexcept
+{
+    for (uint i=1; i < kNumThreads; ++i)
+    {
+        const int node(fQueues[(threadIndex+i) % kNumThreads].steal());
+
+        if (node >= 0)
+            return node;
+    }
+
+    return -1;
+}
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
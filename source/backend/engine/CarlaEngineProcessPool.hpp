@@ -0,0 +1,167 @@
+/*
+ * Carla Plugin Host
+ * Copyright (C) 2011-2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#ifndef CARLA_ENGINE_PROCESS_POOL_HPP_INCLUDED
+#define CARLA_ENGINE_PROCESS_POOL_HPP_INCLUDED
+
+#include "CarlaEngine.hpp"
+#include "CarlaThread.hpp"
+
+#include "juce_core.h"
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+// EngineProcessGraph
+
+/*
+ * Immutable node dependency list used by EngineProcessPool.
+ * Nodes are plain indexes, each edge says 'target' must run after 'source'.
+ * Creating a graph allocates memory and must never be done in the audio thread.
+ */
+class EngineProcessGraph
+{
+public:
+    struct Callback {
+        virtual ~Callback() {}
+        virtual void processGraphNode(const uint index) = 0;
+    };
+
+    EngineProcessGraph(const uint nodeCount, const uint* const edgeSources, const uint* const edgeTargets, const uint edgeCount);
+    ~EngineProcessGraph();
+
+    // false if the edges form a cycle or memory allocation failed
+    bool isValid() const noexcept;
+
+    uint getNodeCount() const noexcept;
+
+    // timings of the last processed cycles, safe to read from any thread
+    const EngineProcessNodeTiming& getNodeTiming(const uint index) const noexcept;
+    float getCriticalPathUsecs() const noexcept;
+
+private:
+    bool fIsValid;
+    uint fNodeCount;
+
+    uint* fIndegree;    // number of inputs per node
+    uint* fSuccStart;   // nodeCount+1 offsets into fSucc
+    uint* fSucc;        // successors, grouped per node
+    uint* fOrder;       // topological order
+    uint* fCritPred;    // critical predecessor per node, used while computing the critical path
+
+    juce::Atomic<int>*       fPending; // inputs not yet processed in the current cycle
+    EngineProcessNodeTiming* fTimings;
+    float                    fCriticalPathUsecs;
+
+    void updateCriticalPath() noexcept;
+
+    friend class EngineProcessPool;
+    friend class EngineProcessTimings;
+
+    CARLA_DECLARE_NON_COPY_CLASS(EngineProcessGraph)
+};
+
+// -----------------------------------------------------------------------
+// EngineProcessTimings
+
+/*
+ * Copy of the node timings of an EngineProcessGraph, keyed by caller-defined node ids.
+ * Written by the thread running the graph after each cycle, read lock-free by any other thread.
+ * Readers retry while a new copy is being written.
+ */
+class EngineProcessTimings
+{
+public:
+    EngineProcessTimings(const uint maxNodes);
+    ~EngineProcessTimings();
+
+    // must be called from the thread running the graph, 'nodeIds' has one id per graph node
+    void publish(const EngineProcessGraph& graph, const uint* const nodeIds) noexcept;
+    void clear() noexcept;
+
+    // safe to call from any thread, false if the node is not known or the copy kept changing
+    bool get(const uint nodeId, EngineProcessNodeTiming& timing, float& criticalPathUsecs) const noexcept;
+
+private:
+    struct Entry;
+
+    const uint kMaxNodes;
+    Entry* fEntries;
+
+    juce::Atomic<int>   fSerial; // odd while writing
+    juce::Atomic<int>   fNodeCount;
+    juce::Atomic<float> fCriticalPathUsecs;
+
+    CARLA_DECLARE_NON_COPY_CLASS(EngineProcessTimings)
+};
+
+// -----------------------------------------------------------------------
+// EngineProcessPool
+
+/*
+ * Pool of audio worker threads that run an EngineProcessGraph in parallel.
+ * Ready nodes are queued on the thread that made them ready, idle threads steal from the others.
+ * The caller thread takes part in the processing and 'process()' returns once every node has run.
+ * Workers inherit the scheduling priority of the caller thread.
+ */
+class EngineProcessPool
+{
+public:
+    // 'numThreads' includes the caller thread, so 1 means no extra threads
+    EngineProcessPool(const uint numThreads, const uint maxNodes);
+    ~EngineProcessPool();
+
+    uint getThreadCount() const noexcept;
+    uint getMaxNodes() const noexcept;
+
+    // must be called from a single (audio) thread
+    void process(EngineProcessGraph& graph, EngineProcessGraph::Callback* const callback) noexcept;
+
+private:
+    class Worker;
+    struct Queue;
+
+    const uint kNumThreads;
+    const uint kMaxNodes;
+
+    Queue*   fQueues;  // one per thread, index 0 is the caller
+    Worker** fWorkers; // kNumThreads-1 threads
+
+    EngineProcessGraph*           fGraph;
+    EngineProcessGraph::Callback* fCallback;
+
+    juce::Atomic<int> fRemaining; // nodes not yet processed in the current cycle
+    juce::Atomic<int> fCycleGate; // workers inside the current cycle, plus kCycleClosed once it ends
+
+    bool fSchedCaptured;
+    int  fSchedPolicy;
+    int  fSchedPriority;
+
+    bool enterCycle() noexcept;
+    void leaveCycle() noexcept;
+    void runCycle(const uint threadIndex) noexcept;
+    void runNode(const uint threadIndex, const uint node) noexcept;
+    int  stealNode(const uint threadIndex) noexcept;
+
+    CARLA_DECLARE_NON_COPY_CLASS(EngineProcessPool)
+};
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
+
+#endif // CARLA_ENGINE_PROCESS_POOL_HPP_INCLUDED
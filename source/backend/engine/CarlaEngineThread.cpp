@@ -19,22 +19,57 @@
 #include "CarlaEngineThread.hpp"
 #include "CarlaPlugin.hpp"
 
+using juce::Time;
+
 CARLA_BACKEND_START_NAMESPACE
 
 // -----------------------------------------------------------------------
 
+// after being woken up, give the audio thread some time to report more changes, so they are handled in a single pass
+static const uint kEngineThreadWakeUpDelay = 5;
+
+// -----------------------------------------------------------------------
+
 CarlaEngineThread::CarlaEngineThread(CarlaEngine* const engine) noexcept
     : CarlaThread("CarlaEngineThread"),
       kEngine(engine),
+      fSem(carla_sem_create()),
+      fWakeUpPending(),
       leakDetector_CarlaEngineThread()
 {
     CARLA_SAFE_ASSERT(engine != nullptr);
+    CARLA_SAFE_ASSERT(fSem != nullptr);
     carla_debug("CarlaEngineThread::CarlaEngineThread(%p)", engine);
 }
 
 CarlaEngineThread::~CarlaEngineThread() noexcept
 {
     carla_debug("CarlaEngineThread::~CarlaEngineThread()");
+
+    if (fSem != nullptr)
+        carla_sem_destroy(fSem);
+}
+
+// -----------------------------------------------------------------------
+
+void CarlaEngineThread::wakeUp() noexcept
+{
+    if (fSem == nullptr)
+        return;
+
+    // only post once per pass, the semaphore should never count up
+    if (fWakeUpPending.compareAndSetBool(1, 0))
+        carla_sem_post(fSem);
+}
+
+bool CarlaEngineThread::stopThread(const int timeOutMilliseconds) noexcept
+{
+    signalThreadShouldExit();
+
+    if (fSem != nullptr)
+        carla_sem_post(fSem);
+
+    return CarlaThread::stopThread(timeOutMilliseconds);
 }
 
 // -----------------------------------------------------------------------
@@ -48,6 +83,8 @@ void CarlaEngineThread::run() noexcept
     carla_debug("CarlaEngineThread::run()");
 
     float value;
+    bool fullPass = true;
+    juce::uint32 lastFullPassTime = Time::getMillisecondCounter();
 
 #ifdef BUILD_BRIDGE
     for (; /*kEngine->isRunning() &&*/ ! shouldThreadExit();)
@@ -61,6 +98,9 @@ void CarlaEngineThread::run() noexcept
         const bool oscRegisted = false;
 #endif
 
+        // requests from now on need a new pass
+        fWakeUpPending = 0;
+
         for (uint i=0, count = kEngine->getCurrentPluginCount(); i < count; ++i)
         {
             CarlaPlugin* const plugin(kEngine->getPluginUnchecked(i));
@@ -68,6 +108,10 @@ void CarlaEngineThread::run() noexcept
             CARLA_SAFE_ASSERT_CONTINUE(plugin != nullptr && plugin->isEnabled());
             CARLA_SAFE_ASSERT_UINT2(i == plugin->getId(), i, plugin->getId());
 
+            // on wake up, only handle the plugins that asked for it
+            if (! (plugin->takeIdleRequest() || fullPass))
+                continue;
+
             const uint hints(plugin->getHints());
             const bool updateUI((hints & PLUGIN_HAS_CUSTOM_UI) != 0 && (hints & PLUGIN_NEEDS_UI_MAIN_THREAD) == 0);
 
@@ -84,12 +128,14 @@ void CarlaEngineThread::run() noexcept
             if (oscRegisted || updateUI)
             {
                 // -------------------------------------------------------
-                // Update parameter outputs
+                // Update changed parameter outputs
 
                 for (uint32_t j=0, pcount=plugin->getParameterCount(); j < pcount; ++j)
                 {
                     if (! plugin->isParameterOutput(j))
                         continue;
+                    if (! plugin->takeParameterOutputChanged(j))
+                        continue;
 
                     value = plugin->getParameterValue(j);
 
@@ -113,14 +159,38 @@ void CarlaEngineThread::run() noexcept
 
 #if defined(HAVE_LIBLO) && ! defined(BUILD_BRIDGE)
             // -----------------------------------------------------------
-            // Update OSC control client peaks
+            // Update OSC control client peaks and processing load
 
-            if (oscRegisted)
+            if (oscRegisted && fullPass)
+            {
                 kEngine->oscSend_control_set_peaks(i);
+                kEngine->oscSend_control_set_dsp_load(i);
+            }
 #endif
         }
 
-        carla_msleep(25);
+        // -----------------------------------------------------------
+        // Wait for the next full pass, or until woken up
+
+        const uint pollInterval(kEngine->getOptions().idlePollInterval);
+        const juce::uint32 elapsed(Time::getMillisecondCounter() - lastFullPassTime);
+        const uint waitTime(elapsed < pollInterval ? pollInterval - elapsed : kEngineThreadWakeUpDelay);
+
+        if (fSem != nullptr && carla_sem_timedwait_ms(fSem, waitTime))
+        {
+            carla_msleep(kEngineThreadWakeUpDelay);
+            fullPass = (Time::getMillisecondCounter() - lastFullPassTime >= pollInterval);
+        }
+        else
+        {
+            if (fSem == nullptr)
+                carla_msleep(waitTime);
+
+            fullPass = true;
+        }
+
+        if (fullPass)
+            lastFullPassTime = Time::getMillisecondCounter();
     }
 }
 
@@ -19,8 +19,12 @@
 #define CARLA_ENGINE_THREAD_HPP_INCLUDED
 
 #include "CarlaBackend.h"
+#include "CarlaMutex.hpp"
+#include "CarlaSemUtils.hpp"
 #include "CarlaThread.hpp"
 
+#include "juce_core.h"
+
 CARLA_BACKEND_START_NAMESPACE
 
 // -----------------------------------------------------------------------
@@ -32,15 +36,181 @@ public:
     CarlaEngineThread(CarlaEngine* const engine) noexcept;
     ~CarlaEngineThread() noexcept override;
 
+    // wake up the thread before its poll interval ends, RT safe
+    void wakeUp() noexcept;
+
+    // wakes up the thread first, so it does not wait for the poll interval
+    bool stopThread(const int timeOutMilliseconds) noexcept;
+
 protected:
     void run() noexcept override;
 
 private:
     CarlaEngine* const kEngine;
 
+    sem_t* fSem;
+    juce::Atomic<int> fWakeUpPending;
+
     CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CarlaEngineThread)
 };
 
+// -----------------------------------------------------------------------
+// CarlaEngineWorkerQueue
+
+/*
+ * Bounded queue of plugins waiting for a worker thread.
+ * Pushing is lock-free and can be done from any number of threads at once, including the audio thread.
+ * Popping and removing can also happen from several threads, but the caller must serialise those.
+ * Each slot sequence tells if it is free for writing (== pos) or ready for reading (== pos+1).
+ */
+class CarlaEngineWorkerQueue
+{
+public:
+    static const uint kSize = 256; // power of 2
+
+    CarlaEngineWorkerQueue() noexcept
+        : fWritePos(),
+          fReadPos(0)
+    {
+        for (uint i=0; i < kSize; ++i)
+        {
+            fSlots[i].sequence = static_cast<int>(i);
+            fSlots[i].plugin   = nullptr;
+        }
+    }
+
+    // RT safe, returns false if the queue is full
+    bool push(CarlaPlugin* const plugin) noexcept
+    {
+        for (int pos = fWritePos.get();;)
+        {
+            Slot& slot(fSlots[static_cast<uint>(pos) % kSize]);
+            const int diff(seqDiff(slot.sequence.get(), pos));
+
+            if (diff == 0)
+            {
+                if (fWritePos.compareAndSetBool(seqAdd(pos, 1), pos))
+                {
+                    slot.plugin   = plugin;
+                    slot.sequence = seqAdd(pos, 1);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // full
+                return false;
+            }
+
+            pos = fWritePos.get();
+        }
+    }
+
+    // returns false if nothing was published yet, 'plugin' is null for removed entries
+    bool pop(CarlaPlugin*& plugin) noexcept
+    {
+        Slot& slot(fSlots[static_cast<uint>(fReadPos) % kSize]);
+
+        if (seqDiff(slot.sequence.get(), seqAdd(fReadPos, 1)) != 0)
+            return false;
+
+        plugin = slot.plugin;
+
+        slot.plugin   = nullptr;
+        slot.sequence = seqAdd(fReadPos, kSize);
+        fReadPos      = seqAdd(fReadPos, 1);
+        return true;
+    }
+
+    // clear published entries of 'plugin', they stay in the queue as null
+    void remove(CarlaPlugin* const plugin) noexcept
+    {
+        for (int pos = fReadPos;; pos = seqAdd(pos, 1))
+        {
+            Slot& slot(fSlots[static_cast<uint>(pos) % kSize]);
+
+            if (seqDiff(slot.sequence.get(), seqAdd(pos, 1)) != 0)
+                break;
+
+            if (slot.plugin == plugin)
+                slot.plugin = nullptr;
+        }
+    }
+
+private:
+    struct Slot {
+        juce::Atomic<int> sequence;
+        CarlaPlugin* plugin;
+    };
+
+    Slot fSlots[kSize];
+    juce::Atomic<int> fWritePos;
+    int fReadPos;
+
+    // positions wrap around, so do the math unsigned
+    static int seqAdd(const int a, const uint b) noexcept
+    {
+        return static_cast<int>(static_cast<uint>(a) + b);
+    }
+
+    static int seqDiff(const int a, const int b) noexcept
+    {
+        return static_cast<int>(static_cast<uint>(a) - static_cast<uint>(b));
+    }
+
+    CARLA_DECLARE_NON_COPY_CLASS(CarlaEngineWorkerQueue)
+};
+
+// -----------------------------------------------------------------------
+// CarlaEngineWorkerPool
+
+/*
+ * Non-RT threads that run plugin work requested from the audio thread, see CarlaPlugin::runWork().
+ * Scheduling is lock-free and never blocks, workers sleep on a semaphore until then.
+ * A plugin is never queued twice in a row by the plugins themselves, so the queue holds one entry per plugin at most.
+ */
+class CarlaEngineWorkerPool
+{
+public:
+    CarlaEngineWorkerPool() noexcept;
+    virtual ~CarlaEngineWorkerPool() noexcept;
+
+    void startThreads() noexcept;
+    void stopThreads() noexcept;
+
+    // queue 'plugin' for a worker thread, RT safe
+    // returns false if the queue is full
+    bool schedule(CarlaPlugin* const plugin) noexcept;
+
+    // remove 'plugin' from the queue and wait for its current work to finish
+    // the plugin must not schedule new work meanwhile
+    void cancel(CarlaPlugin* const plugin) noexcept;
+
+protected:
+    CarlaEngineWorkerQueue fQueue;
+    sem_t* fSem; // posted once per queued entry, always after pushing it
+
+    // called from a worker thread, calls plugin->runWork()
+    // subclasses that override this must call stopThreads() in their destructor
+    virtual void runWork(CarlaPlugin* const plugin) noexcept;
+
+private:
+    class Worker;
+
+    static const uint kNumWorkers = 2;
+
+    CarlaMutex fReadMutex; // serialises fQueue readers, never taken by the audio thread
+
+    Worker* fWorkers[kNumWorkers];
+    CarlaPlugin* fRunning[kNumWorkers]; // protected by fReadMutex
+
+    // returns false if the next entry is not published yet, 'plugin' is null for cancelled entries
+    bool takeNext(const uint workerIndex, CarlaPlugin*& plugin) noexcept;
+    void finished(const uint workerIndex) noexcept;
+
+    CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CarlaEngineWorkerPool)
+};
+
 // -----------------------------------------------------------------------
 
 CARLA_BACKEND_END_NAMESPACE
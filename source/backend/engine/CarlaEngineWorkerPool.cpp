@@ -0,0 +1,189 @@
+/*
+ * Carla Plugin Host
+ * Copyright (C) 2011-2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "CarlaEngineThread.hpp"
+#include "CarlaPlugin.hpp"
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+// CarlaEngineWorkerPool
+
+class CarlaEngineWorkerPool::Worker : public CarlaThread
+{
+public:
+    Worker(CarlaEngineWorkerPool* const pool, const uint index) noexcept
+        : CarlaThread("CarlaEngineWorker"),
+          kPool(pool),
+          kIndex(index) {}
+
+protected:
+    void run() noexcept override
+    {
+        for (; ! shouldThreadExit();)
+        {
+            if (! carla_sem_timedwait(kPool->fSem, 1))
+                continue;
+
+            CarlaPlugin* plugin = nullptr;
+
+            // every token belongs to a queued entry, but with several producers it can be posted
+            // before the entry in front of it is published, so wait for that one instead of dropping the token
+            for (; ! kPool->takeNext(kIndex, plugin);)
+            {
+                // woken up to quit
+                if (shouldThreadExit())
+                    return;
+
+                juce::Thread::yield();
+            }
+
+            // cancelled
+            if (plugin == nullptr)
+                continue;
+
+            kPool->runWork(plugin);
+            kPool->finished(kIndex);
+        }
+    }
+
+private:
+    CarlaEngineWorkerPool* const kPool;
+    const uint kIndex;
+
+    CARLA_DECLARE_NON_COPY_CLASS(Worker)
+};
+
+// -----------------------------------------------------------------------
+
+CarlaEngineWorkerPool::CarlaEngineWorkerPool() noexcept
+    : fQueue(),
+      fSem(carla_sem_create()),
+      fReadMutex(),
+      leakDetector_CarlaEngineWorkerPool()
+{
+    CARLA_SAFE_ASSERT(fSem != nullptr);
+
+    for (uint i=0; i < kNumWorkers; ++i)
+    {
+        fWorkers[i] = new Worker(this, i);
+        fRunning[i] = nullptr;
+    }
+}
+
+CarlaEngineWorkerPool::~CarlaEngineWorkerPool() noexcept
+{
+    stopThreads();
+
+    for (uint i=0; i < kNumWorkers; ++i)
+        delete fWorkers[i];
+
+    if (fSem != nullptr)
+        carla_sem_destroy(fSem);
+}
+
+void CarlaEngineWorkerPool::startThreads() noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(fSem != nullptr,);
+
+    for (uint i=0; i < kNumWorkers; ++i)
+        fWorkers[i]->startThread();
+}
+
+void CarlaEngineWorkerPool::stopThreads() noexcept
+{
+    for (uint i=0; i < kNumWorkers; ++i)
+        fWorkers[i]->signalThreadShouldExit();
+
+    if (fSem != nullptr)
+    {
+        for (uint i=0; i < kNumWorkers; ++i)
+            carla_sem_post(fSem);
+    }
+
+    for (uint i=0; i < kNumWorkers; ++i)
+        fWorkers[i]->stopThread(1000);
+}
+
+bool CarlaEngineWorkerPool::schedule(CarlaPlugin* const plugin) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(plugin != nullptr, false);
+    CARLA_SAFE_ASSERT_RETURN(fSem != nullptr, false);
+
+    if (! fQueue.push(plugin))
+        return false;
+
+    carla_sem_post(fSem);
+    return true;
+}
+
+void CarlaEngineWorkerPool::cancel(CarlaPlugin* const plugin) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(plugin != nullptr,);
+
+    for (;;)
+    {
+        {
+            const CarlaMutexLocker cml(fReadMutex);
+
+            // clear queued entries, workers will skip them
+            fQueue.remove(plugin);
+
+            bool running = false;
+
+            for (uint i=0; i < kNumWorkers; ++i)
+            {
+                if (fRunning[i] == plugin)
+                    running = true;
+            }
+
+            if (! running)
+                return;
+        }
+
+        carla_msleep(1);
+    }
+}
+
+void CarlaEngineWorkerPool::runWork(CarlaPlugin* const plugin) noexcept
+{
+    try {
+        plugin->runWork();
+    } CARLA_SAFE_EXCEPTION("runWork()")
+}
+
+bool CarlaEngineWorkerPool::takeNext(const uint workerIndex, CarlaPlugin*& plugin) noexcept
+{
+    const CarlaMutexLocker cml(fReadMutex);
+
+    if (! fQueue.pop(plugin))
+        return false;
+
+    fRunning[workerIndex] = plugin;
+    return true;
+}
+
+void CarlaEngineWorkerPool::finished(const uint workerIndex) noexcept
+{
+    const CarlaMutexLocker cml(fReadMutex);
+
+    fRunning[workerIndex] = nullptr;
+}
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
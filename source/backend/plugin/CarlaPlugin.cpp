@@ -49,6 +49,9 @@ static const CustomData        kCustomDataFallback        = { nullptr, nullptr,
 static /* */ CustomData        kCustomDataFallbackNC      = { nullptr, nullptr, nullptr };
 static const PluginPostRtEvent kPluginPostRtEventFallback = { kPluginPostRtEventNull, 0, 0, 0.0f };
 
+// peaks at or below this level (-100 dB) count as silence
+static const float kSilenceThreshold = 0.00001f;
+
 // -------------------------------------------------------------------
 // ParamSymbol struct, needed for CarlaPlugin::loadStateSave()
 
@@ -74,6 +77,27 @@ struct ParamSymbol {
 #endif
 };
 
+// -------------------------------------------------------------------
+// PluginBridgeLatency
+
+PluginBridgeLatency::PluginBridgeLatency() noexcept
+    : writeAverage(0.0f),
+      writeMaximum(0.0f),
+      processAverage(0.0f),
+      processMaximum(0.0f),
+      readAverage(0.0f),
+      readMaximum(0.0f),
+      totalAverage(0.0f),
+      totalMaximum(0.0f),
+      percentile95(0.0f),
+      percentile99(0.0f),
+      slowBlocks(0),
+      timeouts(0),
+      blocks(0)
+{
+    carla_zeroStruct(histogram, kPluginBridgeLatencyBucketCount);
+}
+
 // -------------------------------------------------------------------
 // Constructor and destructor
 
@@ -165,6 +189,11 @@ uint32_t CarlaPlugin::getLatencyInFrames() const noexcept
     return 0;
 }
 
+uint32_t CarlaPlugin::getTailLengthInFrames() const noexcept
+{
+    return 0;
+}
+
 // -------------------------------------------------------------------
 // Information (count)
 
@@ -408,6 +437,60 @@ void CarlaPlugin::getParameterCountInfo(uint32_t& ins, uint32_t& outs) const noe
     }
 }
 
+uint32_t CarlaPlugin::updateGenerations() noexcept
+{
+    ProtectedData::Generations& gen(pData->generations);
+    PluginParameterData& param(pData->param);
+
+    if (gen.paramSerial != param.serial || gen.progSerial != pData->prog.serial || gen.midiprogSerial != pData->midiprog.serial)
+    {
+        gen.paramSerial    = param.serial;
+        gen.progSerial     = pData->prog.serial;
+        gen.midiprogSerial = pData->midiprog.serial;
+        gen.layout         = ++gen.current;
+
+        for (uint32_t i=0; i < param.count; ++i)
+        {
+            param.lastValues[i]  = getParameterValue(i);
+            param.generations[i] = gen.current;
+        }
+
+        return gen.current;
+    }
+
+    const uint32_t next(gen.current + 1);
+    bool changed = false;
+
+    for (uint32_t i=0; i < param.count; ++i)
+    {
+        const float value(getParameterValue(i));
+
+        if (carla_compareFloats(param.lastValues[i], value))
+            continue;
+
+        param.lastValues[i]  = value;
+        param.generations[i] = next;
+        changed = true;
+    }
+
+    if (changed)
+        gen.current = next;
+
+    return gen.current;
+}
+
+uint32_t CarlaPlugin::getParameterGeneration(const uint32_t parameterId) const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(parameterId < pData->param.count, 0);
+
+    return pData->param.generations[parameterId];
+}
+
+uint32_t CarlaPlugin::getLayoutGeneration() const noexcept
+{
+    return pData->generations.layout;
+}
+
 // -------------------------------------------------------------------
 // Set data (state)
 
@@ -918,6 +1001,9 @@ void CarlaPlugin::setOption(const uint option, const bool yesNo, const bool send
 {
     CARLA_SAFE_ASSERT_RETURN(getOptionsAvailable() & option,);
 
+    if (option == PLUGIN_OPTION_SKIP_SILENCE)
+        pData->silence.tailFrames = getTailLengthInFrames();
+
     if (yesNo)
         pData->options |= option;
     else
@@ -959,6 +1045,9 @@ void CarlaPlugin::setActive(const bool active, const bool sendOsc, const bool se
             activate();
         else
             deactivate();
+
+        pData->silence.reset();
+        pData->silence.tailFrames = getTailLengthInFrames();
     }
 
     pData->active = active;
@@ -1580,6 +1669,68 @@ void CarlaPlugin::idle()
     pData->postRtEvents.data.clear();
 }
 
+bool CarlaPlugin::takeIdleRequest() noexcept
+{
+    return pData->idleRequested.exchange(0) != 0;
+}
+
+void CarlaPlugin::runWork() noexcept
+{
+}
+
+bool CarlaPlugin::takeParameterOutputChanged(const uint32_t parameterId) noexcept
+{
+    return pData->param.takeOutputChanged(parameterId);
+}
+
+void CarlaPlugin::refreshParameterOutputs() noexcept
+{
+    pData->param.markOutputsChanged();
+    pData->requestIdleRT();
+}
+
+bool CarlaPlugin::isSleepingOnSilence(const float inPeak) noexcept
+{
+    if ((pData->options & PLUGIN_OPTION_SKIP_SILENCE) == 0)
+        return false;
+
+    bool wakeUp = inPeak > kSilenceThreshold || ! pData->extNotes.data.isEmpty();
+
+    if (! wakeUp && pData->event.portIn != nullptr)
+        wakeUp = pData->event.portIn->getEventCount() != 0;
+
+    if (wakeUp)
+    {
+        pData->silence.reset();
+        return false;
+    }
+
+    return pData->silence.sleeping;
+}
+
+void CarlaPlugin::updateSilenceState(const float inPeak, const float outPeak, const uint32_t frames) noexcept
+{
+    if ((pData->options & PLUGIN_OPTION_SKIP_SILENCE) == 0)
+        return;
+
+    ProtectedData::Silence& silence(pData->silence);
+
+    if (inPeak > kSilenceThreshold)
+    {
+        silence.silentFrames = 0;
+        return;
+    }
+
+    // saturate instead of wrapping around on very long silence
+    if (silence.silentFrames < UINT32_MAX - frames)
+        silence.silentFrames += frames;
+    else
+        silence.silentFrames = UINT32_MAX;
+
+    if (outPeak <= kSilenceThreshold && silence.silentFrames > silence.tailFrames)
+        silence.sleeping = true;
+}
+
 bool CarlaPlugin::tryLock(const bool forcedOffline) noexcept
 {
     if (forcedOffline)
@@ -1785,6 +1936,8 @@ void CarlaPlugin::sendMidiAllNotesOffToCallback()
         postEvent.value2 = i;
         pData->postRtEvents.appendRT(postEvent);
     }
+
+    pData->requestIdleRT();
 }
 #endif
 
@@ -1953,6 +2106,26 @@ uintptr_t CarlaPlugin::getUiBridgeProcessId() const noexcept
     return 0;
 }
 
+bool CarlaPlugin::getBridgeLatency(PluginBridgeLatency&) const noexcept
+{
+    return false;
+}
+
+void CarlaPlugin::resetBridgeLatency() noexcept
+{
+}
+
+void CarlaPlugin::getSubBlockCount(uint32_t& blocks, uint32_t& subBlocks) const noexcept
+{
+    blocks    = pData->subBlocks.blocks;
+    subBlocks = pData->subBlocks.runs;
+}
+
+void CarlaPlugin::resetSubBlockCount() noexcept
+{
+    pData->subBlocks.needsReset = true;
+}
+
 // -------------------------------------------------------------------
 
 uint32_t CarlaPlugin::getPatchbayNodeId() const noexcept
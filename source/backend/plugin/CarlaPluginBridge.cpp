@@ -128,6 +128,82 @@ struct BridgeAudioPool {
 
 // -------------------------------------------------------------------------------------------------------------------
 
+// raw chunk data sent to the bridge, kept until the bridge tells us it was read
+struct BridgeChunkShm {
+    CarlaString filename;
+    void* data;
+    shm_t shm;
+
+    BridgeChunkShm() noexcept
+        : filename(),
+          data(nullptr)
+#ifdef CARLA_PROPER_CPP11_SUPPORT
+        , shm(shm_t_INIT) {}
+#else
+    {
+        shm = shm_t_INIT;
+    }
+#endif
+
+    ~BridgeChunkShm() noexcept
+    {
+        clear();
+    }
+
+    bool write(const void* const chunk, const std::size_t size) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(chunk != nullptr, false);
+        CARLA_SAFE_ASSERT_RETURN(size > 0, false);
+
+        clear();
+
+        char tmpFileBase[64];
+        std::sprintf(tmpFileBase, PLUGIN_BRIDGE_NAMEPREFIX_CHUNK "XXXXXX");
+
+        shm = carla_shm_create_temp(tmpFileBase);
+
+        if (! carla_is_shm_valid(shm))
+            return false;
+
+        data = carla_shm_map(shm, size);
+
+        if (data == nullptr)
+        {
+            clear();
+            return false;
+        }
+
+        std::memcpy(data, chunk, size);
+
+        filename = tmpFileBase;
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        filename.clear();
+
+        if (! carla_is_shm_valid(shm))
+        {
+            CARLA_SAFE_ASSERT(data == nullptr);
+            return;
+        }
+
+        if (data != nullptr)
+        {
+            carla_shm_unmap(shm, data);
+            data = nullptr;
+        }
+
+        carla_shm_close(shm);
+        carla_shm_init(shm);
+    }
+
+    CARLA_DECLARE_NON_COPY_STRUCT(BridgeChunkShm)
+};
+
+// -------------------------------------------------------------------------------------------------------------------
+
 struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
     BridgeRtClientData* data;
     CarlaString filename;
@@ -154,7 +230,7 @@ struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
         clear();
     }
 
-    bool initialize() noexcept
+    bool initialize(const bool lowLatency) noexcept
     {
         char tmpFileBase[64];
 
@@ -191,6 +267,10 @@ struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
             return false;
         }
 
+        // use the spin-then-futex handshake for audio cycles if requested and available, the semaphores stay as fallback
+        if (lowLatency && jackbridge_futex_sem_init(&data->sem.futexServer) && jackbridge_futex_sem_init(&data->sem.futexClient))
+            data->sem.lowLatency = 1;
+
         filename = tmpFileBase;
         needsSemDestroy = true;
         return true;
@@ -243,11 +323,24 @@ struct BridgeRtClientControl : public CarlaRingBufferControl<SmallStackBuffer> {
         setRingBuffer(nullptr, false);
     }
 
+    // wake up the bridge, so it reads and handles the pending data
+    bool postServer() noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(data != nullptr, false);
+
+        if (data->sem.lowLatency != 0)
+            return jackbridge_futex_sem_post(&data->sem.futexServer);
+
+        return jackbridge_sem_post(&data->sem.server);
+    }
+
+    // wait for the bridge to finish handling the data of the last post
     bool waitForClient(const uint secs, bool* const timedOut) noexcept
     {
         CARLA_SAFE_ASSERT_RETURN(data != nullptr, false);
 
-        jackbridge_sem_post(&data->sem.server);
+        if (data->sem.lowLatency != 0)
+            return jackbridge_futex_sem_timedwait(&data->sem.futexClient, secs, timedOut);
 
         return jackbridge_sem_timedwait(&data->sem.client, secs, timedOut);
     }
@@ -491,6 +584,128 @@ struct BridgeParamInfo {
 
 // -------------------------------------------------------------------------------------------------------------------
 
+// round-trip timing accumulator, written by the audio thread and read from any other
+// there are no locks, readers may see a block half-way through being added
+struct BridgeLatencyStats {
+    float writeAverage, writeMaximum;
+    float processAverage, processMaximum;
+    float readAverage, readMaximum;
+    float totalAverage, totalMaximum;
+    float lastSlowLoad; // percent of the audio cycle
+    uint32_t slowBlocks;
+    uint32_t timeouts;
+    uint32_t blocks;
+    uint32_t buckets[kPluginBridgeLatencyBucketCount];
+
+    void clear() noexcept
+    {
+        carla_zeroStruct(*this);
+    }
+
+    // times are in seconds, 'load' in percent of the audio cycle
+    // @note RT call
+    void add(const double writeSecs, const double processSecs, const double readSecs, const float load, const bool slow) noexcept
+    {
+        const float writeTime(static_cast<float>(writeSecs * 1000000.0));
+        const float processTime(static_cast<float>(processSecs * 1000000.0));
+        const float readTime(static_cast<float>(readSecs * 1000000.0));
+        const float totalTime(writeTime + processTime + readTime);
+
+        if (blocks == 0)
+        {
+            writeAverage   = writeMaximum   = writeTime;
+            processAverage = processMaximum = processTime;
+            readAverage    = readMaximum    = readTime;
+            totalAverage   = totalMaximum   = totalTime;
+        }
+        else
+        {
+            addTime(writeAverage, writeMaximum, writeTime);
+            addTime(processAverage, processMaximum, processTime);
+            addTime(readAverage, readMaximum, readTime);
+            addTime(totalAverage, totalMaximum, totalTime);
+        }
+
+        if (slow)
+        {
+            lastSlowLoad = load;
+            ++slowBlocks;
+        }
+
+        // log2 of the round-trip in microseconds, anything above 2^24 goes into the last bucket anyway
+        uint bucket = 0;
+
+        for (uint32_t usecs = static_cast<uint32_t>(carla_fixValue(0.0f, 16777216.0f, totalTime)); usecs > 1; usecs >>= 1)
+            ++bucket;
+
+        ++buckets[bucket < kPluginBridgeLatencyBucketCount ? bucket : kPluginBridgeLatencyBucketCount-1];
+        ++blocks;
+    }
+
+    void get(PluginBridgeLatency& latency) const noexcept
+    {
+        latency.writeAverage   = writeAverage;
+        latency.writeMaximum   = writeMaximum;
+        latency.processAverage = processAverage;
+        latency.processMaximum = processMaximum;
+        latency.readAverage    = readAverage;
+        latency.readMaximum    = readMaximum;
+        latency.totalAverage   = totalAverage;
+        latency.totalMaximum   = totalMaximum;
+        latency.slowBlocks     = slowBlocks;
+        latency.timeouts       = timeouts;
+        latency.blocks         = blocks;
+
+        uint64_t total = 0;
+
+        for (uint i=0; i < kPluginBridgeLatencyBucketCount; ++i)
+        {
+            latency.histogram[i] = buckets[i];
+            total += buckets[i];
+        }
+
+        latency.percentile95 = 0.0f;
+        latency.percentile99 = 0.0f;
+
+        if (total == 0)
+            return;
+
+        const uint64_t limit95((total * 95 + 99) / 100);
+        const uint64_t limit99((total * 99 + 99) / 100);
+        uint64_t sum = 0;
+
+        for (uint i=0; i < kPluginBridgeLatencyBucketCount; ++i)
+        {
+            sum += latency.histogram[i];
+
+            // upper edge of the bucket, or the real maximum if lower
+            float value(totalMaximum);
+
+            if (i+1 < kPluginBridgeLatencyBucketCount && static_cast<float>(2U << i) < totalMaximum)
+                value = static_cast<float>(2U << i);
+
+            if (latency.percentile95 == 0.0f && sum >= limit95)
+                latency.percentile95 = value;
+
+            if (sum >= limit99)
+            {
+                latency.percentile99 = value;
+                break;
+            }
+        }
+    }
+
+    static void addTime(float& average, float& maximum, const float time) noexcept
+    {
+        average += (time - average) * 0.1f;
+
+        if (time > maximum)
+            maximum = time;
+    }
+};
+
+// -------------------------------------------------------------------------------------------------------------------
+
 class CarlaPluginBridgeThread : public CarlaThread
 {
 public:
@@ -597,6 +812,9 @@ protected:
             std::snprintf(strBuf, STR_MAX, "%u", options.uiBridgesTimeout);
             carla_setenv("ENGINE_OPTION_UI_BRIDGES_TIMEOUT",strBuf);
 
+            std::snprintf(strBuf, STR_MAX, "%u", options.splitGranularity);
+            carla_setenv("ENGINE_OPTION_SPLIT_GRANULARITY", strBuf);
+
             if (options.pathLADSPA != nullptr)
                 carla_setenv("ENGINE_OPTION_PLUGIN_PATH_LADSPA", options.pathLADSPA);
             else
@@ -743,13 +961,19 @@ public:
           fSaved(true),
           fTimedOut(false),
           fTimedError(false),
+          fPipelined(false),
+          fProcessPending(false),
           fLastPongTime(-1),
+          fLatency(),
+          fLatencyNeedsReset(false),
+          fLastSlowBlocks(0),
           fBridgeBinary(),
           fBridgeThread(engine, this),
           fShmAudioPool(),
           fShmRtClientControl(),
           fShmNonRtClientControl(),
           fShmNonRtServerControl(),
+          fShmChunk(),
           fInfo(),
           fParams(nullptr),
           leakDetector_CarlaPluginBridge()
@@ -757,6 +981,8 @@ public:
         carla_debug("CarlaPluginBridge::CarlaPluginBridge(%p, %i, %s, %s)", engine, id, BinaryType2Str(btype), PluginType2Str(ptype));
 
         pData->hints |= PLUGIN_IS_BRIDGE;
+
+        carla_zeroBytes(fMidiOut, kBridgeRtClientDataMidiOutSize);
     }
 
     ~CarlaPluginBridge() override
@@ -797,6 +1023,7 @@ public:
         fShmNonRtClientControl.clear();
         fShmRtClientControl.clear();
         fShmAudioPool.clear();
+        fShmChunk.clear();
 
         clearBuffers();
 
@@ -826,6 +1053,12 @@ public:
         return fInfo.uniqueId;
     }
 
+    uint32_t getLatencyInFrames() const noexcept override
+    {
+        // pipelined processing delays the output by one block
+        return fPipelined ? pData->engine->getBufferSize() : 0;
+    }
+
     // -------------------------------------------------------------------
     // Information (count)
 
@@ -1129,29 +1362,47 @@ public:
 
         carla_stdout("Carla bridge server side, setChunkData 001");
 
-        CarlaString dataBase64(CarlaString::asBase64(data, dataSize));
-        CARLA_SAFE_ASSERT_RETURN(dataBase64.length() > 0,);
-
-        String filePath(File::getSpecialLocation(File::tempDirectory).getFullPathName());
-
-        filePath += CARLA_OS_SEP_STR ".CarlaChunk_";
-        filePath += fShmAudioPool.filename.buffer() + 18;
-
-        if (File(filePath).replaceWithText(dataBase64.buffer()))
+        // raw data through shared memory, base64 file as fallback
+        if (fShmChunk.write(data, dataSize))
         {
-            carla_stdout("Carla bridge server side, setChunkData 002");
-
-            const uint32_t ulength(static_cast<uint32_t>(filePath.length()));
+            const uint32_t ulength(static_cast<uint32_t>(fShmChunk.filename.length()));
 
             const CarlaMutexLocker _cml(fShmNonRtClientControl.mutex);
 
-            fShmNonRtClientControl.writeOpcode(kPluginBridgeNonRtClientSetChunkDataFile);
+            fShmNonRtClientControl.writeOpcode(kPluginBridgeNonRtClientSetChunkDataShm);
+            fShmNonRtClientControl.writeULong(static_cast<uint64_t>(dataSize));
             fShmNonRtClientControl.writeUInt(ulength);
-            fShmNonRtClientControl.writeCustomData(filePath.toRawUTF8(), ulength);
+            fShmNonRtClientControl.writeCustomData(fShmChunk.filename.buffer(), ulength);
             fShmNonRtClientControl.commitWrite();
 
             carla_stdout("Carla bridge server side, setChunkData sent");
         }
+        else
+        {
+            CarlaString dataBase64(CarlaString::asBase64(data, dataSize));
+            CARLA_SAFE_ASSERT_RETURN(dataBase64.length() > 0,);
+
+            String filePath(File::getSpecialLocation(File::tempDirectory).getFullPathName());
+
+            filePath += CARLA_OS_SEP_STR ".CarlaChunk_";
+            filePath += fShmAudioPool.filename.buffer() + 18;
+
+            if (File(filePath).replaceWithText(dataBase64.buffer()))
+            {
+                carla_stdout("Carla bridge server side, setChunkData 002");
+
+                const uint32_t ulength(static_cast<uint32_t>(filePath.length()));
+
+                const CarlaMutexLocker _cml(fShmNonRtClientControl.mutex);
+
+                fShmNonRtClientControl.writeOpcode(kPluginBridgeNonRtClientSetChunkDataFile);
+                fShmNonRtClientControl.writeUInt(ulength);
+                fShmNonRtClientControl.writeCustomData(filePath.toRawUTF8(), ulength);
+                fShmNonRtClientControl.commitWrite();
+
+                carla_stdout("Carla bridge server side, setChunkData sent");
+            }
+        }
 
         // save data internally as well
         fInfo.chunk.resize(dataSize);
@@ -1201,6 +1452,20 @@ public:
             try {
                 handleNonRtData();
             } CARLA_SAFE_EXCEPTION("handleNonRtData");
+
+            const uint32_t slowBlocks(fLatency.slowBlocks);
+
+            // stats were reset meanwhile
+            if (slowBlocks < fLastSlowBlocks)
+                fLastSlowBlocks = 0;
+
+            if (slowBlocks != fLastSlowBlocks)
+            {
+                pData->engine->callback(ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS, pData->id,
+                                        static_cast<int>(slowBlocks - fLastSlowBlocks), static_cast<int>(slowBlocks),
+                                        fLatency.lastSlowLoad, nullptr);
+                fLastSlowBlocks = slowBlocks;
+            }
         }
         else if (fInitiated)
         {
@@ -1376,6 +1641,7 @@ public:
         }
 
         fTimedOut = false;
+        fLatencyNeedsReset = true;
 
         try {
             waitForClient("activate", 2);
@@ -1670,7 +1936,8 @@ public:
 
             uint8_t size;
             uint32_t time;
-            const uint8_t* midiData(fShmRtClientControl.data->midiOut);
+            // the bridge is already writing the next block when pipelined, use the copy taken before
+            const uint8_t* midiData(fPipelined ? fMidiOut : fShmRtClientControl.data->midiOut);
 
             for (std::size_t read=0; read<kBridgeRtClientDataMidiOutSize;)
             {
@@ -1740,11 +2007,64 @@ public:
             return false;
         }
 
+        const int64_t startTicks(Time::getHighResolutionTicks());
+        int64_t waitTicks = 0;
+
+        if (fLatencyNeedsReset)
+        {
+            fLatencyNeedsReset = false;
+            fLatency.clear();
+        }
+
+        // --------------------------------------------------------------------------------------------------------
+        // Pipelined mode, collect the block started in the previous cycle
+
+        const bool hasPendingBlock(fProcessPending);
+
+        if (hasPendingBlock)
+        {
+            waitForPendingBlock();
+            waitTicks = Time::getHighResolutionTicks() - startTicks;
+
+            if (fTimedOut)
+            {
+                ++fLatency.timeouts;
+                pData->singleMutex.unlock();
+                return false;
+            }
+        }
+
         // --------------------------------------------------------------------------------------------------------
         // Reset audio buffers
 
+        const float* shmAudioIn[fInfo.aIns];
+
         for (uint32_t i=0; i < fInfo.aIns; ++i)
-            FloatVectorOperations::copy(fShmAudioPool.data + (i * frames), audioIn[i], static_cast<int>(frames));
+        {
+            float* const shmIn(fShmAudioPool.data + (i * frames));
+            shmAudioIn[i] = shmIn;
+
+            // nothing to do if the engine already wrote into the pool
+            if (audioIn[i] != shmIn)
+                FloatVectorOperations::copy(shmIn, audioIn[i], static_cast<int>(frames));
+        }
+
+        if (fPipelined)
+        {
+            // output is the previous block, or silence if there is none yet
+            for (uint32_t i=0; i < fInfo.aOuts; ++i)
+            {
+                if (hasPendingBlock)
+                    FloatVectorOperations::copy(audioOut[i], fShmAudioPool.data + ((i + fInfo.aIns) * frames), static_cast<int>(frames));
+                else
+                    FloatVectorOperations::clear(audioOut[i], static_cast<int>(frames));
+            }
+
+            if (hasPendingBlock)
+                std::memcpy(fMidiOut, fShmRtClientControl.data->midiOut, kBridgeRtClientDataMidiOutSize);
+            else
+                carla_zeroBytes(fMidiOut, kBridgeRtClientDataMidiOutSize);
+        }
 
         // --------------------------------------------------------------------------------------------------------
         // TimeInfo
@@ -1779,83 +2099,66 @@ public:
             fShmRtClientControl.commitWrite();
         }
 
-        waitForClient("process", 1);
+        const int64_t postTicks(Time::getHighResolutionTicks());
+        int64_t replyTicks = postTicks;
 
-        if (fTimedOut)
+        if (fPipelined)
         {
-            pData->singleMutex.unlock();
-            return false;
+            // let the bridge render while the engine does other work, collected on the next cycle
+            fShmRtClientControl.postServer();
+            fProcessPending = true;
         }
-
-        for (uint32_t i=0; i < fInfo.aOuts; ++i)
-            FloatVectorOperations::copy(audioOut[i], fShmAudioPool.data + ((i + fInfo.aIns) * frames), static_cast<int>(frames));
-
-#ifndef BUILD_BRIDGE
-        // --------------------------------------------------------------------------------------------------------
-        // Post-processing (dry/wet, volume and balance)
-
+        else
         {
-            const bool doVolume  = (pData->hints & PLUGIN_CAN_VOLUME) != 0 && ! carla_compareFloats(pData->postProc.volume, 1.0f);
-            const bool doDryWet  = (pData->hints & PLUGIN_CAN_DRYWET) != 0 && ! carla_compareFloats(pData->postProc.dryWet, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
+            waitForClient("process", 1);
+            replyTicks = Time::getHighResolutionTicks();
+            waitTicks  = replyTicks - postTicks;
 
-            bool isPair;
-            float bufValue, oldBufLeft[doBalance ? frames : 1];
+            if (fTimedOut)
+            {
+                ++fLatency.timeouts;
+                pData->singleMutex.unlock();
+                return false;
+            }
 
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
+            for (uint32_t i=0; i < fInfo.aOuts; ++i)
             {
-                // Dry/Wet
-                if (doDryWet)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        bufValue        = audioIn[(pData->audioIn.count == 1) ? 0 : i][k];
-                        audioOut[i][k] = (audioOut[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
-                    }
-                }
+                const float* const shmOut(fShmAudioPool.data + ((i + fInfo.aIns) * frames));
 
-                // Balance
-                if (doBalance)
-                {
-                    isPair = (i % 2 == 0);
+                if (audioOut[i] != shmOut)
+                    FloatVectorOperations::copy(audioOut[i], shmOut, static_cast<int>(frames));
+            }
+        }
 
-                    if (isPair)
-                    {
-                        CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        FloatVectorOperations::copy(oldBufLeft, audioOut[i], static_cast<int>(frames));
-                    }
+#ifndef BUILD_BRIDGE
+        // --------------------------------------------------------------------------------------------------------
+        // Post-processing (dry/wet, volume and balance)
 
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
+        // the pool keeps the input even when processing in place
+        pData->postProcess(shmAudioIn, audioOut, frames, 0, true);
+#endif
 
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (isPair)
-                        {
-                            // left
-                            audioOut[i][k]  = oldBufLeft[k]     * (1.0f - balRangeL);
-                            audioOut[i][k] += audioOut[i+1][k] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            audioOut[i][k]  = audioOut[i][k] * balRangeR;
-                            audioOut[i][k] += oldBufLeft[k]   * balRangeL;
-                        }
-                    }
-                }
+        // --------------------------------------------------------------------------------------------------------
+        // Save latency values for next callback
 
-                // Volume (and buffer copy)
-                if (doVolume)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        audioOut[i][k] *= pData->postProc.volume;
-                }
-            }
+        pData->latency.writeBuffers(shmAudioIn, fInfo.aIns, frames);
 
-        } // End of Post-processing
+        // --------------------------------------------------------------------------------------------------------
+        // Round-trip timing, the wait is the bridge stage, whatever comes before or after it is host work
+        // (the soft deadline only makes sense in realtime)
 
-#endif // BUILD_BRIDGE
+        {
+            const int64_t endTicks(Time::getHighResolutionTicks());
+            const double  cycleSecs(static_cast<double>(frames) / pData->engine->getSampleRate());
+            const double  totalSecs(Time::highResolutionTicksToSeconds(endTicks - startTicks));
+            const float   load(static_cast<float>(totalSecs / cycleSecs * 100.0));
+            const uint    deadline(pData->engine->getOptions().bridgeSoftDeadline);
+
+            fLatency.add(Time::highResolutionTicksToSeconds(postTicks - startTicks - (fPipelined ? waitTicks : 0)),
+                         Time::highResolutionTicksToSeconds(waitTicks),
+                         Time::highResolutionTicksToSeconds(endTicks - replyTicks),
+                         load, deadline > 0 && load > static_cast<float>(deadline) && ! pData->engine->isOffline());
+        }
 
         // --------------------------------------------------------------------------------------------------------
 
@@ -1875,6 +2178,20 @@ public:
         }
 
         waitForClient("buffersize", 1);
+
+        fLatencyNeedsReset = true;
+
+        // pipelined latency is one buffer, follow its size
+        if (const uint32_t latency = getLatencyInFrames())
+        {
+            const uint32_t channels(std::max(fInfo.aIns, fInfo.aOuts));
+
+            if (pData->latency.channels != channels || pData->latency.frames != latency)
+            {
+                pData->client->setLatency(latency);
+                pData->latency.recreateBuffers(channels, latency);
+            }
+        }
     }
 
     void sampleRateChanged(const double newSampleRate) override
@@ -1887,6 +2204,8 @@ public:
         }
 
         waitForClient("samplerate", 1);
+
+        fLatencyNeedsReset = true;
     }
 
     void offlineModeChanged(const bool isOffline) override
@@ -1981,6 +2300,15 @@ public:
 
     // -------------------------------------------------------------------
 
+    // get a string from the parameter bulk string area, null if out of bounds or not terminated
+    static const char* getBulkString(const char* const strings, const std::size_t size, const uint32_t offset) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(offset < size, nullptr);
+        CARLA_SAFE_ASSERT_RETURN(std::memchr(strings + offset, '\0', size - offset) != nullptr, nullptr);
+
+        return strings + offset;
+    }
+
     void handleNonRtData()
     {
         for (; fShmNonRtServerControl.isDataAvailableForReading();)
@@ -2215,9 +2543,81 @@ public:
                 {
                     const float fixedValue(pData->param.getFixedValue(index, value));
                     fParams[index].value = fixedValue;
+
+                    // we are already being idled, only mark the change
+                    pData->param.updateOutputValueRT(index, fixedValue);
                 }
             }   break;
 
+            case kPluginBridgeNonRtServerParameterDataBulk: {
+                // uint/count, uint/size, uint/size, str[] (shm size, shm name)
+                const uint32_t count    = fShmNonRtServerControl.readUInt();
+                const uint32_t dataSize = fShmNonRtServerControl.readUInt();
+
+                const uint32_t filenameSize(fShmNonRtServerControl.readUInt());
+                char filename[filenameSize+1];
+                carla_zeroChar(filename, filenameSize+1);
+                fShmNonRtServerControl.readCustomData(filename, filenameSize);
+
+                if (count == 0)
+                    break;
+
+                const std::size_t paramsSize(count*sizeof(BridgeParameterData));
+                CARLA_SAFE_ASSERT_BREAK(dataSize > paramsSize);
+
+                shm_t shm = carla_shm_attach(filename);
+                CARLA_SAFE_ASSERT_BREAK(carla_is_shm_valid(shm));
+
+                if (const uint8_t* const bulk = (const uint8_t*)carla_shm_map(shm, dataSize))
+                {
+                    const BridgeParameterData* const bulkData((const BridgeParameterData*)bulk);
+                    const char* const strings((const char*)(bulk + paramsSize));
+                    const std::size_t stringsSize(dataSize - paramsSize);
+
+                    for (uint32_t i=0; i < count; ++i)
+                    {
+                        const BridgeParameterData& paramData(bulkData[i]);
+                        const uint32_t index(paramData.index);
+
+                        CARLA_SAFE_ASSERT_CONTINUE(index < pData->param.count);
+                        CARLA_SAFE_ASSERT_CONTINUE(paramData.midiCC >= -1 && paramData.midiCC < MAX_MIDI_CONTROL);
+
+                        const char* const name(getBulkString(strings, stringsSize, paramData.nameOffset));
+                        const char* const symbol(getBulkString(strings, stringsSize, paramData.symbolOffset));
+                        const char* const unit(getBulkString(strings, stringsSize, paramData.unitOffset));
+                        CARLA_SAFE_ASSERT_CONTINUE(name != nullptr && symbol != nullptr && unit != nullptr);
+
+                        pData->param.data[index].type   = static_cast<ParameterType>(paramData.type);
+                        pData->param.data[index].index  = static_cast<int32_t>(index);
+                        pData->param.data[index].rindex = paramData.rindex;
+                        pData->param.data[index].hints  = paramData.hints;
+                        pData->param.data[index].midiCC = static_cast<int16_t>(paramData.midiCC);
+
+                        fParams[index].name   = name;
+                        fParams[index].symbol = symbol;
+                        fParams[index].unit   = unit;
+
+                        if (paramData.min < paramData.max && paramData.def >= paramData.min && paramData.def <= paramData.max)
+                        {
+                            pData->param.ranges[index].def = paramData.def;
+                            pData->param.ranges[index].min = paramData.min;
+                            pData->param.ranges[index].max = paramData.max;
+                            pData->param.ranges[index].step      = paramData.step;
+                            pData->param.ranges[index].stepSmall = paramData.stepSmall;
+                            pData->param.ranges[index].stepLarge = paramData.stepLarge;
+                        }
+
+                        const float fixedValue(pData->param.getFixedValue(index, paramData.value));
+                        fParams[index].value = fixedValue;
+                        pData->param.updateOutputValueRT(index, fixedValue);
+                    }
+
+                    carla_shm_unmap(shm, const_cast<uint8_t*>(bulk));
+                }
+
+                carla_shm_close(shm);
+            }   break;
+
             case kPluginBridgeNonRtServerDefaultValue: {
                 // uint/index, float/value
                 const uint32_t index = fShmNonRtServerControl.readUInt();
@@ -2361,6 +2761,56 @@ public:
                 }
             }   break;
 
+            case kPluginBridgeNonRtServerSetChunkDataShm: {
+                // ulong/size, uint/size, str[] (shm name)
+                const uint64_t chunkSize(fShmNonRtServerControl.readULong());
+
+                const uint32_t chunkShmNameSize(fShmNonRtServerControl.readUInt());
+                char chunkShmName[chunkShmNameSize+1];
+                carla_zeroChar(chunkShmName, chunkShmNameSize+1);
+                fShmNonRtServerControl.readCustomData(chunkShmName, chunkShmNameSize);
+
+                CARLA_SAFE_ASSERT(chunkSize > 0);
+
+                if (chunkSize > 0)
+                {
+                    shm_t chunkShm = carla_shm_attach(chunkShmName);
+                    CARLA_SAFE_ASSERT(carla_is_shm_valid(chunkShm));
+
+                    if (carla_is_shm_valid(chunkShm))
+                    {
+                        if (void* const chunk = carla_shm_map(chunkShm, static_cast<std::size_t>(chunkSize)))
+                        {
+                            fInfo.chunk.resize(static_cast<std::size_t>(chunkSize));
+                            std::memcpy(fInfo.chunk.data(), chunk, static_cast<std::size_t>(chunkSize));
+                            carla_shm_unmap(chunkShm, chunk);
+                        }
+
+                        carla_shm_close(chunkShm);
+                    }
+                }
+
+                // let the bridge free it, even if we failed to read it
+                const CarlaMutexLocker _cml(fShmNonRtClientControl.mutex);
+
+                fShmNonRtClientControl.writeOpcode(kPluginBridgeNonRtClientChunkDataShmRead);
+                fShmNonRtClientControl.writeUInt(chunkShmNameSize);
+                fShmNonRtClientControl.writeCustomData(chunkShmName, chunkShmNameSize);
+                fShmNonRtClientControl.commitWrite();
+            }   break;
+
+            case kPluginBridgeNonRtServerChunkDataShmRead: {
+                // uint/size, str[] (shm name)
+                const uint32_t chunkShmNameSize(fShmNonRtServerControl.readUInt());
+                char chunkShmName[chunkShmNameSize+1];
+                carla_zeroChar(chunkShmName, chunkShmNameSize+1);
+                fShmNonRtServerControl.readCustomData(chunkShmName, chunkShmNameSize);
+
+                // a newer chunk might have been sent meanwhile
+                if (fShmChunk.filename == chunkShmName)
+                    fShmChunk.clear();
+            }   break;
+
             case kPluginBridgeNonRtServerSetLatency: {
                 // uint
             }   break;
@@ -2406,6 +2856,17 @@ public:
 
     // -------------------------------------------------------------------
 
+    bool getBridgeLatency(PluginBridgeLatency& latency) const noexcept override
+    {
+        fLatency.get(latency);
+        return true;
+    }
+
+    void resetBridgeLatency() noexcept override
+    {
+        fLatencyNeedsReset = true;
+    }
+
     uintptr_t getUiBridgeProcessId() const noexcept override
     {
         return fBridgeThread.getProcessPID();
@@ -2422,6 +2883,8 @@ public:
     {
         CARLA_SAFE_ASSERT_RETURN(pData->engine != nullptr, false);
 
+        fPipelined = pData->engine->getOptions().pipelinedBridges;
+
         // ---------------------------------------------------------------
         // first checks
 
@@ -2461,7 +2924,7 @@ public:
             return false;
         }
 
-        if (! fShmRtClientControl.initialize())
+        if (! fShmRtClientControl.initialize(pData->engine->getOptions().lowLatencyBridges))
         {
             carla_stdout("Failed to initialize RT client control");
             fShmAudioPool.clear();
@@ -2592,8 +3055,18 @@ private:
     bool fTimedOut;
     bool fTimedError;
 
+    // render one block ahead, see processSingle()
+    bool fPipelined;
+    bool fProcessPending;
+    uint8_t fMidiOut[kBridgeRtClientDataMidiOutSize];
+
     int64_t fLastPongTime;
 
+    // round-trip timing of processed blocks, see processSingle()
+    BridgeLatencyStats fLatency;
+    bool fLatencyNeedsReset;  // cleared by the audio thread on its next block
+    uint32_t fLastSlowBlocks; // already reported through the engine callback
+
     CarlaString             fBridgeBinary;
     CarlaPluginBridgeThread fBridgeThread;
 
@@ -2601,6 +3074,7 @@ private:
     BridgeRtClientControl    fShmRtClientControl;
     BridgeNonRtClientControl fShmNonRtClientControl;
     BridgeNonRtServerControl fShmNonRtServerControl;
+    BridgeChunkShm           fShmChunk;
 
     struct Info {
         uint32_t aIns, aOuts;
@@ -2644,6 +3118,27 @@ private:
         fShmRtClientControl.commitWrite();
 
         waitForClient("resize-pool");
+
+        updateSharedAudioBuffers(bufferSize);
+    }
+
+    // in rack mode the engine uses the audio pool directly as the port buffers, no copies are needed then
+    void updateSharedAudioBuffers(const uint32_t bufferSize) noexcept
+    {
+        // not while pipelined, the bridge is then still using the pool while the engine runs
+        const bool useShared(pData->engine->getProccessMode() == ENGINE_PROCESS_MODE_CONTINUOUS_RACK && fShmAudioPool.data != nullptr && ! fPipelined);
+
+        for (uint32_t i=0; i < pData->audioIn.count; ++i)
+        {
+            if (CarlaEngineAudioPort* const port = pData->audioIn.ports[i].port)
+                port->setSharedBuffer(useShared ? fShmAudioPool.data + (i * bufferSize) : nullptr);
+        }
+
+        for (uint32_t i=0; i < pData->audioOut.count; ++i)
+        {
+            if (CarlaEngineAudioPort* const port = pData->audioOut.ports[i].port)
+                port->setSharedBuffer(useShared ? fShmAudioPool.data + ((i + fInfo.aIns) * bufferSize) : nullptr);
+        }
     }
 
     void waitForClient(const char* const action, const uint secs = 5)
@@ -2651,6 +3146,27 @@ private:
         CARLA_SAFE_ASSERT_RETURN(! fTimedOut,);
         CARLA_SAFE_ASSERT_RETURN(! fTimedError,);
 
+        // a pipelined block must be done before anything else is sent
+        if (fProcessPending)
+        {
+            waitForPendingBlock();
+
+            if (fTimedOut || fTimedError)
+                return;
+        }
+
+        fShmRtClientControl.postServer();
+        waitForClientReply(action, secs);
+    }
+
+    void waitForPendingBlock()
+    {
+        fProcessPending = false;
+        waitForClientReply("process", 1);
+    }
+
+    void waitForClientReply(const char* const action, const uint secs)
+    {
         if (fShmRtClientControl.waitForClient(secs, &fTimedOut))
             return;
 
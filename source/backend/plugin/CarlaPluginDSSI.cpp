@@ -454,6 +454,8 @@ public:
             options |= PLUGIN_OPTION_SEND_ALL_SOUND_OFF;
         }
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -1408,6 +1410,8 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Event Input and Processing
 
+        pData->subBlocks.addBlock();
+
         if (pData->event.portIn != nullptr)
         {
             // ----------------------------------------------------------------------------------------------------
@@ -1443,6 +1447,8 @@ public:
 #endif
             const bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
 
+            const uint32_t splitGranularity(pData->engine->getOptions().splitGranularity);
+
             uint32_t startTime  = 0;
             uint32_t timeOffset = 0;
             uint32_t nextBankId;
@@ -1461,7 +1467,9 @@ public:
 
                 CARLA_ASSERT_INT2(event.time >= timeOffset, event.time, timeOffset);
 
-                if (isSampleAccurate && event.time > timeOffset)
+                // events within the split granularity are merged into the current sub-block,
+                // splitting only when both sides get at least that many frames
+                if (isSampleAccurate && event.time >= timeOffset + splitGranularity && event.time + splitGranularity <= frames)
                 {
                     if (processSingle(audioIn, audioOut, cvIn, cvOut, event.time - timeOffset, timeOffset, midiEventCount))
                     {
@@ -1478,6 +1486,8 @@ public:
                         startTime += timeOffset;
                 }
 
+                const uint32_t eventTime(isSampleAccurate ? startTime + event.time - timeOffset : event.time);
+
                 switch (event.type)
                 {
                 case kEngineEventTypeNull:
@@ -1586,7 +1596,7 @@ public:
 
                             snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
 
-                            seqEvent.time.tick = isSampleAccurate ? startTime : event.time;
+                            seqEvent.time.tick = eventTime;
 
                             seqEvent.type = SND_SEQ_EVENT_CONTROLLER;
                             seqEvent.data.control.channel = event.channel;
@@ -1627,7 +1637,7 @@ public:
 
                             snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
 
-                            seqEvent.time.tick = isSampleAccurate ? startTime : event.time;
+                            seqEvent.time.tick = eventTime;
 
                             seqEvent.type = SND_SEQ_EVENT_CONTROLLER;
                             seqEvent.data.control.channel = event.channel;
@@ -1651,7 +1661,7 @@ public:
 
                             snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
 
-                            seqEvent.time.tick = isSampleAccurate ? startTime : event.time;
+                            seqEvent.time.tick = eventTime;
 
                             seqEvent.type = SND_SEQ_EVENT_CONTROLLER;
                             seqEvent.data.control.channel = event.channel;
@@ -1679,7 +1689,7 @@ public:
 
                     snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
 
-                    seqEvent.time.tick = isSampleAccurate ? startTime : event.time;
+                    seqEvent.time.tick = eventTime;
 
                     switch (status)
                     {
@@ -1810,16 +1820,18 @@ public:
                 }
             }
         }
+#endif
 #endif
 
         // --------------------------------------------------------------------------------------------------------
         // Control Output
 
-        if (pData->event.portOut != nullptr)
         {
+#ifndef BUILD_BRIDGE
             uint8_t  channel;
             uint16_t param;
             float    value;
+#endif
 
             for (uint32_t k=0; k < pData->param.count; ++k)
             {
@@ -1827,17 +1839,19 @@ public:
                     continue;
 
                 pData->param.ranges[k].fixValue(fParamBuffers[k]);
+                pData->setParameterOutputValueRT(k, fParamBuffers[k]);
 
-                if (pData->param.data[k].midiCC > 0)
+#ifndef BUILD_BRIDGE
+                if (pData->param.data[k].midiCC > 0 && pData->event.portOut != nullptr)
                 {
                     channel = pData->param.data[k].midiChannel;
                     param   = static_cast<uint16_t>(pData->param.data[k].midiCC);
                     value   = pData->param.ranges[k].getNormalizedValue(fParamBuffers[k]);
                     pData->event.portOut->writeControlEvent(0, channel, kEngineControlEventTypeParameter, param, value);
                 }
+#endif
             }
         } // End of Control Output
-#endif
     }
 
     bool processSingle(const float** const audioIn, float** const audioOut, const float** const cvIn, float** const cvOut, const uint32_t frames, const uint32_t timeOffset, const ulong midiEventCount)
@@ -1884,6 +1898,8 @@ public:
             return false;
         }
 
+        ++pData->subBlocks.runs;
+
         // --------------------------------------------------------------------------------------------------------
         // Set audio buffers
 
@@ -1936,81 +1952,11 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Post-processing (dry/wet, volume and balance)
 
-        {
-            const bool doDryWet  = (pData->hints & PLUGIN_CAN_DRYWET) != 0 && ! carla_compareFloats(pData->postProc.dryWet, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-            const bool isMono    = (pData->audioIn.count == 1);
-
-            bool isPair;
-            float bufValue, oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Dry/Wet
-                if (doDryWet)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-#if 0 // TODO
-                        if (k < pData->latency)
-                            bufValue = pData->latencyBuffers[isMono ? 0 : i][k];
-                        else if (pData->latency < frames)
-                            bufValue = fAudioInBuffers[isMono ? 0 : i][k-pData->latency];
-                        else
+        pData->postProcess(fAudioInBuffers, fAudioOutBuffers, frames, 0, false);
 #endif
-                            bufValue = fAudioInBuffers[isMono ? 0 : i][k];
-
-                        fAudioOutBuffers[i][k] = (fAudioOutBuffers[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
-                    }
-                }
-
-                // Balance
-                if (doBalance)
-                {
-                    isPair = (i % 2 == 0);
-
-                    if (isPair)
-                    {
-                        CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        FloatVectorOperations::copy(oldBufLeft, fAudioOutBuffers[i], static_cast<int>(frames));
-                    }
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (isPair)
-                        {
-                            // left
-                            fAudioOutBuffers[i][k]  = oldBufLeft[k]            * (1.0f - balRangeL);
-                            fAudioOutBuffers[i][k] += fAudioOutBuffers[i+1][k] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            fAudioOutBuffers[i][k]  = fAudioOutBuffers[i][k] * balRangeR;
-                            fAudioOutBuffers[i][k] += oldBufLeft[k]          * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume (and buffer copy)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k] * pData->postProc.volume;
-                }
-            }
 
-        } // End of Post-processing
-
-#else // BUILD_BRIDGE
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
-        {
-            for (uint32_t k=0; k < frames; ++k)
-                audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k];
-        }
-#endif
+            FloatVectorOperations::copy(audioOut[i]+timeOffset, fAudioOutBuffers[i], static_cast<int>(frames));
 
 #if 0
         for (uint32_t i=0; i < pData->cvOut.count; ++i)
@@ -2343,6 +2289,8 @@ public:
         for (uint32_t i=0; i < pData->param.count; ++i)
             osc_send_control(fOscData, pData->param.data[i].rindex, getParameterValue(i));
 
+        refreshParameterOutputs();
+
         if ((pData->hints & PLUGIN_HAS_CUSTOM_UI) != 0 && pData->engine->getOptions().frontendWinId != 0)
             pData->transientTryCounter = 1;
 
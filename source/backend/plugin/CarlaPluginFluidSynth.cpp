@@ -177,6 +177,8 @@ public:
         options |= PLUGIN_OPTION_SEND_PITCHBEND;
         options |= PLUGIN_OPTION_SEND_ALL_SOUND_OFF;
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -1353,7 +1355,6 @@ public:
 
         } // End of Event Input and Processing
 
-#ifndef BUILD_BRIDGE
         // --------------------------------------------------------------------------------------------------------
         // Control Output
 
@@ -1361,15 +1362,17 @@ public:
             uint32_t k = FluidSynthVoiceCount;
             fParamBuffers[k] = float(fluid_synth_get_active_voice_count(fSynth));
             pData->param.ranges[k].fixValue(fParamBuffers[k]);
+            pData->setParameterOutputValueRT(k, fParamBuffers[k]);
 
+#ifndef BUILD_BRIDGE
             if (pData->param.data[k].midiCC > 0)
             {
                 float value(pData->param.ranges[k].getNormalizedValue(fParamBuffers[k]));
                 pData->event.portOut->writeControlEvent(0, pData->param.data[k].midiChannel, kEngineControlEventTypeParameter, static_cast<uint16_t>(pData->param.data[k].midiCC), value);
             }
+#endif
 
         } // End of Control Output
-#endif
     }
 
     bool processSingle(float** const outBuffer, const uint32_t frames, const uint32_t timeOffset)
@@ -1409,68 +1412,17 @@ public:
         else
             fluid_synth_write_float(fSynth, static_cast<int>(frames), outBuffer[0] + timeOffset, 0, 1, outBuffer[1] + timeOffset, 0, 1);
 
-#ifndef BUILD_BRIDGE
-        // --------------------------------------------------------------------------------------------------------
-        // Post-processing (volume and balance)
-
-        {
-            // note - balance not possible with kUse16Outs, so we can safely skip fAudioOutBuffers
-            const bool doVolume  = (pData->hints & PLUGIN_CAN_VOLUME) != 0 && ! carla_compareFloats(pData->postProc.volume, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-
-            float oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Balance
-                if (doBalance)
-                {
-                    if (i % 2 == 0)
-                        FloatVectorOperations::copy(oldBufLeft, outBuffer[i]+timeOffset, static_cast<int>(frames));
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (i % 2 == 0)
-                        {
-                            // left
-                            outBuffer[i][k+timeOffset]  = oldBufLeft[k]                * (1.0f - balRangeL);
-                            outBuffer[i][k+timeOffset] += outBuffer[i+1][k+timeOffset] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            outBuffer[i][k+timeOffset]  = outBuffer[i][k+timeOffset] * balRangeR;
-                            outBuffer[i][k+timeOffset] += oldBufLeft[k]              * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume
-                if (kUse16Outs)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        outBuffer[i][k+timeOffset] = fAudio16Buffers[i][k] * pData->postProc.volume;
-                }
-                else if (doVolume)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        outBuffer[i][k+timeOffset] *= pData->postProc.volume;
-                }
-            }
-
-        } // End of Post-processing
-#else
         if (kUse16Outs)
         {
             for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                for (uint32_t k=0; k < frames; ++k)
-                    outBuffer[i][k+timeOffset] = fAudio16Buffers[i][k];
-            }
+                FloatVectorOperations::copy(outBuffer[i]+timeOffset, fAudio16Buffers[i], static_cast<int>(frames));
         }
+
+#ifndef BUILD_BRIDGE
+        // --------------------------------------------------------------------------------------------------------
+        // Post-processing (volume and balance)
+
+        pData->postProcess(nullptr, outBuffer, frames, timeOffset, false);
 #endif
 
         // --------------------------------------------------------------------------------------------------------
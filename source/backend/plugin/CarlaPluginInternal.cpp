@@ -182,7 +182,12 @@ PluginParameterData::PluginParameterData() noexcept
     : count(0),
       data(nullptr),
       ranges(nullptr),
-      special(nullptr) {}
+      special(nullptr),
+      outValues(nullptr),
+      outDirty(nullptr),
+      lastValues(nullptr),
+      generations(nullptr),
+      serial(0) {}
 
 PluginParameterData::~PluginParameterData() noexcept
 {
@@ -190,6 +195,10 @@ PluginParameterData::~PluginParameterData() noexcept
     CARLA_SAFE_ASSERT(data == nullptr);
     CARLA_SAFE_ASSERT(ranges == nullptr);
     CARLA_SAFE_ASSERT(special == nullptr);
+    CARLA_SAFE_ASSERT(outValues == nullptr);
+    CARLA_SAFE_ASSERT(outDirty == nullptr);
+    CARLA_SAFE_ASSERT(lastValues == nullptr);
+    CARLA_SAFE_ASSERT(generations == nullptr);
 }
 
 void PluginParameterData::createNew(const uint32_t newCount, const bool withSpecial)
@@ -198,6 +207,10 @@ void PluginParameterData::createNew(const uint32_t newCount, const bool withSpec
     CARLA_SAFE_ASSERT_RETURN(data == nullptr,);
     CARLA_SAFE_ASSERT_RETURN(ranges == nullptr,);
     CARLA_SAFE_ASSERT_RETURN(special == nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(outValues == nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(outDirty == nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(lastValues == nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(generations == nullptr,);
     CARLA_SAFE_ASSERT_RETURN(newCount > 0,);
 
     data = new ParameterData[newCount];
@@ -219,7 +232,20 @@ void PluginParameterData::createNew(const uint32_t newCount, const bool withSpec
         carla_zeroStruct(special, newCount);
     }
 
+    outValues = new float[newCount];
+    carla_zeroFloat(outValues, newCount);
+
+    // juce::Atomic starts as 0
+    outDirty = new juce::Atomic<int>[(newCount+31)/32];
+
+    lastValues = new float[newCount];
+    carla_zeroFloat(lastValues, newCount);
+
+    generations = new uint32_t[newCount];
+    carla_zeroStruct(generations, newCount);
+
     count = newCount;
+    ++serial;
 }
 
 void PluginParameterData::clear() noexcept
@@ -242,7 +268,32 @@ void PluginParameterData::clear() noexcept
         special = nullptr;
     }
 
+    if (outValues != nullptr)
+    {
+        delete[] outValues;
+        outValues = nullptr;
+    }
+
+    if (outDirty != nullptr)
+    {
+        delete[] outDirty;
+        outDirty = nullptr;
+    }
+
+    if (lastValues != nullptr)
+    {
+        delete[] lastValues;
+        lastValues = nullptr;
+    }
+
+    if (generations != nullptr)
+    {
+        delete[] generations;
+        generations = nullptr;
+    }
+
     count = 0;
+    ++serial;
 }
 
 float PluginParameterData::getFixedValue(const uint32_t parameterId, const float& value) const noexcept
@@ -251,13 +302,66 @@ float PluginParameterData::getFixedValue(const uint32_t parameterId, const float
     return ranges[parameterId].getFixedValue(value);
 }
 
+// returns true if the parameter was not marked as changed yet
+bool PluginParameterData::updateOutputValueRT(const uint32_t parameterId, const float value) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(parameterId < count, false);
+
+    if (carla_compareFloats(outValues[parameterId], value))
+        return false;
+
+    outValues[parameterId] = value;
+
+    juce::Atomic<int>& dirty(outDirty[parameterId/32]);
+    const int bit(static_cast<int>(1U << (parameterId % 32)));
+
+    for (int old;;)
+    {
+        old = dirty.get();
+
+        if (old & bit)
+            return false;
+        if (dirty.compareAndSetBool(old | bit, old))
+            return true;
+    }
+}
+
+bool PluginParameterData::takeOutputChanged(const uint32_t parameterId) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(parameterId < count, false);
+
+    juce::Atomic<int>& dirty(outDirty[parameterId/32]);
+    const int bit(static_cast<int>(1U << (parameterId % 32)));
+
+    for (int old;;)
+    {
+        old = dirty.get();
+
+        if ((old & bit) == 0)
+            return false;
+        if (dirty.compareAndSetBool(old & ~bit, old))
+            return true;
+    }
+}
+
+// only output parameters are ever checked, so marking every bit is fine
+void PluginParameterData::markOutputsChanged() noexcept
+{
+    if (outDirty == nullptr)
+        return;
+
+    for (uint32_t i=0, words=(count+31)/32; i < words; ++i)
+        outDirty[i] = -1;
+}
+
 // -----------------------------------------------------------------------
 // PluginProgramData
 
 PluginProgramData::PluginProgramData() noexcept
     : count(0),
       current(-1),
-      names(nullptr) {}
+      names(nullptr),
+      serial(0) {}
 
 PluginProgramData::~PluginProgramData() noexcept
 {
@@ -278,6 +382,7 @@ void PluginProgramData::createNew(const uint32_t newCount)
 
     count   = newCount;
     current = -1;
+    ++serial;
 }
 
 void PluginProgramData::clear() noexcept
@@ -299,6 +404,7 @@ void PluginProgramData::clear() noexcept
 
     count   = 0;
     current = -1;
+    ++serial;
 }
 
 // -----------------------------------------------------------------------
@@ -307,7 +413,8 @@ void PluginProgramData::clear() noexcept
 PluginMidiProgramData::PluginMidiProgramData() noexcept
     : count(0),
       current(-1),
-      data(nullptr) {}
+      data(nullptr),
+      serial(0) {}
 
 PluginMidiProgramData::~PluginMidiProgramData() noexcept
 {
@@ -328,6 +435,7 @@ void PluginMidiProgramData::createNew(const uint32_t newCount)
 
     count   = newCount;
     current = -1;
+    ++serial;
 }
 
 void PluginMidiProgramData::clear() noexcept
@@ -349,6 +457,7 @@ void PluginMidiProgramData::clear() noexcept
 
     count   = 0;
     current = -1;
+    ++serial;
 }
 
 const MidiProgramData& PluginMidiProgramData::getCurrent() const noexcept
@@ -390,6 +499,7 @@ void CarlaPlugin::ProtectedData::ExternalNotes::clear() noexcept
 CarlaPlugin::ProtectedData::Latency::Latency() noexcept
     : channels(0),
       frames(0),
+      position(0),
       buffers(nullptr) {}
 
 CarlaPlugin::ProtectedData::Latency::~Latency() noexcept
@@ -415,6 +525,7 @@ void CarlaPlugin::ProtectedData::Latency::clearBuffers() noexcept
 
     channels = 0;
     frames   = 0;
+    position = 0;
 }
 
 void CarlaPlugin::ProtectedData::Latency::recreateBuffers(const uint32_t newChannels, const uint32_t newFrames)
@@ -438,6 +549,7 @@ void CarlaPlugin::ProtectedData::Latency::recreateBuffers(const uint32_t newChan
 
     channels = newChannels;
     frames   = newFrames;
+    position = 0;
 
     if (channels > 0 && frames > 0)
     {
@@ -451,6 +563,92 @@ void CarlaPlugin::ProtectedData::Latency::recreateBuffers(const uint32_t newChan
     }
 }
 
+void CarlaPlugin::ProtectedData::Latency::resetBuffers() noexcept
+{
+    position = 0;
+
+    if (buffers == nullptr)
+        return;
+
+    for (uint32_t i=0; i < channels; ++i)
+        FloatVectorOperations::clear(buffers[i], static_cast<int>(frames));
+}
+
+// push the newest 'numFrames' samples, dropping the oldest ones
+void CarlaPlugin::ProtectedData::Latency::writeBuffers(const float* const* const inBuffers, const uint32_t inCount, const uint32_t numFrames) noexcept
+{
+    if (buffers == nullptr || numFrames == 0)
+        return;
+
+    const uint32_t count(std::min(inCount, channels));
+
+    if (numFrames >= frames)
+    {
+        // only the last 'frames' samples are kept
+        for (uint32_t i=0; i < count; ++i)
+            FloatVectorOperations::copy(buffers[i], inBuffers[i] + (numFrames - frames), static_cast<int>(frames));
+
+        position = 0;
+        return;
+    }
+
+    const uint32_t first(std::min(numFrames, frames - position));
+
+    for (uint32_t i=0; i < count; ++i)
+    {
+        FloatVectorOperations::copy(buffers[i] + position, inBuffers[i], static_cast<int>(first));
+
+        if (first < numFrames)
+            FloatVectorOperations::copy(buffers[i], inBuffers[i] + first, static_cast<int>(numFrames - first));
+    }
+
+    position = (position + numFrames) % frames;
+}
+
+// -----------------------------------------------------------------------
+// ProtectedData::Silence
+
+CarlaPlugin::ProtectedData::Silence::Silence() noexcept
+    : sleeping(false),
+      silentFrames(0),
+      tailFrames(0) {}
+
+void CarlaPlugin::ProtectedData::Silence::reset() noexcept
+{
+    sleeping     = false;
+    silentFrames = 0;
+}
+
+// -----------------------------------------------------------------------
+// ProtectedData::Generations
+
+CarlaPlugin::ProtectedData::Generations::Generations() noexcept
+    : current(0),
+      layout(0),
+      paramSerial(0),
+      progSerial(0),
+      midiprogSerial(0) {}
+
+// -----------------------------------------------------------------------
+// ProtectedData::SubBlocks
+
+CarlaPlugin::ProtectedData::SubBlocks::SubBlocks() noexcept
+    : blocks(0),
+      runs(0),
+      needsReset(false) {}
+
+void CarlaPlugin::ProtectedData::SubBlocks::addBlock() noexcept
+{
+    if (needsReset)
+    {
+        needsReset = false;
+        blocks = 0;
+        runs   = 0;
+    }
+
+    ++blocks;
+}
+
 // -----------------------------------------------------------------------
 // ProtectedData::PostRtEvents
 
@@ -523,7 +721,11 @@ CarlaPlugin::ProtectedData::PostProc::PostProc() noexcept
       volume(1.0f),
       balanceLeft(-1.0f),
       balanceRight(1.0f),
-      panning(0.0f) {}
+      panning(0.0f),
+      lastDryWet(1.0f),
+      lastVolume(1.0f),
+      lastBalanceLeft(-1.0f),
+      lastBalanceRight(1.0f) {}
 #endif
 
 // -----------------------------------------------------------------------
@@ -558,8 +760,12 @@ CarlaPlugin::ProtectedData::ProtectedData(CarlaEngine* const eng, const uint idx
       masterMutex(),
       singleMutex(),
       stateSave(),
+      idleRequested(),
       extNotes(),
       latency(),
+      silence(),
+      generations(),
+      subBlocks(),
       postRtEvents(),
       postUiEvents(),
 #ifndef BUILD_BRIDGE
@@ -679,6 +885,7 @@ void CarlaPlugin::ProtectedData::postponeRtEvent(const PluginPostRtEvent& rtEven
     CARLA_SAFE_ASSERT_RETURN(rtEvent.type != kPluginPostRtEventNull,);
 
     postRtEvents.appendRT(rtEvent);
+    requestIdleRT();
 }
 
 void CarlaPlugin::ProtectedData::postponeRtEvent(const PluginPostRtEventType type, const int32_t value1, const int32_t value2, const float value3) noexcept
@@ -688,8 +895,183 @@ void CarlaPlugin::ProtectedData::postponeRtEvent(const PluginPostRtEventType typ
     PluginPostRtEvent rtEvent = { type, value1, value2, value3 };
 
     postRtEvents.appendRT(rtEvent);
+    requestIdleRT();
+}
+
+// -----------------------------------------------------------------------
+// Idle requests
+
+void CarlaPlugin::ProtectedData::requestIdleRT() noexcept
+{
+    // only the first request after an idle pass wakes up the engine thread
+    if (idleRequested.compareAndSetBool(1, 0))
+        engine->wakeUpIdleThread();
+}
+
+void CarlaPlugin::ProtectedData::setParameterOutputValueRT(const uint32_t parameterId, const float value) noexcept
+{
+    if (param.updateOutputValueRT(parameterId, value))
+        requestIdleRT();
+}
+
+#ifndef BUILD_BRIDGE
+// -----------------------------------------------------------------------
+// Post-processing
+
+// mix 'dry' into 'out', with wet gain going from 'wet' in steps of 'wetStep'
+static void carla_mixDryWet(float* const out, const float* const dry, float wet, const float wetStep, const uint32_t frames) noexcept
+{
+    if (frames == 0)
+        return;
+
+    if (carla_isZero(wetStep))
+    {
+        FloatVectorOperations::multiply(out, wet, static_cast<int>(frames));
+        FloatVectorOperations::addWithMultiply(out, dry, 1.0f - wet, static_cast<int>(frames));
+        return;
+    }
+
+    for (uint32_t k=0; k < frames; ++k)
+    {
+        wet += wetStep;
+        out[k] = dry[k] + (out[k] - dry[k]) * wet;
+    }
 }
 
+/*
+ * Apply dry/wet, balance and volume to the plugin outputs, in place.
+ * Values changed since the previous call are ramped linearly over the block, unchanged values at identity are skipped.
+ * When 'withLatency' is true, the dry signal is delayed using the latency buffers.
+ */
+void CarlaPlugin::ProtectedData::postProcess(const float* const* const inBuffers, float* const* const outBuffers,
+                                             const uint32_t frames, const uint32_t timeOffset, const bool withLatency) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(outBuffers != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(frames > 0,);
+
+    // the values may be changed from another thread, read them only once
+    const float dryWet(postProc.dryWet);
+    const float volume(postProc.volume);
+    const float balanceLeft(postProc.balanceLeft);
+    const float balanceRight(postProc.balanceRight);
+
+    const bool doDryWet  = (hints & PLUGIN_CAN_DRYWET) != 0 && inBuffers != nullptr && audioIn.count > 0
+                         && ! (carla_compareFloats(dryWet, 1.0f) && carla_compareFloats(postProc.lastDryWet, 1.0f));
+    const bool doBalance = (hints & PLUGIN_CAN_BALANCE) != 0
+                         && ! (carla_compareFloats(balanceLeft,  -1.0f) && carla_compareFloats(postProc.lastBalanceLeft,  -1.0f)
+                            && carla_compareFloats(balanceRight,  1.0f) && carla_compareFloats(postProc.lastBalanceRight,  1.0f));
+    const bool doVolume  = (hints & PLUGIN_CAN_VOLUME) != 0
+                         && ! (carla_compareFloats(volume, 1.0f) && carla_compareFloats(postProc.lastVolume, 1.0f));
+
+    const float fframes(static_cast<float>(frames));
+    const int   iframes(static_cast<int>(frames));
+
+    // Dry/Wet
+    if (doDryWet)
+    {
+        const float    wetStep((dryWet - postProc.lastDryWet) / fframes);
+        const uint32_t latFrames((withLatency && latency.buffers != nullptr) ? std::min(latency.frames, frames) : 0);
+
+        for (uint32_t i=0; i < audioOut.count; ++i)
+        {
+            const uint32_t c((i < audioIn.count) ? i : 0);
+            float* const out(outBuffers[i] + timeOffset);
+
+            if (latFrames > 0 && c < latency.channels)
+            {
+                // oldest samples first, they may wrap around the end of the ring buffer
+                const uint32_t first(std::min(latFrames, latency.frames - latency.position));
+
+                carla_mixDryWet(out, latency.buffers[c] + latency.position, postProc.lastDryWet, wetStep, first);
+                carla_mixDryWet(out + first, latency.buffers[c], postProc.lastDryWet + wetStep * static_cast<float>(first), wetStep, latFrames - first);
+                carla_mixDryWet(out + latFrames, inBuffers[c] + timeOffset, postProc.lastDryWet + wetStep * static_cast<float>(latFrames), wetStep, frames - latFrames);
+            }
+            else
+            {
+                carla_mixDryWet(out, inBuffers[c] + timeOffset, postProc.lastDryWet, wetStep, frames);
+            }
+        }
+    }
+
+    // Balance, on each output pair
+    if (doBalance)
+    {
+        const float balRangeL((balanceLeft  + 1.0f)/2.0f);
+        const float balRangeR((balanceRight + 1.0f)/2.0f);
+        const float lastRangeL((postProc.lastBalanceLeft  + 1.0f)/2.0f);
+        const float lastRangeR((postProc.lastBalanceRight + 1.0f)/2.0f);
+        const bool  ramp(! (carla_compareFloats(balRangeL, lastRangeL) && carla_compareFloats(balRangeR, lastRangeR)));
+
+        float oldBufLeft[ramp ? 1 : frames];
+
+        for (uint32_t i=0; i+1 < audioOut.count; i += 2)
+        {
+            float* const outL(outBuffers[i]   + timeOffset);
+            float* const outR(outBuffers[i+1] + timeOffset);
+
+            if (ramp)
+            {
+                const float stepL((balRangeL - lastRangeL) / fframes);
+                const float stepR((balRangeR - lastRangeR) / fframes);
+                float rangeL(lastRangeL), rangeR(lastRangeR), left;
+
+                for (uint32_t k=0; k < frames; ++k)
+                {
+                    rangeL += stepL;
+                    rangeR += stepR;
+
+                    left    = outL[k];
+                    outL[k] = left * (1.0f - rangeL) + outR[k] * (1.0f - rangeR);
+                    outR[k] = left * rangeL          + outR[k] * rangeR;
+                }
+            }
+            else
+            {
+                FloatVectorOperations::copy(oldBufLeft, outL, iframes);
+
+                // left
+                FloatVectorOperations::multiply(outL, 1.0f - balRangeL, iframes);
+                FloatVectorOperations::addWithMultiply(outL, outR, 1.0f - balRangeR, iframes);
+
+                // right
+                FloatVectorOperations::multiply(outR, balRangeR, iframes);
+                FloatVectorOperations::addWithMultiply(outR, oldBufLeft, balRangeL, iframes);
+            }
+        }
+    }
+
+    // Volume
+    if (doVolume)
+    {
+        const float volumeStep((volume - postProc.lastVolume) / fframes);
+
+        for (uint32_t i=0; i < audioOut.count; ++i)
+        {
+            float* const out(outBuffers[i] + timeOffset);
+
+            if (carla_isZero(volumeStep))
+            {
+                FloatVectorOperations::multiply(out, volume, iframes);
+                continue;
+            }
+
+            float gain(postProc.lastVolume);
+
+            for (uint32_t k=0; k < frames; ++k)
+            {
+                gain += volumeStep;
+                out[k] *= gain;
+            }
+        }
+    }
+
+    postProc.lastDryWet       = dryWet;
+    postProc.lastVolume       = volume;
+    postProc.lastBalanceLeft  = balanceLeft;
+    postProc.lastBalanceRight = balanceRight;
+}
+#endif
+
 // -----------------------------------------------------------------------
 // Library functions
 
@@ -168,12 +168,20 @@ struct PluginParameterData {
     ParameterData* data;
     ParameterRanges* ranges;
     SpecialParameterType* special;
+    float* outValues;             // last output values seen by the audio thread
+    juce::Atomic<int>* outDirty;  // changed output parameters, 32 per entry
+    float* lastValues;            // values seen by the last generation update, non-RT
+    uint32_t* generations;        // generation in which each parameter last changed value
+    uint32_t serial;              // bumped whenever the parameters are recreated or cleared
 
     PluginParameterData() noexcept;
     ~PluginParameterData() noexcept;
     void createNew(const uint32_t newCount, const bool withSpecial);
     void clear() noexcept;
     float getFixedValue(const uint32_t parameterId, const float& value) const noexcept;
+    bool updateOutputValueRT(const uint32_t parameterId, const float value) noexcept;
+    bool takeOutputChanged(const uint32_t parameterId) noexcept;
+    void markOutputsChanged() noexcept;
 
     CARLA_DECLARE_NON_COPY_STRUCT(PluginParameterData)
 };
@@ -186,6 +194,7 @@ struct PluginProgramData {
     uint32_t count;
     int32_t current;
     ProgramName* names;
+    uint32_t serial; // bumped whenever the programs are recreated or cleared
 
     PluginProgramData() noexcept;
     ~PluginProgramData() noexcept;
@@ -201,6 +210,7 @@ struct PluginMidiProgramData {
     uint32_t count;
     int32_t current;
     MidiProgramData* data;
+    uint32_t serial; // bumped whenever the programs are recreated or cleared
 
     PluginMidiProgramData() noexcept;
     ~PluginMidiProgramData() noexcept;
@@ -255,6 +265,8 @@ struct CarlaPlugin::ProtectedData {
 
     CarlaStateSave stateSave;
 
+    juce::Atomic<int> idleRequested; // set by the audio thread, cleared by the engine idle thread
+
     struct ExternalNotes {
         CarlaMutex mutex;
         RtLinkedList<ExternalMidiNote>::Pool dataPool;
@@ -269,20 +281,68 @@ struct CarlaPlugin::ProtectedData {
 
     } extNotes;
 
+    // delay line for the dry signal, as a ring buffer of 'frames' samples per channel
     struct Latency {
         uint32_t channels;
         uint32_t frames;
+        uint32_t position; // oldest sample, where the next write starts
         float**  buffers;
 
         Latency() noexcept;
         ~Latency() noexcept;
         void clearBuffers() noexcept;
         void recreateBuffers(const uint32_t newChannels, const uint32_t newFrames);
+        void resetBuffers() noexcept;
+        void writeBuffers(const float* const* const inBuffers, const uint32_t inCount, const uint32_t numFrames) noexcept;
 
         CARLA_DECLARE_NON_COPY_STRUCT(Latency)
 
     } latency;
 
+    // silence detection, see PLUGIN_OPTION_SKIP_SILENCE
+    struct Silence {
+        bool     sleeping;
+        uint32_t silentFrames; // consecutive frames of silent input
+        uint32_t tailFrames;   // cached getTailLengthInFrames(), updated outside the audio thread
+
+        Silence() noexcept;
+        void reset() noexcept;
+
+        CARLA_DECLARE_NON_COPY_STRUCT(Silence)
+
+    } silence;
+
+    // value generations for plugin snapshots, see CarlaPlugin::updateGenerations()
+    struct Generations {
+        uint32_t current;
+        uint32_t layout;
+        uint32_t paramSerial;
+        uint32_t progSerial;
+        uint32_t midiprogSerial;
+
+        Generations() noexcept;
+
+        CARLA_DECLARE_NON_COPY_STRUCT(Generations)
+
+    } generations;
+
+    // block splitting at event times, see ENGINE_OPTION_SPLIT_GRANULARITY
+    // counters are written by the audio thread only, and wrap around
+    struct SubBlocks {
+        uint32_t blocks; // audio blocks processed
+        uint32_t runs;   // plugin runs for those blocks
+        bool needsReset; // set by other threads, counters are cleared on the next block
+
+        SubBlocks() noexcept;
+
+        // count a new audio block
+        // @note RT call
+        void addBlock() noexcept;
+
+        CARLA_DECLARE_NON_COPY_STRUCT(SubBlocks)
+
+    } subBlocks;
+
     struct PostRtEvents {
         CarlaMutex mutex;
         RtLinkedList<PluginPostRtEvent>::Pool dataPool;
@@ -320,6 +380,12 @@ struct CarlaPlugin::ProtectedData {
         float balanceRight;
         float panning;
 
+        // values used in the previous block, new ones are ramped from these
+        float lastDryWet;
+        float lastVolume;
+        float lastBalanceLeft;
+        float lastBalanceRight;
+
         PostProc() noexcept;
 
         CARLA_DECLARE_NON_COPY_STRUCT(PostProc)
@@ -341,6 +407,20 @@ struct CarlaPlugin::ProtectedData {
     void postponeRtEvent(const PluginPostRtEvent& rtEvent) noexcept;
     void postponeRtEvent(const PluginPostRtEventType type, const int32_t value1, const int32_t value2, const float value3) noexcept;
 
+    // -------------------------------------------------------------------
+    // Idle requests
+
+    void requestIdleRT() noexcept;
+    void setParameterOutputValueRT(const uint32_t parameterId, const float value) noexcept;
+
+#ifndef BUILD_BRIDGE
+    // -------------------------------------------------------------------
+    // Post-processing
+
+    void postProcess(const float* const* const inBuffers, float* const* const outBuffers,
+                     const uint32_t frames, const uint32_t timeOffset, const bool withLatency) noexcept;
+#endif
+
     // -------------------------------------------------------------------
     // Library functions
 
@@ -106,6 +106,15 @@ public:
         return fDesc.uid;
     }
 
+    uint32_t getTailLengthInFrames() const noexcept override
+    {
+        CARLA_SAFE_ASSERT_RETURN(fInstance != nullptr, 0);
+
+        const double tail(fInstance->getTailLengthSeconds());
+
+        return tail > 0.0 ? static_cast<uint32_t>(tail * pData->engine->getSampleRate()) : 0;
+    }
+
     // -------------------------------------------------------------------
     // Information (count)
 
@@ -157,6 +166,8 @@ public:
             options |= PLUGIN_OPTION_SEND_ALL_SOUND_OFF;
         }
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -1018,6 +1029,13 @@ public:
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
             FloatVectorOperations::copy(outBuffer[i], fAudioBuffer.getReadPointer(static_cast<int>(i)), static_cast<int>(frames));
 
+#ifndef BUILD_BRIDGE
+        // --------------------------------------------------------------------------------------------------------
+        // Post-processing (dry/wet, volume and balance)
+
+        pData->postProcess(inBuffer, outBuffer, frames, 0, false);
+#endif
+
         // --------------------------------------------------------------------------------------------------------
         // Midi out
 
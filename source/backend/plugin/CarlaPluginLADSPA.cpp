@@ -201,6 +201,8 @@ public:
                 options |= PLUGIN_OPTION_FORCE_STEREO;
         }
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -925,6 +927,8 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Event Input and Processing
 
+        pData->subBlocks.addBlock();
+
         if (pData->event.portIn != nullptr)
         {
             // ----------------------------------------------------------------------------------------------------
@@ -932,6 +936,8 @@ public:
 
             const bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
 
+            const uint32_t splitGranularity(pData->engine->getOptions().splitGranularity);
+
             uint32_t numEvents  = pData->event.portIn->getEventCount();
             uint32_t timeOffset = 0;
 
@@ -944,7 +950,9 @@ public:
 
                 CARLA_ASSERT_INT2(event.time >= timeOffset, event.time, timeOffset);
 
-                if (isSampleAccurate && event.time > timeOffset)
+                // events within the split granularity are merged into the current sub-block,
+                // splitting only when both sides get at least that many frames
+                if (isSampleAccurate && event.time >= timeOffset + splitGranularity && event.time + splitGranularity <= frames)
                 {
                     if (processSingle(audioIn, audioOut, event.time - timeOffset, timeOffset))
                         timeOffset = event.time;
@@ -1081,7 +1089,6 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Control Output
 
-        if (pData->event.portOut != nullptr)
         {
             uint8_t  channel;
             uint16_t param;
@@ -1093,8 +1100,9 @@ public:
                     continue;
 
                 pData->param.ranges[k].fixValue(fParamBuffers[k]);
+                pData->setParameterOutputValueRT(k, fParamBuffers[k]);
 
-                if (pData->param.data[k].midiCC > 0)
+                if (pData->param.data[k].midiCC > 0 && pData->event.portOut != nullptr)
                 {
                     channel = pData->param.data[k].midiChannel;
                     param   = static_cast<uint16_t>(pData->param.data[k].midiCC);
@@ -1136,6 +1144,8 @@ public:
             return false;
         }
 
+        ++pData->subBlocks.runs;
+
         const int iframes(static_cast<int>(frames));
 
         // --------------------------------------------------------------------------------------------------------
@@ -1143,12 +1153,7 @@ public:
 
         if (pData->needsReset)
         {
-            if (pData->latency.frames > 0)
-            {
-                for (uint32_t i=0; i < pData->audioIn.count; ++i)
-                    FloatVectorOperations::clear(pData->latency.buffers[i], static_cast<int>(pData->latency.frames));
-            }
-
+            pData->latency.resetBuffers();
             pData->needsReset = false;
         }
 
@@ -1208,110 +1213,16 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Post-processing (dry/wet, volume and balance)
 
-        {
-            const bool doDryWet  = (pData->hints & PLUGIN_CAN_DRYWET) != 0 && ! carla_compareFloats(pData->postProc.dryWet, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-            const bool isMono    = (pData->audioIn.count == 1);
-
-            bool isPair;
-            float bufValue, oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Dry/Wet
-                if (doDryWet)
-                {
-                    const uint32_t c = isMono ? 0 : i;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (k < pData->latency.frames)
-                            bufValue = pData->latency.buffers[c][k];
-                        else if (pData->latency.frames < frames)
-                            bufValue = fAudioInBuffers[c][k-pData->latency.frames];
-                        else
-                            bufValue = fAudioInBuffers[c][k];
-
-                        fAudioOutBuffers[i][k] = (fAudioOutBuffers[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
-                    }
-                }
-
-                // Balance
-                if (doBalance)
-                {
-                    isPair = (i % 2 == 0);
-
-                    if (isPair)
-                    {
-                        CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        FloatVectorOperations::copy(oldBufLeft, fAudioOutBuffers[i], iframes);
-                    }
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (isPair)
-                        {
-                            // left
-                            fAudioOutBuffers[i][k]  = oldBufLeft[k]            * (1.0f - balRangeL);
-                            fAudioOutBuffers[i][k] += fAudioOutBuffers[i+1][k] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            fAudioOutBuffers[i][k]  = fAudioOutBuffers[i][k] * balRangeR;
-                            fAudioOutBuffers[i][k] += oldBufLeft[k]          * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume (and buffer copy)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k] * pData->postProc.volume;
-                }
-            }
-
-        } // End of Post-processing
+        pData->postProcess(fAudioInBuffers, fAudioOutBuffers, frames, 0, true);
+#endif
 
-#else // BUILD_BRIDGE
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
-        {
-            for (uint32_t k=0; k < frames; ++k)
-                audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k];
-        }
-#endif
+            FloatVectorOperations::copy(audioOut[i]+timeOffset, fAudioOutBuffers[i], iframes);
 
         // --------------------------------------------------------------------------------------------------------
         // Save latency values for next callback
 
-        if (const uint32_t latframes = pData->latency.frames)
-        {
-            CARLA_SAFE_ASSERT(timeOffset == 0);
-
-            if (latframes <= frames)
-            {
-                for (uint32_t i=0; i < pData->audioIn.count; ++i)
-                    FloatVectorOperations::copy(pData->latency.buffers[i], audioIn[i]+(frames-latframes), static_cast<int>(latframes));
-            }
-            else
-            {
-                const uint32_t diff = pData->latency.frames-frames;
-
-                for (uint32_t i=0, k; i<pData->audioIn.count; ++i)
-                {
-                    // push back buffer by 'frames'
-                    for (k=0; k < diff; ++k)
-                        pData->latency.buffers[i][k] = pData->latency.buffers[i][k+frames];
-
-                    // put current input at the end
-                    for (uint32_t j=0; k < latframes; ++j, ++k)
-                        pData->latency.buffers[i][k] = audioIn[i][j];
-                }
-            }
-        }
+        pData->latency.writeBuffers(fAudioInBuffers, pData->audioIn.count, frames);
 
         // --------------------------------------------------------------------------------------------------------
 
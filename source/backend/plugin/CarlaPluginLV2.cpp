@@ -29,6 +29,7 @@
 #include "CarlaPipeUtils.hpp"
 #include "CarlaPluginUI.hpp"
 #include "Lv2AtomRingBuffer.hpp"
+#include "Lv2UridMap.hpp"
 
 #include "../engine/CarlaEngineOsc.hpp"
 
@@ -39,6 +40,7 @@ extern "C" {
 #include "juce_core.h"
 
 using juce::File;
+using juce::SharedResourcePointer;
 
 #define URI_CARLA_ATOM_WORKER "http://kxstudio.sf.net/ns/carla/atomWorker"
 
@@ -380,6 +382,14 @@ struct CarlaPluginLV2Options {
     CARLA_DECLARE_NON_COPY_STRUCT(CarlaPluginLV2Options);
 };
 
+// -----------------------------------------------------
+// URIDs shared by all LV2 plugins, static ones are handled separately
+
+struct CarlaPluginLV2UridMap : public Lv2UridMap {
+    CarlaPluginLV2UridMap() noexcept
+        : Lv2UridMap(CARLA_URI_MAP_ID_COUNT) {}
+};
+
 // -----------------------------------------------------------------------
 
 class CarlaPluginLV2;
@@ -512,12 +522,17 @@ public:
           fLatencyIndex(-1),
           fAtomBufferIn(),
           fAtomBufferOut(),
+          fAtomBufferWorker(),
+          fWorkerPending(),
+          fWorkerNeedsSchedule(false),
+          fWorkerMutex(),
           fAtomForge(),
           fEventsIn(),
           fEventsOut(),
           fLv2Options(),
           fPipeServer(engine, this),
-          fCustomURIDs(),
+          fUridMap(),
+          fUridsSentToUI(CARLA_URI_MAP_ID_COUNT),
           fFirstActive(true),
           fLastStateChunk(nullptr),
           fLastTimeInfo(),
@@ -529,9 +544,6 @@ public:
 
         carla_zeroPointers(fFeatures, kFeatureCountAll+1);
 
-        for (uint32_t i=0; i < CARLA_URI_MAP_ID_COUNT; ++i)
-            fCustomURIDs.append(nullptr);
-
 #if defined(__clang__)
 # pragma clang diagnostic push
 # pragma clang diagnostic ignored "-Wdeprecated-declarations"
@@ -618,6 +630,9 @@ public:
             pData->active = false;
         }
 
+        if (fExt.worker != nullptr)
+            pData->engine->cancelWork(this);
+
         if (fDescriptor != nullptr)
         {
             if (fDescriptor->cleanup != nullptr)
@@ -684,16 +699,6 @@ public:
             }
         }
 
-        for (LinkedList<const char*>::Itenerator it = fCustomURIDs.begin(); it.valid(); it.next())
-        {
-            const char* const uri(it.getValue());
-
-            if (uri != nullptr)
-                delete[] uri;
-        }
-
-        fCustomURIDs.clear();
-
         if (fLastStateChunk != nullptr)
         {
             std::free(fLastStateChunk);
@@ -844,6 +849,8 @@ public:
             options |= PLUGIN_OPTION_SEND_ALL_SOUND_OFF;
         }
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -1146,6 +1153,7 @@ public:
 
             {
                 const ScopedSingleProcessLocker spl(this, true);
+                const CarlaMutexLocker cmlw(fWorkerMutex);
 
                 try {
                     status = fExt.state->restore(fHandle, carla_lv2_state_retrieve, this, 0, fFeatures);
@@ -1193,9 +1201,13 @@ public:
 
         if (index >= 0 && index < static_cast<int32_t>(fRdfDescriptor->PresetCount))
         {
-            if (LilvState* const state = Lv2WorldClass::getInstance().getStateFromURI(fRdfDescriptor->Presets[index].URI, (const LV2_URID_Map*)fFeatures[kFeatureIdUridMap]->data))
+            Lv2WorldClass& lv2World(Lv2WorldClass::getInstance());
+            lv2World.initIfNeeded(getLv2Path(), fRdfDescriptor->URI);
+
+            if (LilvState* const state = lv2World.getStateFromURI(fRdfDescriptor->Presets[index].URI, (const LV2_URID_Map*)fFeatures[kFeatureIdUridMap]->data))
             {
                 const ScopedSingleProcessLocker spl(this, (sendGui || sendOsc || sendCallback));
+                const CarlaMutexLocker cmlw(fWorkerMutex);
 
                 lilv_state_restore(state, fExt.state, fHandle, carla_lilv_set_port_value, this, 0, fFeatures);
 
@@ -1220,6 +1232,7 @@ public:
             const uint32_t program(pData->midiprog.data[index].program);
 
             const ScopedSingleProcessLocker spl(this, (sendGui || sendOsc || sendCallback));
+            const CarlaMutexLocker cmlw(fWorkerMutex);
 
             try {
                 fExt.programs->select_program(fHandle, bank, program);
@@ -1264,8 +1277,8 @@ public:
                     return;
                 }
 
-                for (std::size_t i=CARLA_URI_MAP_ID_COUNT, count=fCustomURIDs.count(); i < count; ++i)
-                    fPipeServer.writeLv2UridMessage(static_cast<uint32_t>(i), fCustomURIDs.getAt(i, nullptr));
+                fUridsSentToUI = CARLA_URI_MAP_ID_COUNT;
+                writeNewURIDsToUI();
 
                 fPipeServer.writeUiOptionsMessage(pData->engine->getSampleRate(), true, true, fLv2Options.windowTitle, frontendWinId);
 
@@ -1274,6 +1287,7 @@ public:
                     fPipeServer.writeControlMessage(static_cast<uint32_t>(pData->param.data[i].rindex), getParameterValue(i));
 
                 fPipeServer.writeShowMessage();
+                refreshParameterOutputs();
 #ifndef BUILD_BRIDGE
                 if (fUI.rdfDescriptor->Type == LV2_UI_MOD)
                     pData->tryTransient();
@@ -1382,6 +1396,7 @@ public:
             }
 
             updateUi();
+            refreshParameterOutputs();
 
 #ifndef LV2_UIS_ONLY_BRIDGES
             if (fUI.type == UI::TYPE_EMBED)
@@ -1482,12 +1497,7 @@ public:
 
             for (; tmpRingBuffer.get(atom, portIndex);)
             {
-                if (atom->type == CARLA_URI_MAP_ID_CARLA_ATOM_WORKER)
-                {
-                    CARLA_SAFE_ASSERT_CONTINUE(fExt.worker != nullptr && fExt.worker->work != nullptr);
-                    fExt.worker->work(fHandle, carla_lv2_worker_respond, this, atom->size, LV2_ATOM_BODY_CONST(atom));
-                }
-                else if (fUI.type == UI::TYPE_BRIDGE)
+                if (fUI.type == UI::TYPE_BRIDGE)
                 {
                     if (fPipeServer.isPipeRunning())
                         fPipeServer.writeLv2AtomMessage(portIndex, atom);
@@ -2310,9 +2320,12 @@ public:
         if (fExt.worker != nullptr || (fUI.type != UI::TYPE_NULL && fEventsIn.count > 0 && (fEventsIn.data[0].type & CARLA_EVENT_DATA_ATOM) != 0))
             fAtomBufferIn.createBuffer(eventBufferSize);
 
-        if (fExt.worker != nullptr || (fUI.type != UI::TYPE_NULL && fEventsOut.count > 0 && (fEventsOut.data[0].type & CARLA_EVENT_DATA_ATOM) != 0))
+        if (fUI.type != UI::TYPE_NULL && fEventsOut.count > 0 && (fEventsOut.data[0].type & CARLA_EVENT_DATA_ATOM) != 0)
             fAtomBufferOut.createBuffer(eventBufferSize);
 
+        if (fExt.worker != nullptr)
+            fAtomBufferWorker.createBuffer(eventBufferSize);
+
         if (fEventsIn.ctrl != nullptr && fEventsIn.ctrl->port == nullptr)
             fEventsIn.ctrl->port = pData->event.portIn;
 
@@ -2518,11 +2531,16 @@ public:
             {
                 setMidiProgram(0, false, false, false);
             }
-            else
+            else if (fRdfDescriptor->HasDefaultState)
             {
                 // load default state
-                if (LilvState* const state = Lv2WorldClass::getInstance().getStateFromURI(fDescriptor->URI, (const LV2_URID_Map*)fFeatures[kFeatureIdUridMap]->data))
+                Lv2WorldClass& lv2World(Lv2WorldClass::getInstance());
+                lv2World.initIfNeeded(getLv2Path(), fRdfDescriptor->URI);
+
+                if (LilvState* const state = lv2World.getStateFromURI(fDescriptor->URI, (const LV2_URID_Map*)fFeatures[kFeatureIdUridMap]->data))
                 {
+                    const CarlaMutexLocker cmlw(fWorkerMutex);
+
                     lilv_state_restore(state, fExt.state, fHandle, carla_lilv_set_port_value, this, 0, fFeatures);
 
                     if (fHandle2 != nullptr)
@@ -2584,6 +2602,8 @@ public:
 
         if (fDescriptor->activate != nullptr)
         {
+            const CarlaMutexLocker cmlw(fWorkerMutex);
+
             try {
                 fDescriptor->activate(fHandle);
             } CARLA_SAFE_EXCEPTION("LV2 activate");
@@ -2606,6 +2626,8 @@ public:
 
         if (fDescriptor->deactivate != nullptr)
         {
+            const CarlaMutexLocker cmlw(fWorkerMutex);
+
             try {
                 fDescriptor->deactivate(fHandle);
             } CARLA_SAFE_EXCEPTION("LV2 deactivate");
@@ -2634,6 +2656,12 @@ public:
             return;
         }
 
+        // --------------------------------------------------------------------------------------------------------
+        // Pending work the engine could not take before
+
+        if (fWorkerNeedsSchedule && pData->engine->scheduleWork(this))
+            fWorkerNeedsSchedule = false;
+
         // --------------------------------------------------------------------------------------------------------
         // Event itenerators from different APIs (input)
 
@@ -2912,6 +2940,8 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Event Input and Processing
 
+        pData->subBlocks.addBlock();
+
         if (fEventsIn.ctrl != nullptr)
         {
             // ----------------------------------------------------------------------------------------------------
@@ -2994,6 +3024,8 @@ public:
 #endif
             bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
 
+            const uint32_t splitGranularity(pData->engine->getOptions().splitGranularity);
+
             uint32_t startTime  = 0;
             uint32_t timeOffset = 0;
             uint32_t nextBankId;
@@ -3014,7 +3046,9 @@ public:
 
                 CARLA_ASSERT_INT2(event.time >= timeOffset, event.time, timeOffset);
 
-                if (isSampleAccurate && event.time > timeOffset)
+                // events within the split granularity are merged into the current sub-block,
+                // splitting only when both sides get at least that many frames
+                if (isSampleAccurate && event.time >= timeOffset + splitGranularity && event.time + splitGranularity <= frames)
                 {
                     if (processSingle(audioIn, audioOut, cvIn, cvOut, event.time - timeOffset, timeOffset))
                     {
@@ -3050,6 +3084,8 @@ public:
                         startTime += timeOffset;
                 }
 
+                const uint32_t eventTime(isSampleAccurate ? startTime + event.time - timeOffset : event.time);
+
                 switch (event.type)
                 {
                 case kEngineEventTypeNull:
@@ -3158,7 +3194,7 @@ public:
                             midiData[1] = uint8_t(ctrlEvent.param);
                             midiData[2] = uint8_t(ctrlEvent.value*127.0f);
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : event.time);
+                            const uint32_t mtime(eventTime);
 
                             if (fEventsIn.ctrl->type & CARLA_EVENT_DATA_ATOM)
                                 lv2_atom_buffer_write(&evInAtomIters[fEventsIn.ctrlIndex], mtime, 0, CARLA_URI_MAP_ID_MIDI_EVENT, 3, midiData);
@@ -3185,7 +3221,7 @@ public:
                             midiData[1] = MIDI_CONTROL_BANK_SELECT;
                             midiData[2] = uint8_t(ctrlEvent.param);
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : event.time);
+                            const uint32_t mtime(eventTime);
 
                             if (fEventsIn.ctrl->type & CARLA_EVENT_DATA_ATOM)
                                 lv2_atom_buffer_write(&evInAtomIters[fEventsIn.ctrlIndex], mtime, 0, CARLA_URI_MAP_ID_MIDI_EVENT, 3, midiData);
@@ -3223,7 +3259,7 @@ public:
                             midiData[0] = uint8_t(MIDI_STATUS_PROGRAM_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             midiData[1] = uint8_t(ctrlEvent.param);
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : event.time);
+                            const uint32_t mtime(eventTime);
 
                             if (fEventsIn.ctrl->type & CARLA_EVENT_DATA_ATOM)
                                 lv2_atom_buffer_write(&evInAtomIters[fEventsIn.ctrlIndex], mtime, 0, CARLA_URI_MAP_ID_MIDI_EVENT, 2, midiData);
@@ -3239,7 +3275,7 @@ public:
                     case kEngineControlEventTypeAllSoundOff:
                         if (pData->options & PLUGIN_OPTION_SEND_ALL_SOUND_OFF)
                         {
-                            const uint32_t mtime(isSampleAccurate ? startTime : event.time);
+                            const uint32_t mtime(eventTime);
 
                             uint8_t midiData[3];
                             midiData[0] = uint8_t(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
@@ -3268,7 +3304,7 @@ public:
                             }
 #endif
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : event.time);
+                            const uint32_t mtime(eventTime);
 
                             uint8_t midiData[3];
                             midiData[0] = uint8_t(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
@@ -3310,7 +3346,7 @@ public:
                         status = MIDI_STATUS_NOTE_OFF;
 
                     const uint32_t j     = fEventsIn.ctrlIndex;
-                    const uint32_t mtime = isSampleAccurate ? startTime : event.time;
+                    const uint32_t mtime = eventTime;
 
                     // put back channel in data
                     uint8_t midiData2[midiEvent.size];
@@ -3474,15 +3510,15 @@ public:
             }
         }
 
-#ifndef BUILD_BRIDGE
         // --------------------------------------------------------------------------------------------------------
         // Control Output
 
-        if (pData->event.portOut != nullptr)
         {
+#ifndef BUILD_BRIDGE
             uint8_t  channel;
             uint16_t param;
             float    value;
+#endif
 
             for (uint32_t k=0; k < pData->param.count; ++k)
             {
@@ -3490,17 +3526,19 @@ public:
                     continue;
 
                 pData->param.ranges[k].fixValue(fParamBuffers[k]);
+                pData->setParameterOutputValueRT(k, fParamBuffers[k]);
 
-                if (pData->param.data[k].midiCC > 0)
+#ifndef BUILD_BRIDGE
+                if (pData->param.data[k].midiCC > 0 && pData->event.portOut != nullptr)
                 {
                     channel = pData->param.data[k].midiChannel;
                     param   = static_cast<uint16_t>(pData->param.data[k].midiCC);
                     value   = pData->param.ranges[k].getNormalizedValue(fParamBuffers[k]);
                     pData->event.portOut->writeControlEvent(0, channel, kEngineControlEventTypeParameter, param, value);
                 }
+#endif
             }
         } // End of Control Output
-#endif
 
         // --------------------------------------------------------------------------------------------------------
         // Final work
@@ -3562,6 +3600,8 @@ public:
             return false;
         }
 
+        ++pData->subBlocks.runs;
+
         // --------------------------------------------------------------------------------------------------------
         // Set audio buffers
 
@@ -3612,80 +3652,11 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Post-processing (dry/wet, volume and balance)
 
-        {
-            const bool doDryWet  = (pData->hints & PLUGIN_CAN_DRYWET) != 0 && ! carla_compareFloats(pData->postProc.dryWet, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-            const bool isMono    = (pData->audioIn.count == 1);
-
-            bool isPair;
-            float bufValue, oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Dry/Wet
-                if (doDryWet)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-#if 0 // TODO
-                        if (k < pData->latency)
-                            bufValue = pData->latencyBuffers[isMono ? 0 : i][k];
-                        else if (pData->latency < frames)
-                            bufValue = fAudioInBuffers[isMono ? 0 : i][k-pData->latency];
-                        else
+        pData->postProcess(fAudioInBuffers, fAudioOutBuffers, frames, 0, false);
 #endif
-                            bufValue = fAudioInBuffers[isMono ? 0 : i][k];
-
-                        fAudioOutBuffers[i][k] = (fAudioOutBuffers[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
-                    }
-                }
 
-                // Balance
-                if (doBalance)
-                {
-                    isPair = (i % 2 == 0);
-
-                    if (isPair)
-                    {
-                        CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        FloatVectorOperations::copy(oldBufLeft, fAudioOutBuffers[i], static_cast<int>(frames));
-                    }
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (isPair)
-                        {
-                            // left
-                            fAudioOutBuffers[i][k]  = oldBufLeft[k]            * (1.0f - balRangeL);
-                            fAudioOutBuffers[i][k] += fAudioOutBuffers[i+1][k] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            fAudioOutBuffers[i][k]  = fAudioOutBuffers[i][k] * balRangeR;
-                            fAudioOutBuffers[i][k] += oldBufLeft[k]          * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume (and buffer copy)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k] * pData->postProc.volume;
-                }
-            }
-        } // End of Post-processing
-
-#else // BUILD_BRIDGE
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
-        {
-            for (uint32_t k=0; k < frames; ++k)
-                audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k];
-        }
-#endif
+            FloatVectorOperations::copy(audioOut[i]+timeOffset, fAudioOutBuffers[i], static_cast<int>(frames));
 
         for (uint32_t i=0; i < pData->cvOut.count; ++i)
         {
@@ -4258,19 +4229,11 @@ public:
         CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', CARLA_URI_MAP_ID_NULL);
         carla_debug("CarlaPluginLV2::getCustomURID(\"%s\")", uri);
 
-        for (size_t i=0; i < fCustomURIDs.count(); ++i)
-        {
-            const char* const thisUri(fCustomURIDs.getAt(i, nullptr));
-            if (thisUri != nullptr && std::strcmp(thisUri, uri) == 0)
-                return static_cast<LV2_URID>(i);
-        }
+        const LV2_URID urid(fUridMap->map(uri));
 
-        const LV2_URID urid(static_cast<LV2_URID>(fCustomURIDs.count()));
-
-        fCustomURIDs.append(carla_strdup(uri));
-
-        if (fUI.type == UI::TYPE_BRIDGE && fPipeServer.isPipeRunning())
-            fPipeServer.writeLv2UridMessage(urid, uri);
+        // the URI might have been mapped by another plugin, so the UI bridge may not know it yet
+        if (fUI.type == UI::TYPE_BRIDGE && urid >= fUridsSentToUI && fPipeServer.isPipeRunning())
+            writeNewURIDsToUI();
 
         return urid;
     }
@@ -4278,10 +4241,23 @@ public:
     const char* getCustomURIDString(const LV2_URID urid) const noexcept
     {
         CARLA_SAFE_ASSERT_RETURN(urid != CARLA_URI_MAP_ID_NULL, nullptr);
-        CARLA_SAFE_ASSERT_RETURN(urid < fCustomURIDs.count(), nullptr);
         carla_debug("CarlaPluginLV2::getCustomURIString(%i)", urid);
 
-        return fCustomURIDs.getAt(urid, nullptr);
+        return fUridMap->unmap(urid);
+    }
+
+    void writeNewURIDsToUI()
+    {
+        const uint32_t count(fUridMap->getCount());
+
+        for (uint32_t i=fUridsSentToUI; i < count; ++i)
+        {
+            // skip gaps left by other UI bridges
+            if (const char* const uri = fUridMap->unmap(i))
+                fPipeServer.writeLv2UridMessage(i, uri);
+        }
+
+        fUridsSentToUI = count;
     }
 
     // -------------------------------------------------------------------
@@ -4449,6 +4425,7 @@ public:
 
         if (pData->engine->isOffline())
         {
+            const CarlaMutexLocker cmlw(fWorkerMutex);
             fExt.worker->work(fHandle, carla_lv2_worker_respond, this, size, data);
             return LV2_WORKER_SUCCESS;
         }
@@ -4457,7 +4434,49 @@ public:
         atom.size = size;
         atom.type = CARLA_URI_MAP_ID_CARLA_ATOM_WORKER;
 
-        return fAtomBufferOut.putChunk(&atom, data, fEventsOut.ctrlIndex) ? LV2_WORKER_SUCCESS : LV2_WORKER_ERR_NO_SPACE;
+        if (! fAtomBufferWorker.putChunk(&atom, data, 0))
+            return LV2_WORKER_ERR_NO_SPACE;
+
+        // only the first pending request queues us, runWork() takes care of the rest
+        if (++fWorkerPending == 1 && ! pData->engine->scheduleWork(this))
+        {
+            // the request stays pending, process() keeps trying until the engine takes it
+            fWorkerNeedsSchedule = true;
+            carla_stderr2("CarlaPluginLV2::handleWorkerSchedule() - engine worker queue is full");
+        }
+
+        return LV2_WORKER_SUCCESS;
+    }
+
+    void runWork() noexcept override
+    {
+        CARLA_SAFE_ASSERT_RETURN(fExt.worker != nullptr && fExt.worker->work != nullptr,);
+
+        // work() is in the audio class, it must not run during activate, state restore and such
+        const CarlaMutexLocker cml(fWorkerMutex);
+
+        for (int pending = fWorkerPending.get(); pending > 0; pending = (fWorkerPending -= pending))
+        {
+            if (! fAtomBufferWorker.isDataAvailableForReading())
+                continue;
+
+            uint8_t dumpBuf[fAtomBufferWorker.getSize()];
+
+            Lv2AtomRingBuffer tmpRingBuffer(fAtomBufferWorker, dumpBuf);
+            CARLA_SAFE_ASSERT_CONTINUE(tmpRingBuffer.isDataAvailableForReading());
+
+            uint32_t portIndex;
+            const LV2_Atom* atom;
+
+            for (; tmpRingBuffer.get(atom, portIndex);)
+            {
+                CARLA_SAFE_ASSERT_CONTINUE(atom->type == CARLA_URI_MAP_ID_CARLA_ATOM_WORKER);
+
+                try {
+                    fExt.worker->work(fHandle, carla_lv2_worker_respond, this, atom->size, LV2_ATOM_BODY_CONST(atom));
+                } CARLA_SAFE_EXCEPTION("LV2 worker")
+            }
+        }
     }
 
     LV2_Worker_Status handleWorkerRespond(const uint32_t size, const void* const data)
@@ -4672,6 +4691,20 @@ public:
 
     // -------------------------------------------------------------------
 
+private:
+    // LV2_PATH used for lilv and the RDF cache
+    const char* getLv2Path() const noexcept
+    {
+        const char* const pathLV2(pData->engine->getOptions().pathLV2);
+
+        if (pathLV2 != nullptr && pathLV2[0] != '\0')
+            return pathLV2;
+
+        return std::getenv("LV2_PATH");
+    }
+
+    // -------------------------------------------------------------------
+
 public:
     bool init(const char* const name, const char* const uri)
     {
@@ -4693,19 +4726,9 @@ public:
         }
 
         // ---------------------------------------------------------------
-        // Init LV2 World if needed, sets LV2_PATH for lilv
-
-        Lv2WorldClass& lv2World(Lv2WorldClass::getInstance());
+        // get plugin from lv2_rdf (cache, or lilv if the cache is stale)
 
-        if (pData->engine->getOptions().pathLV2 != nullptr && pData->engine->getOptions().pathLV2[0] != '\0')
-            lv2World.initIfNeeded(pData->engine->getOptions().pathLV2);
-        else
-            lv2World.initIfNeeded(std::getenv("LV2_PATH"));
-
-        // ---------------------------------------------------------------
-        // get plugin from lv2_rdf (lilv)
-
-        fRdfDescriptor = lv2_rdf_new(uri, true);
+        fRdfDescriptor = lv2_rdf_new_cached(uri, getLv2Path());
 
         if (fRdfDescriptor == nullptr)
         {
@@ -5469,27 +5492,19 @@ public:
         fAtomBufferIn.put(atom, portIndex);
     }
 
-    void handleUridMap(const LV2_URID urid, const char* const uri)
+    // the UI bridge never assigns URIDs itself, it asks us and waits for the reply
+    void handleUridMapRequest(const char* const uri)
     {
-        CARLA_SAFE_ASSERT_RETURN(urid != CARLA_URI_MAP_ID_NULL,);
         CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0',);
-        carla_debug("CarlaPluginLV2::handleUridMap(%i v " P_SIZE ", \"%s\")", urid, fCustomURIDs.count()-1, uri);
+        carla_debug("CarlaPluginLV2::handleUridMapRequest(\"%s\")", uri);
 
-        if (urid < fCustomURIDs.count())
-        {
-            const char* const ourURI(carla_lv2_urid_unmap(this, urid));
-            CARLA_SAFE_ASSERT_RETURN(ourURI != nullptr,);
+        const LV2_URID urid(carla_lv2_urid_map(this, uri));
+        CARLA_SAFE_ASSERT_RETURN(urid != CARLA_URI_MAP_ID_NULL,);
 
-            if (std::strcmp(ourURI, uri) != 0)
-            {
-                carla_stderr2("PLUGIN :: wrong URI '%s' vs '%s'", ourURI,  uri);
-            }
-        }
+        if (urid >= fUridsSentToUI)
+            writeNewURIDsToUI();
         else
-        {
-            CARLA_SAFE_ASSERT_RETURN(urid == fCustomURIDs.count(),);
-            fCustomURIDs.append(carla_strdup(uri));
-        }
+            fPipeServer.writeLv2UridMessage(urid, uri);
     }
 
     // -------------------------------------------------------------------
@@ -5514,6 +5529,10 @@ private:
 
     Lv2AtomRingBuffer fAtomBufferIn;
     Lv2AtomRingBuffer fAtomBufferOut;
+    Lv2AtomRingBuffer fAtomBufferWorker;
+    juce::Atomic<int> fWorkerPending; // work requests not yet taken by runWork()
+    bool              fWorkerNeedsSchedule; // engine worker queue was full, retried in process()
+    CarlaMutex        fWorkerMutex;   // held while running work, keeps instantiation class calls out
     LV2_Atom_Forge    fAtomForge;
 
     CarlaPluginLV2EventData fEventsIn;
@@ -5521,7 +5540,8 @@ private:
     CarlaPluginLV2Options   fLv2Options;
     CarlaPipeServerLV2      fPipeServer;
 
-    LinkedList<const char*> fCustomURIDs;
+    SharedResourcePointer<CarlaPluginLV2UridMap> fUridMap;
+    uint32_t fUridsSentToUI; // custom URIDs below this were already sent to the UI bridge
 
     bool fFirstActive; // first process() call after activate()
     void* fLastStateChunk;
@@ -6150,12 +6170,12 @@ bool CarlaPipeServerLV2::msgReceived(const char* const msg) noexcept
         CARLA_SAFE_ASSERT_RETURN(readNextLineAsUInt(urid), true);
         CARLA_SAFE_ASSERT_RETURN(readNextLineAsString(uri), true);
 
-        if (urid != 0)
-        {
-            try {
-                kPlugin->handleUridMap(urid, uri);
-            } CARLA_SAFE_EXCEPTION("msgReceived urid");
-        }
+        // only requests are valid here, the UI bridge must use our IDs
+        CARLA_SAFE_ASSERT_UINT(urid == 0, urid);
+
+        try {
+            kPlugin->handleUridMapRequest(uri);
+        } CARLA_SAFE_EXCEPTION("msgReceived urid");
 
         delete[] uri;
         return true;
@@ -326,6 +326,8 @@ public:
         if (kIsGIG)
             options |= PLUGIN_OPTION_MAP_PROGRAM_CHANGES;
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -1060,6 +1062,9 @@ public:
 
         fParamBuffers[LinuxSamplerDiskStreamCount] = static_cast<float>(diskStreamCount);
         fParamBuffers[LinuxSamplerVoiceCount]      = static_cast<float>(voiceCount);
+
+        pData->setParameterOutputValueRT(LinuxSamplerDiskStreamCount, fParamBuffers[LinuxSamplerDiskStreamCount]);
+        pData->setParameterOutputValueRT(LinuxSamplerVoiceCount,      fParamBuffers[LinuxSamplerVoiceCount]);
     }
 
     bool processSingle(float** const outBuffer, const uint32_t frames, const uint32_t timeOffset)
@@ -1098,51 +1103,9 @@ public:
 
 #ifndef BUILD_BRIDGE
         // --------------------------------------------------------------------------------------------------------
-        // Post-processing (dry/wet, volume and balance)
-
-        {
-            const bool doVolume  = (pData->hints & PLUGIN_CAN_VOLUME) != 0 && ! carla_compareFloats(pData->postProc.volume, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-
-            float oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Balance
-                if (doBalance)
-                {
-                    if (i % 2 == 0)
-                        FloatVectorOperations::copy(oldBufLeft, outBuffer[i], static_cast<int>(frames));
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (i % 2 == 0)
-                        {
-                            // left
-                            outBuffer[i][k]  = oldBufLeft[k]     * (1.0f - balRangeL);
-                            outBuffer[i][k] += outBuffer[i+1][k] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            outBuffer[i][k]  = outBuffer[i][k] * balRangeR;
-                            outBuffer[i][k] += oldBufLeft[k]   * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume
-                if (doVolume)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        outBuffer[i][k+timeOffset] *= pData->postProc.volume;
-                }
-            }
+        // Post-processing (volume and balance)
 
-        } // End of Post-processing
+        pData->postProcess(nullptr, outBuffer, frames, timeOffset, false);
 #endif
 
         // --------------------------------------------------------------------------------------------------------
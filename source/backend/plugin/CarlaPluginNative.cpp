@@ -335,6 +335,8 @@ public:
         if (fDescriptor->supports & NATIVE_PLUGIN_SUPPORTS_ALL_SOUND_OFF)
             options |= PLUGIN_OPTION_SEND_ALL_SOUND_OFF;
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -767,6 +769,8 @@ public:
             for (uint32_t i=0; i < pData->param.count; ++i)
                 fDescriptor->ui_set_parameter_value(fHandle, i, fDescriptor->get_parameter_value(fHandle, i));
         }
+
+        refreshParameterOutputs();
     }
 
     void uiIdle() override
@@ -1709,12 +1713,10 @@ public:
         } // End of Plugin processing (no events)
 
         // --------------------------------------------------------------------------------------------------------
-        // Control and MIDI Output
+        // Control Output
 
-        if (fMidiOut.count > 0 || pData->event.portOut != nullptr)
         {
-#ifndef BUILD_BRIDGE
-            float value, curValue;
+            float curValue;
 
             for (uint32_t k=0; k < pData->param.count; ++k)
             {
@@ -1723,15 +1725,23 @@ public:
 
                 curValue = fDescriptor->get_parameter_value(fHandle, k);
                 pData->param.ranges[k].fixValue(curValue);
+                pData->setParameterOutputValueRT(k, curValue);
 
-                if (pData->param.data[k].midiCC > 0)
+#ifndef BUILD_BRIDGE
+                if (pData->param.data[k].midiCC > 0 && pData->event.portOut != nullptr)
                 {
-                    value = pData->param.ranges[k].getNormalizedValue(curValue);
+                    const float value(pData->param.ranges[k].getNormalizedValue(curValue));
                     pData->event.portOut->writeControlEvent(0, pData->param.data[k].midiChannel, kEngineControlEventTypeParameter, static_cast<uint16_t>(pData->param.data[k].midiCC), value);
                 }
-            }
 #endif
+            }
+        } // End of Control Output
+
+        // --------------------------------------------------------------------------------------------------------
+        // MIDI Output
 
+        if (fMidiOut.count > 0 || pData->event.portOut != nullptr)
+        {
             // reverse lookup MIDI events
             for (uint32_t k = (kPluginMaxMidiEvents*2)-1; k >= fMidiEventCount; --k)
             {
@@ -1843,71 +1853,11 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Post-processing (dry/wet, volume and balance)
 
-        {
-            const bool doDryWet  = (pData->hints & PLUGIN_CAN_DRYWET) != 0 && ! carla_compareFloats(pData->postProc.dryWet, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-
-            bool isPair;
-            float bufValue, oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Dry/Wet
-                if (doDryWet)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        bufValue = fAudioInBuffers[(pData->audioIn.count == 1) ? 0 : i][k];
-                        fAudioOutBuffers[i][k] = (fAudioOutBuffers[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
-                    }
-                }
-
-                // Balance
-                if (doBalance)
-                {
-                    isPair = (i % 2 == 0);
-
-                    if (isPair)
-                    {
-                        CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        FloatVectorOperations::copy(oldBufLeft, fAudioOutBuffers[i], static_cast<int>(frames));
-                    }
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (isPair)
-                        {
-                            // left
-                            fAudioOutBuffers[i][k]  = oldBufLeft[k]            * (1.0f - balRangeL);
-                            fAudioOutBuffers[i][k] += fAudioOutBuffers[i+1][k] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            fAudioOutBuffers[i][k]  = fAudioOutBuffers[i][k] * balRangeR;
-                            fAudioOutBuffers[i][k] += oldBufLeft[k]          * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume (and buffer copy)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k] * pData->postProc.volume;
-                }
-            }
+        pData->postProcess(fAudioInBuffers, fAudioOutBuffers, frames, 0, false);
+#endif
 
-        } // End of Post-processing
-#else
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
-        {
-            for (uint32_t k=0; k < frames; ++k)
-                audioOut[i][k+timeOffset] = fAudioOutBuffers[i][k];
-        }
-#endif
+            FloatVectorOperations::copy(audioOut[i]+timeOffset, fAudioOutBuffers[i], static_cast<int>(frames));
 
 #if 0
         for (uint32_t i=0; i < pData->cvOut.count; ++i)
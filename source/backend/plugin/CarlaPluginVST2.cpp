@@ -179,6 +179,14 @@ public:
         return static_cast<int64_t>(fEffect->uniqueID);
     }
 
+    uint32_t getTailLengthInFrames() const noexcept override
+    {
+        // 0 means not supported, 1 means no tail
+        const intptr_t tail(dispatcher(effGetTailSize, 0, 0, nullptr, 0.0f));
+
+        return tail > 1 ? static_cast<uint32_t>(tail) : 0;
+    }
+
     // -------------------------------------------------------------------
     // Information (count)
 
@@ -229,6 +237,8 @@ public:
             options |= PLUGIN_OPTION_SEND_ALL_SOUND_OFF;
         }
 
+        options |= PLUGIN_OPTION_SKIP_SILENCE;
+
         return options;
     }
 
@@ -1136,6 +1146,8 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Event Input and Processing
 
+        pData->subBlocks.addBlock();
+
         if (pData->event.portIn != nullptr)
         {
             // ----------------------------------------------------------------------------------------------------
@@ -1172,6 +1184,8 @@ public:
 #endif
             bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
 
+            const uint32_t splitGranularity(pData->engine->getOptions().splitGranularity);
+
             uint32_t startTime  = 0;
             uint32_t timeOffset = 0;
 
@@ -1184,7 +1198,9 @@ public:
 
                 CARLA_ASSERT_INT2(event.time >= timeOffset, event.time, timeOffset);
 
-                if (isSampleAccurate && event.time > timeOffset)
+                // events within the split granularity are merged into the current sub-block,
+                // splitting only when both sides get at least that many frames
+                if (isSampleAccurate && event.time >= timeOffset + splitGranularity && event.time + splitGranularity <= frames)
                 {
                     if (processSingle(audioIn, audioOut, event.time - timeOffset, timeOffset))
                     {
@@ -1201,6 +1217,8 @@ public:
                         startTime += timeOffset;
                 }
 
+                const uint32_t eventTime(isSampleAccurate ? startTime + event.time - timeOffset : event.time);
+
                 switch (event.type)
                 {
                 case kEngineEventTypeNull:
@@ -1312,7 +1330,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : event.time);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = char(ctrlEvent.param);
                             vstMidiEvent.midiData[2] = char(ctrlEvent.value*127.0f);
@@ -1347,7 +1365,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : event.time);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = MIDI_CONTROL_ALL_SOUND_OFF;
                         }
@@ -1372,7 +1390,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : event.time);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = MIDI_CONTROL_ALL_NOTES_OFF;
                         }
@@ -1411,7 +1429,7 @@ public:
 
                     vstMidiEvent.type        = kVstMidiType;
                     vstMidiEvent.byteSize    = kVstMidiEventSize;
-                    vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : event.time);
+                    vstMidiEvent.deltaFrames = static_cast<int32_t>(eventTime);
                     vstMidiEvent.midiData[0] = char(status | (event.channel & MIDI_CHANNEL_BIT));
                     vstMidiEvent.midiData[1] = char(midiEvent.size >= 2 ? midiEvent.data[1] : 0);
                     vstMidiEvent.midiData[2] = char(midiEvent.size >= 3 ? midiEvent.data[2] : 0);
@@ -1498,6 +1516,8 @@ public:
             return false;
         }
 
+        ++pData->subBlocks.runs;
+
         // --------------------------------------------------------------------------------------------------------
         // Set audio buffers
 
@@ -1546,66 +1566,7 @@ public:
         // --------------------------------------------------------------------------------------------------------
         // Post-processing (dry/wet, volume and balance)
 
-        {
-            const bool doVolume  = (pData->hints & PLUGIN_CAN_VOLUME) != 0 && ! carla_compareFloats(pData->postProc.volume, 1.0f);
-            const bool doDryWet  = (pData->hints & PLUGIN_CAN_DRYWET) != 0 && ! carla_compareFloats(pData->postProc.dryWet, 1.0f);
-            const bool doBalance = (pData->hints & PLUGIN_CAN_BALANCE) != 0 && ! (carla_compareFloats(pData->postProc.balanceLeft, -1.0f) && carla_compareFloats(pData->postProc.balanceRight, 1.0f));
-
-            bool isPair;
-            float bufValue, oldBufLeft[doBalance ? frames : 1];
-
-            for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            {
-                // Dry/Wet
-                if (doDryWet)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        bufValue = inBuffer[(pData->audioIn.count == 1) ? 0 : i][k+timeOffset];
-                        outBuffer[i][k+timeOffset] = (outBuffer[i][k+timeOffset] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
-                    }
-                }
-
-                // Balance
-                if (doBalance)
-                {
-                    isPair = (i % 2 == 0);
-
-                    if (isPair)
-                    {
-                        CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        FloatVectorOperations::copy(oldBufLeft, outBuffer[i]+timeOffset, static_cast<int>(frames));
-                    }
-
-                    float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
-                    float balRangeR = (pData->postProc.balanceRight + 1.0f)/2.0f;
-
-                    for (uint32_t k=0; k < frames; ++k)
-                    {
-                        if (isPair)
-                        {
-                            // left
-                            outBuffer[i][k+timeOffset]  = oldBufLeft[k]                * (1.0f - balRangeL);
-                            outBuffer[i][k+timeOffset] += outBuffer[i+1][k+timeOffset] * (1.0f - balRangeR);
-                        }
-                        else
-                        {
-                            // right
-                            outBuffer[i][k+timeOffset]  = outBuffer[i][k+timeOffset] * balRangeR;
-                            outBuffer[i][k+timeOffset] += oldBufLeft[k]              * balRangeL;
-                        }
-                    }
-                }
-
-                // Volume
-                if (doVolume)
-                {
-                    for (uint32_t k=0; k < frames; ++k)
-                        outBuffer[i][k+timeOffset] *= pData->postProc.volume;
-                }
-            }
-
-        } // End of Post-processing
+        pData->postProcess(inBuffer, outBuffer, frames, timeOffset, false);
 #endif
 
         // --------------------------------------------------------------------------------------------------------
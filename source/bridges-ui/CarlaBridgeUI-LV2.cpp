@@ -19,10 +19,12 @@
 #include "CarlaLibUtils.hpp"
 #include "CarlaLv2Utils.hpp"
 #include "CarlaMIDI.h"
-#include "LinkedList.hpp"
+#include "Lv2UridMap.hpp"
 
 #include "juce_core.h"
 
+#include <vector>
+
 #define URI_CARLA_ATOM_WORKER "http://kxstudio.sf.net/ns/carla/atomWorker"
 
 using juce::File;
@@ -211,15 +213,17 @@ public:
           fRdfUiDescriptor(nullptr),
           fLv2Options(),
           fUiOptions(),
-          fCustomURIDs(),
+          fUridMap(CARLA_URI_MAP_ID_COUNT),
+          fWaitingForURID(false),
+          fHostUridTimedOut(false),
+          fPendingPortEvents(),
+          fPendingMidiProgram(),
+          fPendingToolkit(),
           fExt(),
           leakDetector_CarlaLv2Client()
     {
         carla_zeroPointers(fFeatures, kFeatureCount+1);
 
-        for (uint32_t i=0; i < CARLA_URI_MAP_ID_COUNT; ++i)
-            fCustomURIDs.append(nullptr);
-
         // ---------------------------------------------------------------
         // initialize options
 
@@ -360,16 +364,6 @@ public:
                 fFeatures[i] = nullptr;
             }
         }
-
-        for (LinkedList<const char*>::Itenerator it = fCustomURIDs.begin(); it.valid(); it.next())
-        {
-            const char* const uri(it.getValue(nullptr));
-
-            if (uri != nullptr)
-                delete[] uri;
-        }
-
-        fCustomURIDs.clear();
     }
 
     // ---------------------------------------------------------------------
@@ -381,25 +375,9 @@ public:
         const char* uiURI     = argv[2];
 
         // -----------------------------------------------------------------
-        // load plugin
-
-        Lv2WorldClass& lv2World(Lv2WorldClass::getInstance());
-        lv2World.initIfNeeded(std::getenv("LV2_PATH"));
-
-        //Lilv::Node bundleNode(lv2World.new_file_uri(nullptr, uiBundle));
-        //CARLA_SAFE_ASSERT_RETURN(bundleNode.is_uri(), false);
-
-        //CarlaString sBundle(bundleNode.as_uri());
-
-        //if (! sBundle.endsWith("/"))
-        //    sBundle += "/";
-
-        //lv2World.load_bundle(sBundle);
-
-        // -----------------------------------------------------------------
-        // get plugin from lv2_rdf (lilv)
+        // get plugin from lv2_rdf (cache, or lilv if the cache is stale)
 
-        fRdfDescriptor = lv2_rdf_new(pluginURI, true);
+        fRdfDescriptor = lv2_rdf_new_cached(pluginURI, std::getenv("LV2_PATH"));
         CARLA_SAFE_ASSERT_RETURN(fRdfDescriptor != nullptr, false);
 
         // -----------------------------------------------------------------
@@ -519,6 +497,8 @@ public:
 
     void idleUI() override
     {
+        sendPendingEvents();
+
 #if defined(BRIDGE_COCOA) || defined(BRIDGE_HWND) || defined(BRIDGE_X11)
         if (fHandle != nullptr && fExt.idle != nullptr)
             fExt.idle->idle(fHandle);
@@ -546,10 +526,7 @@ public:
         CARLA_SAFE_ASSERT_RETURN(fHandle != nullptr,)
         CARLA_SAFE_ASSERT_RETURN(fDescriptor != nullptr,);
 
-        if (fDescriptor->port_event == nullptr)
-            return;
-
-        fDescriptor->port_event(fHandle, index, sizeof(float), CARLA_URI_MAP_ID_NULL, &value);
+        portEvent(index, sizeof(float), CARLA_URI_MAP_ID_NULL, &value);
     }
 
     void dspProgramChanged(const uint32_t) override
@@ -563,6 +540,14 @@ public:
         if (fExt.programs == nullptr)
             return;
 
+        if (fWaitingForURID)
+        {
+            fPendingMidiProgram.pending = true;
+            fPendingMidiProgram.bank    = bank;
+            fPendingMidiProgram.program = program;
+            return;
+        }
+
         fExt.programs->select_program(fHandle, bank, program);
     }
 
@@ -585,7 +570,7 @@ public:
         midiEv.data[1] = note;
         midiEv.data[2] = velocity;
 
-        fDescriptor->port_event(fHandle, /* TODO */ 0, lv2_atom_total_size(midiEv), CARLA_URI_MAP_ID_ATOM_TRANSFER_ATOM, &midiEv);
+        portEvent(/* TODO */ 0, lv2_atom_total_size(midiEv), CARLA_URI_MAP_ID_ATOM_TRANSFER_ATOM, &midiEv);
     }
 
     void dspAtomReceived(const uint32_t portIndex, const LV2_Atom* const atom) override
@@ -594,18 +579,15 @@ public:
         CARLA_SAFE_ASSERT_RETURN(fDescriptor != nullptr,);
         CARLA_SAFE_ASSERT_RETURN(atom != nullptr,);
 
-        if (fDescriptor->port_event == nullptr)
-            return;
-
-        fDescriptor->port_event(fHandle, portIndex, lv2_atom_total_size(atom), CARLA_URI_MAP_ID_ATOM_TRANSFER_EVENT, atom);
+        portEvent(portIndex, lv2_atom_total_size(atom), CARLA_URI_MAP_ID_ATOM_TRANSFER_EVENT, atom);
     }
 
     void dspURIDReceived(const LV2_URID urid, const char* const uri)
     {
-        CARLA_SAFE_ASSERT_RETURN(urid == fCustomURIDs.count(),);
         CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0',);
 
-        fCustomURIDs.append(carla_strdup(uri));
+        if (! fUridMap.mapAt(urid, uri))
+            carla_stderr2("UI :: wrong URI '%s' vs '%s'", fUridMap.unmap(urid), uri);
     }
 
     void uiOptionsChanged(const double sampleRate, const bool useTheme, const bool useThemeColors, const char* const windowTitle, uintptr_t transientWindowId) override
@@ -627,38 +609,133 @@ public:
         CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', CARLA_URI_MAP_ID_NULL);
         carla_debug("CarlaLv2Client::getCustomURID(\"%s\")", uri);
 
+        if (const LV2_URID urid = fUridMap.find(uri))
+            return urid;
+
+        // standalone testing, nothing to share with
+        if (! isPipeRunning())
+            return fUridMap.map(uri);
+
+        // only the host assigns URIDs, as its map is shared by all plugins
+        CARLA_SAFE_ASSERT_RETURN(! fWaitingForURID, CARLA_URI_MAP_ID_NULL);
+
+        // the host sends its whole map on startup, so this is only needed for URIs nobody used yet
+        // if it did not reply before, do not block the UI again, a late reply still gets mapped
+        if (fHostUridTimedOut)
+        {
+            writeLv2UridMessage(0, uri);
+            return CARLA_URI_MAP_ID_NULL;
+        }
+
+        writeLv2UridMessage(0, uri);
+
+        // messages received meanwhile must not call back into the UI, they are sent on the next idle
+        fWaitingForURID = true;
+
         LV2_URID urid = CARLA_URI_MAP_ID_NULL;
 
-        for (uint32_t i=0, count=static_cast<uint32_t>(fCustomURIDs.count()); i<count; ++i)
+        for (uint i=0; i < kUridReplyTimeout && ! fQuitReceived && isPipeRunning(); ++i)
         {
-            const char* const thisUri(fCustomURIDs.getAt(i, nullptr));
+            idlePipe();
 
-            if (thisUri != nullptr && std::strcmp(thisUri, uri) == 0)
-            {
-                urid = i;
+            if ((urid = fUridMap.find(uri)) != CARLA_URI_MAP_ID_NULL)
                 break;
-            }
+
+            carla_msleep(1);
         }
 
-        if (urid == CARLA_URI_MAP_ID_NULL)
+        fWaitingForURID = false;
+
+        if (urid == CARLA_URI_MAP_ID_NULL && ! fQuitReceived)
         {
-            urid = static_cast<LV2_URID>(fCustomURIDs.count());
-            fCustomURIDs.append(carla_strdup(uri));
+            fHostUridTimedOut = true;
+            carla_stderr2("CarlaLv2Client::getCustomURID(\"%s\") - host did not reply", uri);
         }
 
-        if (isPipeRunning())
-            writeLv2UridMessage(urid, uri);
-
         return urid;
     }
 
     const char* getCustomURIDString(const LV2_URID urid) const noexcept
     {
         CARLA_SAFE_ASSERT_RETURN(urid != CARLA_URI_MAP_ID_NULL, nullptr);
-        CARLA_SAFE_ASSERT_RETURN(urid < fCustomURIDs.count(), nullptr);
         carla_debug("CarlaLv2Client::getCustomURIDString(%i)", urid);
 
-        return fCustomURIDs.getAt(urid, nullptr);
+        return fUridMap.unmap(urid);
+    }
+
+    void portEvent(const uint32_t portIndex, const uint32_t bufferSize, const uint32_t format, const void* const buffer)
+    {
+        if (fDescriptor->port_event == nullptr)
+            return;
+
+        if (fWaitingForURID)
+        {
+            const uint8_t* const data((const uint8_t*)buffer);
+
+            PendingPortEvent event;
+            event.portIndex = portIndex;
+            event.format    = format;
+            event.data.assign(data, data + bufferSize);
+
+            fPendingPortEvents.push_back(event);
+            return;
+        }
+
+        fDescriptor->port_event(fHandle, portIndex, bufferSize, format, buffer);
+    }
+
+    void sendPendingEvents()
+    {
+        if (fHandle == nullptr || fWaitingForURID)
+            return;
+
+        if (fPendingMidiProgram.pending)
+        {
+            fPendingMidiProgram.pending = false;
+            dspMidiProgramChanged(fPendingMidiProgram.bank, fPendingMidiProgram.program);
+        }
+
+        if (! fPendingPortEvents.empty())
+        {
+            std::vector<PendingPortEvent> events;
+            events.swap(fPendingPortEvents);
+
+            for (std::vector<PendingPortEvent>::const_iterator it=events.begin(), end=events.end(); it != end; ++it)
+                fDescriptor->port_event(fHandle, it->portIndex, static_cast<uint32_t>(it->data.size()), it->format, it->data.data());
+        }
+
+        if (fToolkit == nullptr)
+            return;
+
+        if (fPendingToolkit.title.isNotEmpty())
+        {
+            fToolkit->setTitle(fPendingToolkit.title);
+            fPendingToolkit.title.clear();
+        }
+
+        if (fPendingToolkit.visible != PendingToolkitMessages::kVisibilityUnchanged)
+        {
+            if (fPendingToolkit.visible == PendingToolkitMessages::kVisibilityShow)
+                fToolkit->show();
+            else
+                fToolkit->hide();
+
+            fPendingToolkit.visible = PendingToolkitMessages::kVisibilityUnchanged;
+        }
+
+        if (fPendingToolkit.focus)
+        {
+            fPendingToolkit.focus = false;
+            fToolkit->focus();
+        }
+
+        if (fPendingToolkit.quit)
+        {
+            fPendingToolkit.quit = false;
+            fToolkit->quit();
+            delete fToolkit;
+            fToolkit = nullptr;
+        }
     }
 
     // ---------------------------------------------------------------------
@@ -727,6 +804,57 @@ public:
 
     // ---------------------------------------------------------------------
 
+protected:
+    bool msgReceived(const char* const msg) noexcept override
+    {
+        if (! fWaitingForURID)
+            return CarlaBridgeUI::msgReceived(msg);
+
+        // the UI is inside map(), toolkit messages would call back into it, keep them for the next idle
+        if (std::strcmp(msg, "show") == 0)
+        {
+            fPendingToolkit.visible = PendingToolkitMessages::kVisibilityShow;
+            return true;
+        }
+
+        if (std::strcmp(msg, "focus") == 0)
+        {
+            fPendingToolkit.focus = true;
+            return true;
+        }
+
+        if (std::strcmp(msg, "hide") == 0)
+        {
+            fPendingToolkit.visible = PendingToolkitMessages::kVisibilityHide;
+            return true;
+        }
+
+        if (std::strcmp(msg, "quit") == 0)
+        {
+            // stops waiting
+            fQuitReceived = true;
+            fPendingToolkit.quit = true;
+            return true;
+        }
+
+        if (std::strcmp(msg, "uiTitle") == 0)
+        {
+            const char* title;
+
+            CARLA_SAFE_ASSERT_RETURN(readNextLineAsString(title), true);
+
+            fPendingToolkit.title = title;
+
+            delete[] title;
+            return true;
+        }
+
+        // DSP messages are deferred by their callbacks
+        return CarlaBridgeUI::msgReceived(msg);
+    }
+
+    // ---------------------------------------------------------------------
+
 private:
     LV2UI_Handle fHandle;
     LV2UI_Widget fWidget;
@@ -738,7 +866,52 @@ private:
     Lv2PluginOptions          fLv2Options;
 
     Options fUiOptions;
-    LinkedList<const char*> fCustomURIDs;
+    Lv2UridMap fUridMap;
+
+    // events received while waiting for the host to map an URI
+    struct PendingPortEvent {
+        uint32_t portIndex;
+        uint32_t format;
+        std::vector<uint8_t> data;
+    };
+
+    struct PendingMidiProgram {
+        bool pending;
+        uint32_t bank;
+        uint32_t program;
+
+        PendingMidiProgram() noexcept
+            : pending(false),
+              bank(0),
+              program(0) {}
+    };
+
+    // show, hide, focus, title and quit requests received while waiting for the host to map an URI
+    struct PendingToolkitMessages {
+        static const int kVisibilityUnchanged = 0;
+        static const int kVisibilityShow      = 1;
+        static const int kVisibilityHide      = 2;
+
+        bool quit;
+        bool focus;
+        int  visible;
+        CarlaString title;
+
+        PendingToolkitMessages() noexcept
+            : quit(false),
+              focus(false),
+              visible(kVisibilityUnchanged),
+              title() {}
+    };
+
+    // how long to wait for the host to map an URI, in ms
+    static const uint kUridReplyTimeout = 2000;
+
+    bool fWaitingForURID;
+    bool fHostUridTimedOut; // host did not reply to a map request, do not block on it anymore
+    std::vector<PendingPortEvent> fPendingPortEvents;
+    PendingMidiProgram fPendingMidiProgram;
+    PendingToolkitMessages fPendingToolkit;
 
     struct Extensions {
         const LV2_Options_Interface* options;
@@ -68,6 +68,7 @@ SOURCES += \
     ../../backend/engine/CarlaEngine.cpp \
     ../../backend/engine/CarlaEngineOsc.cpp \
     ../../backend/engine/CarlaEngineThread.cpp \
+    ../../backend/engine/CarlaEngineWorkerPool.cpp \
     ../../backend/engine/CarlaEngineBridge.cpp \
     ../../backend/engine/CarlaEngineJack.cpp \
     ../../backend/engine/CarlaEngineNative.cpp
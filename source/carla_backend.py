@@ -129,6 +129,8 @@ def toPythonType(value, attr):
         return numPtrToList(value)
     if isinstance(value, POINTER(c_char_p)):
         return charPtrPtrToStringList(value)
+    if isinstance(value, Array):
+        return list(value)
     print("..............", attr, ".....................", value, ":", type(value))
     return value
 
@@ -138,6 +140,61 @@ def toPythonType(value, attr):
 def structToDict(struct):
     return dict((attr, toPythonType(getattr(struct, attr), attr)) for attr, value in struct._fields_)
 
+# ------------------------------------------------------------------------------------------------------------
+# Convert a plugin snapshot buffer into a python dict
+
+def snapshotToDict(data):
+    def getString(offset):
+        return data[offset:data.index(b"\0", offset)].decode("utf-8", errors="ignore")
+
+    header = CarlaPluginSnapshot.from_buffer_copy(data)
+
+    scalePoints = []
+    for i in range(header.scalePointCount):
+        scalePoint = CarlaScalePointSnapshot.from_buffer_copy(data, header.scalePoints + i * sizeof(CarlaScalePointSnapshot))
+        scalePoints.append({
+            'value': scalePoint.value,
+            'label': getString(scalePoint.label)
+        })
+
+    parameters = []
+    for i in range(header.parameterCount):
+        param     = CarlaParameterSnapshot.from_buffer_copy(data, header.parameters + i * sizeof(CarlaParameterSnapshot))
+        parameter = structToDict(param.data)
+        parameter.update(structToDict(param.ranges))
+        parameter.update({
+            'name': getString(param.name),
+            'symbol': getString(param.symbol),
+            'unit': getString(param.unit),
+            'text': getString(param.text),
+            'scalePointCount': param.scalePointCount,
+            'scalePoints': scalePoints[param.scalePointStart:param.scalePointStart+param.scalePointCount],
+            'current': param.value
+        })
+        parameters.append(parameter)
+
+    programNames = []
+    for i in range(header.programCount):
+        programNames.append(getString(c_uint32.from_buffer_copy(data, header.programNames + i * sizeof(c_uint32)).value))
+
+    midiPrograms = []
+    for i in range(header.midiProgramCount):
+        midiProgram = CarlaMidiProgramSnapshot.from_buffer_copy(data, header.midiPrograms + i * sizeof(CarlaMidiProgramSnapshot))
+        midiPrograms.append({
+            'bank': midiProgram.bank,
+            'program': midiProgram.program,
+            'name': getString(midiProgram.name)
+        })
+
+    return {
+        'generation': header.generation,
+        'parameters': parameters,
+        'programNames': programNames,
+        'currentProgram': header.currentProgram,
+        'midiPrograms': midiPrograms,
+        'currentMidiProgram': header.currentMidiProgram
+    }
+
 # ------------------------------------------------------------------------------------------------------------
 # Carla Backend API (base definitions)
 
@@ -247,6 +304,11 @@ PLUGIN_OPTION_SEND_ALL_SOUND_OFF = 0x100
 # @note: This option conflicts with PLUGIN_OPTION_MAP_PROGRAM_CHANGES and cannot be used at the same time.
 PLUGIN_OPTION_SEND_PROGRAM_CHANGES = 0x200
 
+# Skip processing once input and output have been silent for longer than the plugin's tail.
+# The plugin is woken up again by non-silent audio input or any incoming event.
+# @note: Do not use this on plugins that generate sound from silence.
+PLUGIN_OPTION_SKIP_SILENCE = 0x400
+
 # ------------------------------------------------------------------------------------------------------------
 # Parameter Hints
 # Various parameter hints.
@@ -687,6 +749,25 @@ ENGINE_CALLBACK_ERROR = 37
 # The engine has crashed or malfunctioned and will no longer work.
 ENGINE_CALLBACK_QUIT = 38
 
+# Offline rendering progress.
+# @a value1 Number of frames rendered so far
+# @a value2 Total number of frames to render
+# @a value3 Progress, from 0.0 to 1.0
+# @note If the total does not fit in an int, value1 and value2 are both divided by the same power of 2,
+#       use value3 for the progress.
+# @see carla_engine_render()
+ENGINE_CALLBACK_RENDER_PROGRESS = 39
+
+# A plugin bridge took longer than the soft deadline for one or more audio blocks.
+# Sent from the idle thread, once for all blocks that were slow since the previous one.
+# @a pluginId Plugin Id
+# @a value1 Number of slow blocks since the previous callback
+# @a value2 Total number of slow blocks
+# @a value3 Round-trip time of the latest slow block, in percent of the audio cycle
+# @see ENGINE_OPTION_BRIDGE_SOFT_DEADLINE
+# @see carla_get_plugin_bridge_latency()
+ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS = 40
+
 # ------------------------------------------------------------------------------------------------------------
 # Engine Option
 # Engine options.
@@ -773,6 +854,46 @@ ENGINE_OPTION_PREVENT_BAD_BEHAVIOUR = 17
 # Set frontend winId, used to define as parent window for plugin UIs.
 ENGINE_OPTION_FRONTEND_WIN_ID = 18
 
+# Number of threads used for processing plugins, including the audio thread.
+# Values lower than 2 disable parallel processing.
+# Default is 0.
+# @note Used in patchbay processing mode, and in single-client mode with JACK
+ENGINE_OPTION_PROCESS_THREADS = 19
+
+# Longest time in milliseconds the engine idle thread sleeps between updates.
+# The thread is woken up sooner when plugins have changed output parameters or pending events.
+# Default is 25.
+ENGINE_OPTION_IDLE_POLL_INTERVAL = 20
+
+# Let plugin bridges render one block ahead, in parallel with the rest of the engine.
+# This adds one block of latency to bridged plugins, which is reported to the engine.
+# Default is false.
+# @note Only applies to plugin bridges added after changing this option
+ENGINE_OPTION_PIPELINED_BRIDGES = 21
+
+# Soft deadline for plugin bridges, in percent of the audio cycle (buffer size / sample rate).
+# Blocks whose round-trip takes longer are counted as slow and reported with ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS,
+# well before they become full timeouts.
+# Set to 0 to disable.
+# Default is 75.
+ENGINE_OPTION_BRIDGE_SOFT_DEADLINE = 22
+
+# Smallest number of frames a plugin block is split into when processing events sample accurately.
+# Events closer than this to the start of the current sub-block or to the end of the audio block
+# are applied at the start of the current sub-block instead of splitting again.
+# MIDI events keep their exact time within the sub-block.
+# Useful with dense automation and plugins that have a high per-call overhead.
+# Default is 1 (split at every event time).
+# @see carla_get_plugin_sub_blocks()
+ENGINE_OPTION_SPLIT_GRANULARITY = 23
+
+# Use a spin-then-futex handshake instead of semaphores for the audio cycles of plugin bridges.
+# Waiting spins for a while before sleeping, which can lower the round-trip time on some systems
+# at the cost of extra CPU use. Measure before enabling it.
+# Default is false.
+# @note Only applies to plugin bridges added after changing this option, and only on Linux
+ENGINE_OPTION_LOW_LATENCY_BRIDGES = 24
+
 # ------------------------------------------------------------------------------------------------------------
 # Engine Process Mode
 # Engine process mode.
@@ -1124,6 +1245,273 @@ class CarlaTransportInfo(Structure):
         ("bpm", c_double)
     ]
 
+# Patchbay group processing time information.
+# All times are in microseconds.
+# @see carla_get_patchbay_group_timing()
+class CarlaPatchbayGroupTiming(Structure):
+    _fields_ = [
+        # Time spent in the last audio cycle.
+        ("lastTime", c_float),
+
+        # Average time.
+        ("avgTime", c_float),
+
+        # Highest time seen so far.
+        ("maxTime", c_float),
+
+        # Longest average path from the graph inputs up to the end of this group.
+        ("pathTime", c_float),
+
+        # Average time of the whole critical path.
+        ("criticalPathTime", c_float),
+
+        # Wherever this group is part of the critical path.
+        ("critical", c_bool)
+    ]
+
+# Processing load information, of a single plugin or the whole engine.
+# Loads are in percent of the time available for one audio cycle (buffer size / sample rate).
+# Offline processing is not accounted for.
+# @see carla_get_plugin_dsp_load()
+# @see carla_get_engine_load()
+class CarlaDspLoadInfo(Structure):
+    _fields_ = [
+        # Load of the last audio cycle.
+        ("current", c_float),
+
+        # Average load.
+        ("average", c_float),
+
+        # Lowest load seen so far.
+        ("minimum", c_float),
+
+        # Highest load seen so far.
+        ("maximum", c_float),
+
+        # 95% of the audio cycles were at or below this load.
+        ("percentile95", c_float),
+
+        # 99% of the audio cycles were at or below this load.
+        ("percentile99", c_float),
+
+        # Number of audio cycles that took longer than the time available.
+        ("xruns", c_uint32),
+
+        # Number of audio cycles accounted for.
+        ("cycles", c_uint32)
+    ]
+
+# Round-trip timing of a plugin bridge, measured on the audio thread for every processed block.
+# Times are in microseconds.
+# In pipelined mode the bridge stage is only the time spent waiting for the bridge.
+# @see carla_get_plugin_bridge_latency()
+class CarlaBridgeLatencyInfo(Structure):
+    _fields_ = [
+        # Host writing the block into shared memory, smoothed average.
+        ("writeAverage", c_float),
+
+        # Host writing the block into shared memory, highest value seen.
+        ("writeMaximum", c_float),
+
+        # Bridge processing the block, smoothed average.
+        ("processAverage", c_float),
+
+        # Bridge processing the block, highest value seen.
+        ("processMaximum", c_float),
+
+        # Host reading back and post-processing the block, smoothed average.
+        ("readAverage", c_float),
+
+        # Host reading back and post-processing the block, highest value seen.
+        ("readMaximum", c_float),
+
+        # Full round-trip, smoothed average.
+        ("totalAverage", c_float),
+
+        # Full round-trip, highest value seen.
+        ("totalMaximum", c_float),
+
+        # 95% of the round-trips were at or below this time.
+        ("percentile95", c_float),
+
+        # 99% of the round-trips were at or below this time.
+        ("percentile99", c_float),
+
+        # Number of blocks over the soft deadline.
+        # @see ENGINE_OPTION_BRIDGE_SOFT_DEADLINE
+        ("slowBlocks", c_uint32),
+
+        # Number of blocks the bridge did not reply to in time.
+        ("timeouts", c_uint32),
+
+        # Number of blocks accounted for.
+        ("blocks", c_uint32),
+
+        # Round-trip histogram.
+        # Bucket 0 counts round-trips below 2 microseconds, bucket N those from 2^N up to 2^(N+1) microseconds.
+        # The last bucket also counts anything slower.
+        ("histogram", c_uint32 * 24)
+    ]
+
+# How often a plugin was run, for plugin types that split audio blocks at event times.
+# Both counters wrap around at 2^32, use carla_reset_plugin_sub_blocks() to start a new measurement.
+# @see ENGINE_OPTION_SPLIT_GRANULARITY
+# @see carla_get_plugin_sub_blocks()
+class CarlaSubBlockInfo(Structure):
+    _fields_ = [
+        # Number of audio blocks processed.
+        ("blocks", c_uint32),
+
+        # Number of plugin runs for those blocks, at least one per block.
+        ("subBlocks", c_uint32)
+    ]
+
+# Layout version of plugin snapshots.
+# Bumped whenever any of the snapshot structs below change.
+# @see CarlaPluginSnapshot
+PLUGIN_SNAPSHOT_VERSION = 1
+
+# Parameter entry of a plugin snapshot.
+# Strings are stored as byte offsets from the start of the snapshot, each pointing to null-terminated UTF-8 text.
+# @see CarlaPluginSnapshot
+class CarlaParameterSnapshot(Structure):
+    _fields_ = [
+        # Parameter data.
+        ("data", ParameterData),
+
+        # Parameter ranges.
+        ("ranges", ParameterRanges),
+
+        # Current parameter value.
+        ("value", c_float),
+
+        # Offset of the parameter name.
+        ("name", c_uint32),
+
+        # Offset of the parameter symbol.
+        ("symbol", c_uint32),
+
+        # Offset of the parameter unit.
+        ("unit", c_uint32),
+
+        # Offset of the text for the current value.
+        # Points to an empty string unless the parameter has PARAMETER_USES_CUSTOM_TEXT.
+        ("text", c_uint32),
+
+        # Index of this parameter's first scale point.
+        ("scalePointStart", c_uint32),
+
+        # Number of scale points.
+        ("scalePointCount", c_uint32)
+    ]
+
+# Scale point entry of a plugin snapshot.
+# @see CarlaPluginSnapshot
+class CarlaScalePointSnapshot(Structure):
+    _fields_ = [
+        # Scale point value.
+        ("value", c_float),
+
+        # Offset of the scale point label.
+        ("label", c_uint32)
+    ]
+
+# MIDI program entry of a plugin snapshot.
+# @see CarlaPluginSnapshot
+class CarlaMidiProgramSnapshot(Structure):
+    _fields_ = [
+        # MIDI bank.
+        ("bank", c_uint32),
+
+        # MIDI program.
+        ("program", c_uint32),
+
+        # Offset of the MIDI program name.
+        ("name", c_uint32)
+    ]
+
+# Snapshot of everything a frontend needs to show a plugin's parameters and programs.
+# This is the header of a single contiguous buffer of 'size' bytes, which holds all arrays and strings.
+# Every offset is in bytes, from the start of this struct.
+# @see carla_get_plugin_snapshot()
+class CarlaPluginSnapshot(Structure):
+    _fields_ = [
+        # Layout version, always check this against PLUGIN_SNAPSHOT_VERSION first.
+        ("version", c_uint32),
+
+        # Total size of the snapshot, in bytes.
+        ("size", c_uint32),
+
+        # Value generation this snapshot was taken at.
+        # @see carla_get_plugin_snapshot_changes()
+        ("generation", c_uint32),
+
+        # Number of parameters.
+        ("parameterCount", c_uint32),
+
+        # Number of scale points, for all parameters.
+        ("scalePointCount", c_uint32),
+
+        # Number of programs.
+        ("programCount", c_uint32),
+
+        # Number of MIDI programs.
+        ("midiProgramCount", c_uint32),
+
+        # Current program, or -1 if none.
+        ("currentProgram", c_int32),
+
+        # Current MIDI program, or -1 if none.
+        ("currentMidiProgram", c_int32),
+
+        # Offset of the parameters, an array of CarlaParameterSnapshot.
+        ("parameters", c_uint32),
+
+        # Offset of the scale points, an array of CarlaScalePointSnapshot.
+        ("scalePoints", c_uint32),
+
+        # Offset of the program names, an array of uint32_t string offsets.
+        ("programNames", c_uint32),
+
+        # Offset of the MIDI programs, an array of CarlaMidiProgramSnapshot.
+        ("midiPrograms", c_uint32)
+    ]
+
+# Parameter value change.
+# @see CarlaPluginSnapshotChanges
+class CarlaParameterChange(Structure):
+    _fields_ = [
+        # Parameter index.
+        ("index", c_uint32),
+
+        # New parameter value.
+        ("value", c_float)
+    ]
+
+# Parameter values that changed since a previous snapshot.
+# @see carla_get_plugin_snapshot_changes()
+class CarlaPluginSnapshotChanges(Structure):
+    _fields_ = [
+        # Current value generation, to pass on the next call.
+        ("generation", c_uint32),
+
+        # Parameters or programs were recreated since the requested generation.
+        # When true, the change list is empty and a new full snapshot is needed.
+        ("layoutChanged", c_bool),
+
+        # Current program, or -1 if none.
+        ("currentProgram", c_int32),
+
+        # Current MIDI program, or -1 if none.
+        ("currentMidiProgram", c_int32),
+
+        # Number of changed parameters.
+        ("count", c_uint32),
+
+        # Changed parameters, ordered by index.
+        ("changes", POINTER(CarlaParameterChange))
+    ]
+
 # ------------------------------------------------------------------------------------------------------------
 # Carla Host API (Python compatible stuff)
 
@@ -1173,6 +1561,74 @@ PyCarlaTransportInfo = {
     "bpm": 0.0
 }
 
+# @see CarlaPatchbayGroupTiming
+PyCarlaPatchbayGroupTiming = {
+    "lastTime": 0.0,
+    "avgTime": 0.0,
+    "maxTime": 0.0,
+    "pathTime": 0.0,
+    "criticalPathTime": 0.0,
+    "critical": False
+}
+
+# @see CarlaDspLoadInfo
+PyCarlaDspLoadInfo = {
+    "current": 0.0,
+    "average": 0.0,
+    "minimum": 0.0,
+    "maximum": 0.0,
+    "percentile95": 0.0,
+    "percentile99": 0.0,
+    "xruns": 0,
+    "cycles": 0
+}
+
+# @see CarlaBridgeLatencyInfo
+PyCarlaBridgeLatencyInfo = {
+    "writeAverage": 0.0,
+    "writeMaximum": 0.0,
+    "processAverage": 0.0,
+    "processMaximum": 0.0,
+    "readAverage": 0.0,
+    "readMaximum": 0.0,
+    "totalAverage": 0.0,
+    "totalMaximum": 0.0,
+    "percentile95": 0.0,
+    "percentile99": 0.0,
+    "slowBlocks": 0,
+    "timeouts": 0,
+    "blocks": 0,
+    "histogram": [0] * 24
+}
+
+# @see CarlaSubBlockInfo
+PyCarlaSubBlockInfo = {
+    "blocks": 0,
+    "subBlocks": 0
+}
+
+# @see CarlaPluginSnapshot
+# Each parameter is a dict with the keys of get_parameter_info(), get_parameter_data() and get_parameter_ranges(),
+# plus 'text', 'scalePoints' (as in get_parameter_scalepoint_info()) and 'current'.
+PyCarlaPluginSnapshot = {
+    'generation': 0,
+    'parameters': [],
+    'programNames': [],
+    'currentProgram': -1,
+    'midiPrograms': [],
+    'currentMidiProgram': -1
+}
+
+# @see CarlaPluginSnapshotChanges
+# Changes are (index, value) tuples.
+PyCarlaPluginSnapshotChanges = {
+    'generation': 0,
+    'layoutChanged': False,
+    'currentProgram': -1,
+    'currentMidiProgram': -1,
+    'changes': []
+}
+
 # ------------------------------------------------------------------------------------------------------------
 # Set BINARY_NATIVE
 
@@ -1334,6 +1790,14 @@ class CarlaHostMeta(object):
     def patchbay_refresh(self, external):
         raise NotImplementedError
 
+    # Get the processing time information of a patchbay group.
+    # Only valid in patchbay engine mode with ENGINE_OPTION_PROCESS_THREADS bigger than 1,
+    # all values are zero otherwise.
+    # @param groupId Group Id
+    @abstractmethod
+    def get_patchbay_group_timing(self, groupId):
+        raise NotImplementedError
+
     # Start playback of the engine transport.
     @abstractmethod
     def transport_play(self):
@@ -1359,6 +1823,17 @@ class CarlaHostMeta(object):
     def get_transport_info(self):
         raise NotImplementedError
 
+    # Render the engine master output into an audio file, as fast as possible.
+    # The file format is guessed from the extension, either WAV or FLAC.
+    # This call blocks until rendering is done, progress is reported via ENGINE_CALLBACK_RENDER_PROGRESS.
+    # Only valid when using the "Offline" engine driver.
+    # @param filename   Audio file to write
+    # @param startFrame First frame to render
+    # @param endFrame   Frame to stop rendering at (not included)
+    @abstractmethod
+    def engine_render(self, filename, startFrame, endFrame):
+        raise NotImplementedError
+
     # Current number of plugins loaded.
     @abstractmethod
     def get_current_plugin_count(self):
@@ -1612,6 +2087,21 @@ class CarlaHostMeta(object):
     def get_internal_parameter_value(self, pluginId, parameterId):
         raise NotImplementedError
 
+    # Get a snapshot of all of a plugin's parameters, scale points, values and programs, in a single call.
+    # This replaces calling the per-parameter functions above for every parameter.
+    # @param pluginId Plugin
+    @abstractmethod
+    def get_plugin_snapshot(self, pluginId):
+        raise NotImplementedError
+
+    # Get the parameter values of a plugin that changed after a previous snapshot or change list.
+    # Only changed values are returned, making this cheap enough for periodic refreshes.
+    # @param pluginId   Plugin
+    # @param generation Generation of the previous snapshot or change list
+    @abstractmethod
+    def get_plugin_snapshot_changes(self, pluginId, generation):
+        raise NotImplementedError
+
     # Get a plugin's input peak value.
     # @param pluginId Plugin
     # @param isLeft   Wherever to get the left/mono value, otherwise right.
@@ -1626,6 +2116,41 @@ class CarlaHostMeta(object):
     def get_output_peak_value(self, pluginId, isLeft):
         raise NotImplementedError
 
+    # Get a plugin's processing load.
+    # @param pluginId Plugin
+    @abstractmethod
+    def get_plugin_dsp_load(self, pluginId):
+        raise NotImplementedError
+
+    # Get a plugin bridge's round-trip timing.
+    # All values are zero if the plugin is not a bridge.
+    # @param pluginId Plugin
+    @abstractmethod
+    def get_plugin_bridge_latency(self, pluginId):
+        raise NotImplementedError
+
+    # Reset a plugin bridge's round-trip timing.
+    # Does nothing if the plugin is not a bridge.
+    # @param pluginId Plugin
+    @abstractmethod
+    def reset_plugin_bridge_latency(self, pluginId):
+        raise NotImplementedError
+
+    # Get how many sub-blocks a plugin was run in.
+    # Only LADSPA, DSSI, LV2 and VST2 plugins split blocks, all values are zero for other plugin types.
+    # @param pluginId Plugin
+    # @see ENGINE_OPTION_SPLIT_GRANULARITY
+    @abstractmethod
+    def get_plugin_sub_blocks(self, pluginId):
+        raise NotImplementedError
+
+    # Reset a plugin's sub-block counters.
+    # They are cleared before the plugin processes its next block.
+    # @param pluginId Plugin
+    @abstractmethod
+    def reset_plugin_sub_blocks(self, pluginId):
+        raise NotImplementedError
+
     # Enable a plugin's option.
     # @param pluginId Plugin
     # @param option   An option from PluginOptions
@@ -1786,6 +2311,11 @@ class CarlaHostMeta(object):
     def get_sample_rate(self):
         raise NotImplementedError
 
+    # Get the processing load of the whole engine.
+    @abstractmethod
+    def get_engine_load(self):
+        raise NotImplementedError
+
     # Get the last error.
     @abstractmethod
     def get_last_error(self):
@@ -1871,6 +2401,9 @@ class CarlaHostNull(CarlaHostMeta):
     def patchbay_refresh(self, external):
         return False
 
+    def get_patchbay_group_timing(self, groupId):
+        return PyCarlaPatchbayGroupTiming
+
     def transport_play(self):
         return
 
@@ -1886,6 +2419,9 @@ class CarlaHostNull(CarlaHostMeta):
     def get_transport_info(self):
         return PyCarlaTransportInfo
 
+    def engine_render(self, filename, startFrame, endFrame):
+        return False
+
     def get_current_plugin_count(self):
         return 0
 
@@ -1991,12 +2527,33 @@ class CarlaHostNull(CarlaHostMeta):
     def get_internal_parameter_value(self, pluginId, parameterId):
         return 0.0
 
+    def get_plugin_snapshot(self, pluginId):
+        return PyCarlaPluginSnapshot
+
+    def get_plugin_snapshot_changes(self, pluginId, generation):
+        return PyCarlaPluginSnapshotChanges
+
     def get_input_peak_value(self, pluginId, isLeft):
         return 0.0
 
     def get_output_peak_value(self, pluginId, isLeft):
         return 0.0
 
+    def get_plugin_dsp_load(self, pluginId):
+        return PyCarlaDspLoadInfo
+
+    def get_plugin_bridge_latency(self, pluginId):
+        return PyCarlaBridgeLatencyInfo
+
+    def reset_plugin_bridge_latency(self, pluginId):
+        return
+
+    def get_plugin_sub_blocks(self, pluginId):
+        return PyCarlaSubBlockInfo
+
+    def reset_plugin_sub_blocks(self, pluginId):
+        return
+
     def set_option(self, pluginId, option, yesNo):
         return
 
@@ -2063,6 +2620,9 @@ class CarlaHostNull(CarlaHostMeta):
     def get_sample_rate(self):
         return 0.0
 
+    def get_engine_load(self):
+        return PyCarlaDspLoadInfo
+
     def get_last_error(self):
         return ""
 
@@ -2142,6 +2702,9 @@ class CarlaHostDLL(CarlaHostMeta):
         self.lib.carla_patchbay_refresh.argtypes = [c_bool]
         self.lib.carla_patchbay_refresh.restype = c_bool
 
+        self.lib.carla_get_patchbay_group_timing.argtypes = [c_uint]
+        self.lib.carla_get_patchbay_group_timing.restype = POINTER(CarlaPatchbayGroupTiming)
+
         self.lib.carla_transport_play.argtypes = None
         self.lib.carla_transport_play.restype = None
 
@@ -2157,6 +2720,9 @@ class CarlaHostDLL(CarlaHostMeta):
         self.lib.carla_get_transport_info.argtypes = None
         self.lib.carla_get_transport_info.restype = POINTER(CarlaTransportInfo)
 
+        self.lib.carla_engine_render.argtypes = [c_char_p, c_uint64, c_uint64]
+        self.lib.carla_engine_render.restype = c_bool
+
         self.lib.carla_get_current_plugin_count.argtypes = None
         self.lib.carla_get_current_plugin_count.restype = c_uint32
 
@@ -2262,12 +2828,33 @@ class CarlaHostDLL(CarlaHostMeta):
         self.lib.carla_get_internal_parameter_value.argtypes = [c_uint, c_int32]
         self.lib.carla_get_internal_parameter_value.restype = c_float
 
+        self.lib.carla_get_plugin_snapshot.argtypes = [c_uint]
+        self.lib.carla_get_plugin_snapshot.restype = POINTER(CarlaPluginSnapshot)
+
+        self.lib.carla_get_plugin_snapshot_changes.argtypes = [c_uint, c_uint32]
+        self.lib.carla_get_plugin_snapshot_changes.restype = POINTER(CarlaPluginSnapshotChanges)
+
         self.lib.carla_get_input_peak_value.argtypes = [c_uint, c_bool]
         self.lib.carla_get_input_peak_value.restype = c_float
 
         self.lib.carla_get_output_peak_value.argtypes = [c_uint, c_bool]
         self.lib.carla_get_output_peak_value.restype = c_float
 
+        self.lib.carla_get_plugin_dsp_load.argtypes = [c_uint]
+        self.lib.carla_get_plugin_dsp_load.restype = POINTER(CarlaDspLoadInfo)
+
+        self.lib.carla_get_plugin_bridge_latency.argtypes = [c_uint]
+        self.lib.carla_get_plugin_bridge_latency.restype = POINTER(CarlaBridgeLatencyInfo)
+
+        self.lib.carla_reset_plugin_bridge_latency.argtypes = [c_uint]
+        self.lib.carla_reset_plugin_bridge_latency.restype = None
+
+        self.lib.carla_get_plugin_sub_blocks.argtypes = [c_uint]
+        self.lib.carla_get_plugin_sub_blocks.restype = POINTER(CarlaSubBlockInfo)
+
+        self.lib.carla_reset_plugin_sub_blocks.argtypes = [c_uint]
+        self.lib.carla_reset_plugin_sub_blocks.restype = None
+
         self.lib.carla_set_option.argtypes = [c_uint, c_uint, c_bool]
         self.lib.carla_set_option.restype = None
 
@@ -2334,6 +2921,9 @@ class CarlaHostDLL(CarlaHostMeta):
         self.lib.carla_get_sample_rate.argtypes = None
         self.lib.carla_get_sample_rate.restype = c_double
 
+        self.lib.carla_get_engine_load.argtypes = None
+        self.lib.carla_get_engine_load.restype = POINTER(CarlaDspLoadInfo)
+
         self.lib.carla_get_last_error.argtypes = None
         self.lib.carla_get_last_error.restype = c_char_p
 
@@ -2401,6 +2991,9 @@ class CarlaHostDLL(CarlaHostMeta):
     def patchbay_refresh(self, external):
         return bool(self.lib.carla_patchbay_refresh(external))
 
+    def get_patchbay_group_timing(self, groupId):
+        return structToDict(self.lib.carla_get_patchbay_group_timing(groupId).contents)
+
     def transport_play(self):
         self.lib.carla_transport_play()
 
@@ -2416,6 +3009,9 @@ class CarlaHostDLL(CarlaHostMeta):
     def get_transport_info(self):
         return structToDict(self.lib.carla_get_transport_info().contents)
 
+    def engine_render(self, filename, startFrame, endFrame):
+        return bool(self.lib.carla_engine_render(filename.encode("utf-8"), startFrame, endFrame))
+
     def get_current_plugin_count(self):
         return int(self.lib.carla_get_current_plugin_count())
 
@@ -2524,12 +3120,47 @@ class CarlaHostDLL(CarlaHostMeta):
     def get_internal_parameter_value(self, pluginId, parameterId):
         return float(self.lib.carla_get_internal_parameter_value(pluginId, parameterId))
 
+    def get_plugin_snapshot(self, pluginId):
+        snapshotPtr = self.lib.carla_get_plugin_snapshot(pluginId)
+
+        if snapshotPtr.contents.version != PLUGIN_SNAPSHOT_VERSION:
+            print("get_plugin_snapshot(%i) - unsupported snapshot version %i" % (pluginId, snapshotPtr.contents.version))
+            return PyCarlaPluginSnapshot
+
+        return snapshotToDict(string_at(snapshotPtr, snapshotPtr.contents.size))
+
+    def get_plugin_snapshot_changes(self, pluginId, generation):
+        changes = self.lib.carla_get_plugin_snapshot_changes(pluginId, generation).contents
+
+        return {
+            'generation': changes.generation,
+            'layoutChanged': changes.layoutChanged,
+            'currentProgram': changes.currentProgram,
+            'currentMidiProgram': changes.currentMidiProgram,
+            'changes': [(changes.changes[i].index, changes.changes[i].value) for i in range(changes.count)]
+        }
+
     def get_input_peak_value(self, pluginId, isLeft):
         return float(self.lib.carla_get_input_peak_value(pluginId, isLeft))
 
     def get_output_peak_value(self, pluginId, isLeft):
         return float(self.lib.carla_get_output_peak_value(pluginId, isLeft))
 
+    def get_plugin_dsp_load(self, pluginId):
+        return structToDict(self.lib.carla_get_plugin_dsp_load(pluginId).contents)
+
+    def get_plugin_bridge_latency(self, pluginId):
+        return structToDict(self.lib.carla_get_plugin_bridge_latency(pluginId).contents)
+
+    def reset_plugin_bridge_latency(self, pluginId):
+        self.lib.carla_reset_plugin_bridge_latency(pluginId)
+
+    def get_plugin_sub_blocks(self, pluginId):
+        return structToDict(self.lib.carla_get_plugin_sub_blocks(pluginId).contents)
+
+    def reset_plugin_sub_blocks(self, pluginId):
+        self.lib.carla_reset_plugin_sub_blocks(pluginId)
+
     def set_option(self, pluginId, option, yesNo):
         self.lib.carla_set_option(pluginId, option, yesNo)
 
@@ -2596,6 +3227,9 @@ class CarlaHostDLL(CarlaHostMeta):
     def get_sample_rate(self):
         return float(self.lib.carla_get_sample_rate())
 
+    def get_engine_load(self):
+        return structToDict(self.lib.carla_get_engine_load().contents)
+
     def get_last_error(self):
         return charPtrToString(self.lib.carla_get_last_error())
 
@@ -2720,6 +3354,9 @@ class CarlaHostPlugin(CarlaHostMeta):
         # don't send external param, never used in plugins
         return self.sendMsgAndSetError(["patchbay_refresh"])
 
+    def get_patchbay_group_timing(self, groupId):
+        return PyCarlaPatchbayGroupTiming
+
     def transport_play(self):
         self.sendMsg(["transport_play"])
 
@@ -2735,6 +3372,9 @@ class CarlaHostPlugin(CarlaHostMeta):
     def get_transport_info(self):
         return self.fTransportInfo
 
+    def engine_render(self, filename, startFrame, endFrame):
+        return False
+
     def get_current_plugin_count(self):
         return len(self.fPluginsInfo)
 
@@ -2849,12 +3489,67 @@ class CarlaHostPlugin(CarlaHostMeta):
 
         return self.fPluginsInfo[pluginId].parameterValues[parameterId]
 
+    def get_plugin_snapshot(self, pluginId):
+        info       = self.fPluginsInfo[pluginId]
+        parameters = []
+
+        for i in range(info.parameterCount):
+            parameter = dict(info.parameterInfo[i])
+            parameter.update(info.parameterData[i])
+            parameter.update(info.parameterRanges[i])
+            parameter.update({
+                'text': "",
+                'scalePoints': [],
+                'current': info.parameterValues[i]
+            })
+            parameters.append(parameter)
+
+        return {
+            'generation': 0,
+            'parameters': parameters,
+            'programNames': list(info.programNames),
+            'currentProgram': info.programCurrent,
+            'midiPrograms': [{
+                'bank': mpData['bank'],
+                'program': mpData['program'],
+                'name': mpData['name'] or ""
+            } for mpData in info.midiProgramData],
+            'currentMidiProgram': info.midiProgramCurrent
+        }
+
+    # values are already cached here, so all of them are returned
+    def get_plugin_snapshot_changes(self, pluginId, generation):
+        info = self.fPluginsInfo[pluginId]
+
+        return {
+            'generation': 0,
+            'layoutChanged': False,
+            'currentProgram': info.programCurrent,
+            'currentMidiProgram': info.midiProgramCurrent,
+            'changes': list(enumerate(info.parameterValues))
+        }
+
     def get_input_peak_value(self, pluginId, isLeft):
         return self.fPluginsInfo[pluginId].peaks[0 if isLeft else 1]
 
     def get_output_peak_value(self, pluginId, isLeft):
         return self.fPluginsInfo[pluginId].peaks[2 if isLeft else 3]
 
+    def get_plugin_dsp_load(self, pluginId):
+        return PyCarlaDspLoadInfo
+
+    def get_plugin_bridge_latency(self, pluginId):
+        return PyCarlaBridgeLatencyInfo
+
+    def reset_plugin_bridge_latency(self, pluginId):
+        return
+
+    def get_plugin_sub_blocks(self, pluginId):
+        return PyCarlaSubBlockInfo
+
+    def reset_plugin_sub_blocks(self, pluginId):
+        return
+
     def set_option(self, pluginId, option, yesNo):
         self.sendMsg(["set_option", pluginId, option, yesNo])
 
@@ -2921,6 +3616,9 @@ class CarlaHostPlugin(CarlaHostMeta):
     def get_sample_rate(self):
         return self.fSampleRate
 
+    def get_engine_load(self):
+        return PyCarlaDspLoadInfo
+
     def get_last_error(self):
         return self.fLastError
 
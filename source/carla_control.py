@@ -59,7 +59,8 @@ class ControlPluginInfo(object):
         'midiProgramCount',
         'midiProgramCurrent',
         'midiProgramDataS',
-        'peaks'
+        'peaks',
+        'dspLoad'
     ]
 
 # ------------------------------------------------------------------------------------------------------------
@@ -92,6 +93,7 @@ class Host(object):
         info.midiProgramCurrent = -1
         info.midiProgramDataS = []
         info.peaks = [0.0, 0.0, 0.0, 0.0]
+        info.dspLoad = PyCarlaDspLoadInfo
         self.fPluginsInfo.append(info)
 
     def _set_pluginInfo(self, index, info):
@@ -187,6 +189,9 @@ class Host(object):
     def _set_peaks(self, index, in1, in2, out1, out2):
         self.fPluginsInfo[index].peaks = [in1, in2, out1, out2]
 
+    def _set_dspLoad(self, index, data):
+        self.fPluginsInfo[index].dspLoad = data
+
     # get_extended_license_text
     # get_supported_file_types
     # get_engine_driver_count
@@ -297,6 +302,9 @@ class Host(object):
     def get_output_peak_value(self, pluginId, portId):
         return self.fPluginsInfo[pluginId].peaks[portId+1]
 
+    def get_plugin_dsp_load(self, pluginId):
+        return self.fPluginsInfo[pluginId].dspLoad
+
     def set_option(self, pluginId, option, yesNo):
         global to_target, lo_targetName
         lo_path = "/%s/%i/set_option" % (lo_targetName, pluginId)
@@ -496,6 +504,11 @@ class ControlServer(ServerThread):
         pluginId, in1, in2, out1, out2 = args
         self.fParent.emit(SIGNAL("SetPeaks(int, double, double, double, double)"), pluginId, in1, in2, out1, out2)
 
+    @make_method('/carla-control/set_dsp_load', 'iffffffii')
+    def set_dsp_load_callback(self, path, args):
+        pluginId, current, average, minimum, maximum, percentile95, percentile99, xruns, cycles = args
+        self.fParent.emit(SIGNAL("SetDspLoad(int, double, double, double, double, double, double, int, int)"), pluginId, current, average, minimum, maximum, percentile95, percentile99, xruns, cycles)
+
     @make_method('/carla-control/exit', '')
     def exit_callback(self, path, args):
         self.fParent.emit(SIGNAL("Exit()"))
@@ -585,6 +598,7 @@ class CarlaControlW(QMainWindow):
         #self.connect(self, SIGNAL("NoteOn(int, int, int, int)"), SLOT("slot_handleNoteOn(int, int, int, int)"))
         #self.connect(self, SIGNAL("NoteOff(int, int, int)"), SLOT("slot_handleNoteOff(int, int, int)"))
         #self.connect(self, SIGNAL("SetPeaks(int, double, double, double, double)"), SLOT("slot_handleSetPeaks(int, double, double, double, double)"))
+        #self.connect(self, SIGNAL("SetDspLoad(int, double, double, double, double, double, double, int, int)"), SLOT("slot_handleSetDspLoad(int, double, double, double, double, double, double, int, int)"))
         #self.connect(self, SIGNAL("Exit()"), SLOT("slot_handleExit()"))
 
         if oscAddr:
@@ -914,6 +928,19 @@ class CarlaControlW(QMainWindow):
     def slot_handleSetPeaks(self, pluginId, in1, in2, out1, out2):
         gCarla.host._set_peaks(pluginId, in1, in2, out1, out2)
 
+    @pyqtSlot(int, float, float, float, float, float, float, int, int)
+    def slot_handleSetDspLoad(self, pluginId, current, average, minimum, maximum, percentile95, percentile99, xruns, cycles):
+        gCarla.host._set_dspLoad(pluginId, {
+            'current': current,
+            'average': average,
+            'minimum': minimum,
+            'maximum': maximum,
+            'percentile95': percentile95,
+            'percentile99': percentile99,
+            'xruns': xruns,
+            'cycles': cycles
+        })
+
     @pyqtSlot()
     def slot_handleExit(self):
         self.removeAll()
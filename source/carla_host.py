@@ -1977,6 +1977,8 @@ def engineCallback(host, action, pluginId, value1, value2, value3, valueStr):
         host.ErrorCallback.emit(valueStr)
     elif action == ENGINE_CALLBACK_QUIT:
         host.QuitCallback.emit()
+    elif action == ENGINE_CALLBACK_RENDER_PROGRESS:
+        QApplication.instance().processEvents()
 
 # ------------------------------------------------------------------------------------------------------------
 # File callback
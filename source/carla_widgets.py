@@ -519,6 +519,7 @@ class PluginEdit(QDialog):
 
         self.ui.ch_fixed_buffer.clicked.connect(self.slot_optionChanged)
         self.ui.ch_force_stereo.clicked.connect(self.slot_optionChanged)
+        self.ui.ch_skip_silence.clicked.connect(self.slot_optionChanged)
         self.ui.ch_map_program_changes.clicked.connect(self.slot_optionChanged)
         self.ui.ch_use_chunks.clicked.connect(self.slot_optionChanged)
         self.ui.ch_send_program_changes.clicked.connect(self.slot_optionChanged)
@@ -721,6 +722,8 @@ class PluginEdit(QDialog):
         self.ui.ch_fixed_buffer.setChecked(self.fPluginInfo['optionsEnabled'] & PLUGIN_OPTION_FIXED_BUFFERS)
         self.ui.ch_force_stereo.setEnabled(self.fPluginInfo['optionsAvailable'] & PLUGIN_OPTION_FORCE_STEREO)
         self.ui.ch_force_stereo.setChecked(self.fPluginInfo['optionsEnabled'] & PLUGIN_OPTION_FORCE_STEREO)
+        self.ui.ch_skip_silence.setEnabled(self.fPluginInfo['optionsAvailable'] & PLUGIN_OPTION_SKIP_SILENCE)
+        self.ui.ch_skip_silence.setChecked(self.fPluginInfo['optionsEnabled'] & PLUGIN_OPTION_SKIP_SILENCE)
         self.ui.ch_map_program_changes.setEnabled(self.fPluginInfo['optionsAvailable'] & PLUGIN_OPTION_MAP_PROGRAM_CHANGES)
         self.ui.ch_map_program_changes.setChecked(self.fPluginInfo['optionsEnabled'] & PLUGIN_OPTION_MAP_PROGRAM_CHANGES)
         self.ui.ch_send_control_changes.setEnabled(self.fPluginInfo['optionsAvailable'] & PLUGIN_OPTION_SEND_CONTROL_CHANGES)
@@ -778,45 +781,35 @@ class PluginEdit(QDialog):
         paramInputListFull  = [] # ([params], width)
         paramOutputListFull = [] # ([params], width)
 
-        for i in range(min(parameterCount, self.host.maxParameters)):
-            paramInfo   = self.host.get_parameter_info(self.fPluginId, i)
-            paramData   = self.host.get_parameter_data(self.fPluginId, i)
-            paramRanges = self.host.get_parameter_ranges(self.fPluginId, i)
-            paramValue  = self.host.get_current_parameter_value(self.fPluginId, i)
+        # everything in one call, instead of several per parameter
+        snapshot = self.host.get_plugin_snapshot(self.fPluginId)
 
-            if paramData['type'] not in (PARAMETER_INPUT, PARAMETER_OUTPUT):
+        for paramSnapshot in snapshot['parameters'][:self.host.maxParameters]:
+            if paramSnapshot['type'] not in (PARAMETER_INPUT, PARAMETER_OUTPUT):
                 continue
-            if (paramData['hints'] & PARAMETER_IS_ENABLED) == 0:
+            if (paramSnapshot['hints'] & PARAMETER_IS_ENABLED) == 0:
                 continue
 
             parameter = {
-                'type':  paramData['type'],
-                'hints': paramData['hints'],
-                'name':  paramInfo['name'],
-                'unit':  paramInfo['unit'],
-                'scalePoints': [],
-
-                'index':   paramData['index'],
-                'default': paramRanges['def'],
-                'minimum': paramRanges['min'],
-                'maximum': paramRanges['max'],
-                'step':    paramRanges['step'],
-                'stepSmall': paramRanges['stepSmall'],
-                'stepLarge': paramRanges['stepLarge'],
-                'midiCC':    paramData['midiCC'],
-                'midiChannel': paramData['midiChannel']+1,
-
-                'current': paramValue
+                'type':  paramSnapshot['type'],
+                'hints': paramSnapshot['hints'],
+                'name':  paramSnapshot['name'],
+                'unit':  paramSnapshot['unit'],
+                'scalePoints': paramSnapshot['scalePoints'],
+
+                'index':   paramSnapshot['index'],
+                'default': paramSnapshot['def'],
+                'minimum': paramSnapshot['min'],
+                'maximum': paramSnapshot['max'],
+                'step':    paramSnapshot['step'],
+                'stepSmall': paramSnapshot['stepSmall'],
+                'stepLarge': paramSnapshot['stepLarge'],
+                'midiCC':    paramSnapshot['midiCC'],
+                'midiChannel': paramSnapshot['midiChannel']+1,
+
+                'current': paramSnapshot['current']
             }
 
-            for j in range(paramInfo['scalePointCount']):
-                scalePointInfo = self.host.get_parameter_scalepoint_info(self.fPluginId, i, j)
-
-                parameter['scalePoints'].append({
-                    'value': scalePointInfo['value'],
-                    'label': scalePointInfo['label']
-                })
-
             #parameter['name'] = parameter['name'][:30] + (parameter['name'][30:] and "...")
 
             # -----------------------------------------------------------------
@@ -848,7 +841,7 @@ class PluginEdit(QDialog):
                     paramOutputList  = []
                     paramOutputWidth = 0
 
-        # for i in range(parameterCount)
+        # for paramSnapshot in snapshot
         else:
             # Final page width values
             if 0 < len(paramInputList) < 10:
@@ -991,6 +984,8 @@ class PluginEdit(QDialog):
             widget = self.ui.ch_fixed_buffer
         elif option == PLUGIN_OPTION_FORCE_STEREO:
             widget = self.ui.ch_force_stereo
+        elif option == PLUGIN_OPTION_SKIP_SILENCE:
+            widget = self.ui.ch_skip_silence
         elif option == PLUGIN_OPTION_MAP_PROGRAM_CHANGES:
             widget = self.ui.ch_map_program_changes
         elif option == PLUGIN_OPTION_SEND_PROGRAM_CHANGES:
@@ -1176,6 +1171,8 @@ class PluginEdit(QDialog):
             option = PLUGIN_OPTION_FIXED_BUFFERS
         elif sender == self.ui.ch_force_stereo:
             option = PLUGIN_OPTION_FORCE_STEREO
+        elif sender == self.ui.ch_skip_silence:
+            option = PLUGIN_OPTION_SKIP_SILENCE
         elif sender == self.ui.ch_map_program_changes:
             option = PLUGIN_OPTION_MAP_PROGRAM_CHANGES
         elif sender == self.ui.ch_send_program_changes:
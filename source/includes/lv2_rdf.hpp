@@ -555,6 +555,7 @@ struct LV2_RDF_Descriptor {
     const char* Binary;
     const char* Bundle;
     ulong UniqueID;
+    bool HasDefaultState;
 
     uint32_t PortCount;
     LV2_RDF_Port* Ports;
@@ -579,6 +580,7 @@ struct LV2_RDF_Descriptor {
           Binary(nullptr),
           Bundle(nullptr),
           UniqueID(0),
+          HasDefaultState(false),
           PortCount(0),
           Ports(nullptr),
           PresetCount(0),
@@ -395,10 +395,16 @@ __cdecl void jackbridge_sem_destroy(void* sem) noexcept;
 __cdecl bool jackbridge_sem_post(void* sem) noexcept;
 __cdecl bool jackbridge_sem_timedwait(void* sem, uint secs, bool* timedOut) noexcept;
 
+__cdecl bool jackbridge_futex_sem_init(void* sem) noexcept;
+__cdecl bool jackbridge_futex_sem_post(void* sem) noexcept;
+__cdecl bool jackbridge_futex_sem_timedwait(void* sem, uint secs, bool* timedOut) noexcept;
+
 __cdecl bool  jackbridge_shm_is_valid(const void* shm) noexcept;
 __cdecl void  jackbridge_shm_init(void* shm) noexcept;
 __cdecl void  jackbridge_shm_attach(void* shm, const char* name) noexcept;
+__cdecl void  jackbridge_shm_create_temp(void* shm, char* fileBase) noexcept;
 __cdecl void  jackbridge_shm_close(void* shm) noexcept;
 __cdecl void* jackbridge_shm_map(void* shm, size_t size) noexcept;
+__cdecl void  jackbridge_shm_unmap(void* shm, void* ptr) noexcept;
 
 #endif // JACKBRIDGE_HPP_INCLUDED
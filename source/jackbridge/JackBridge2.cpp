@@ -73,6 +73,48 @@ bool jackbridge_sem_timedwait(void* sem, uint secs, bool* timedOut) noexcept
 
 // -----------------------------------------------------------------------------
 
+bool jackbridge_futex_sem_init(void* sem) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(sem != nullptr, false);
+#if defined(JACKBRIDGE_DUMMY) || ! defined(CARLA_OS_LINUX)
+    return false;
+#else
+    carla_futex_sem_init((carla_futex_sem_t*)sem);
+    return true;
+#endif
+}
+
+bool jackbridge_futex_sem_post(void* sem) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(sem != nullptr, false);
+#if defined(JACKBRIDGE_DUMMY) || ! defined(CARLA_OS_LINUX)
+    return false;
+#else
+    return carla_futex_sem_post((carla_futex_sem_t*)sem);
+#endif
+}
+
+bool jackbridge_futex_sem_timedwait(void* sem, uint secs, bool* timedOut) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(sem != nullptr, false);
+    CARLA_SAFE_ASSERT_RETURN(timedOut != nullptr, false);
+#if defined(JACKBRIDGE_DUMMY) || ! defined(CARLA_OS_LINUX)
+    (void)secs;
+    *timedOut = false;
+    return false;
+#else
+    if (carla_futex_sem_timedwait_ms((carla_futex_sem_t*)sem, secs*1000))
+    {
+        *timedOut = false;
+        return true;
+    }
+    *timedOut = (errno == ETIMEDOUT);
+    return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
 bool jackbridge_shm_is_valid(const void* shm) noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(shm != nullptr, false);
@@ -101,6 +143,15 @@ void jackbridge_shm_attach(void* shm, const char* name) noexcept
 #endif
 }
 
+void jackbridge_shm_create_temp(void* shm, char* fileBase) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(shm != nullptr,);
+
+#ifndef JACKBRIDGE_DUMMY
+    *(shm_t*)shm = carla_shm_create_temp(fileBase);
+#endif
+}
+
 void jackbridge_shm_close(void* shm) noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(shm != nullptr,);
@@ -121,4 +172,13 @@ void* jackbridge_shm_map(void* shm, size_t size) noexcept
 #endif
 }
 
+void jackbridge_shm_unmap(void* shm, void* ptr) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(shm != nullptr,);
+
+#ifndef JACKBRIDGE_DUMMY
+    carla_shm_unmap(*(shm_t*)shm, ptr);
+#endif
+}
+
 // -----------------------------------------------------------------------------
@@ -128,11 +128,16 @@ const JackBridgeExportedFunctions* jackbridge_get_exported_functions()
     funcs.sem_destroy_ptr                      = jackbridge_sem_destroy;
     funcs.sem_post_ptr                         = jackbridge_sem_post;
     funcs.sem_timedwait_ptr                    = jackbridge_sem_timedwait;
+    funcs.futex_sem_init_ptr                   = jackbridge_futex_sem_init;
+    funcs.futex_sem_post_ptr                   = jackbridge_futex_sem_post;
+    funcs.futex_sem_timedwait_ptr              = jackbridge_futex_sem_timedwait;
     funcs.shm_is_valid_ptr                     = jackbridge_shm_is_valid;
     funcs.shm_init_ptr                         = jackbridge_shm_init;
     funcs.shm_attach_ptr                       = jackbridge_shm_attach;
+    funcs.shm_create_temp_ptr                  = jackbridge_shm_create_temp;
     funcs.shm_close_ptr                        = jackbridge_shm_close;
     funcs.shm_map_ptr                          = jackbridge_shm_map;
+    funcs.shm_unmap_ptr                        = jackbridge_shm_unmap;
 
     return &funcs;
 }
@@ -545,6 +545,21 @@ bool jackbridge_sem_timedwait(void* sem, uint secs, bool* timedOut) noexcept
     return getBridgeInstance().sem_timedwait_ptr(sem, secs, timedOut);
 }
 
+bool jackbridge_futex_sem_init(void* sem) noexcept
+{
+    return getBridgeInstance().futex_sem_init_ptr(sem);
+}
+
+bool jackbridge_futex_sem_post(void* sem) noexcept
+{
+    return getBridgeInstance().futex_sem_post_ptr(sem);
+}
+
+bool jackbridge_futex_sem_timedwait(void* sem, uint secs, bool* timedOut) noexcept
+{
+    return getBridgeInstance().futex_sem_timedwait_ptr(sem, secs, timedOut);
+}
+
 bool jackbridge_shm_is_valid(const void* shm) noexcept
 {
     return getBridgeInstance().shm_is_valid_ptr(shm);
@@ -560,6 +575,11 @@ void jackbridge_shm_attach(void* shm, const char* name) noexcept
     return getBridgeInstance().shm_attach_ptr(shm, name);
 }
 
+void jackbridge_shm_create_temp(void* shm, char* fileBase) noexcept
+{
+    return getBridgeInstance().shm_create_temp_ptr(shm, fileBase);
+}
+
 void jackbridge_shm_close(void* shm) noexcept
 {
     return getBridgeInstance().shm_close_ptr(shm);
@@ -570,4 +590,9 @@ void* jackbridge_shm_map(void* shm, size_t size) noexcept
     return getBridgeInstance().shm_map_ptr(shm, size);
 }
 
+void jackbridge_shm_unmap(void* shm, void* ptr) noexcept
+{
+    return getBridgeInstance().shm_unmap_ptr(shm, ptr);
+}
+
 // -----------------------------------------------------------------------------
@@ -112,11 +112,16 @@ typedef bool (__cdecl *jackbridgesym_sem_init)(void* sem);
 typedef void (__cdecl *jackbridgesym_sem_destroy)(void* sem);
 typedef bool (__cdecl *jackbridgesym_sem_post)(void* sem);
 typedef bool (__cdecl *jackbridgesym_sem_timedwait)(void* sem, uint secs, bool* timedOut);
+typedef bool (__cdecl *jackbridgesym_futex_sem_init)(void* sem);
+typedef bool (__cdecl *jackbridgesym_futex_sem_post)(void* sem);
+typedef bool (__cdecl *jackbridgesym_futex_sem_timedwait)(void* sem, uint secs, bool* timedOut);
 typedef bool (__cdecl *jackbridgesym_shm_is_valid)(const void* shm);
 typedef void (__cdecl *jackbridgesym_shm_init)(void* shm);
 typedef void (__cdecl *jackbridgesym_shm_attach)(void* shm, const char* name);
+typedef void (__cdecl *jackbridgesym_shm_create_temp)(void* shm, char* fileBase);
 typedef void (__cdecl *jackbridgesym_shm_close)(void* shm);
 typedef void* (__cdecl *jackbridgesym_shm_map)(void* shm, size_t size);
+typedef void (__cdecl *jackbridgesym_shm_unmap)(void* shm, void* ptr);
 
 } // extern "C"
 
@@ -216,11 +221,16 @@ struct JackBridgeExportedFunctions {
     jackbridgesym_sem_destroy sem_destroy_ptr;
     jackbridgesym_sem_post sem_post_ptr;
     jackbridgesym_sem_timedwait sem_timedwait_ptr;
+    jackbridgesym_futex_sem_init futex_sem_init_ptr;
+    jackbridgesym_futex_sem_post futex_sem_post_ptr;
+    jackbridgesym_futex_sem_timedwait futex_sem_timedwait_ptr;
     jackbridgesym_shm_is_valid shm_is_valid_ptr;
     jackbridgesym_shm_init shm_init_ptr;
     jackbridgesym_shm_attach shm_attach_ptr;
+    jackbridgesym_shm_create_temp shm_create_temp_ptr;
     jackbridgesym_shm_close shm_close_ptr;
     jackbridgesym_shm_map shm_map_ptr;
+    jackbridgesym_shm_unmap shm_unmap_ptr;
     ulong unique2;
 };
 
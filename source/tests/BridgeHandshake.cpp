@@ -0,0 +1,168 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "CarlaSemUtils.hpp"
+
+#include <pthread.h>
+
+// -----------------------------------------------------------------------
+
+static const uint kCycles = 20000;
+
+static double getTimeInSecs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+
+// -----------------------------------------------------------------------
+// same round-trip as the bridge RT channel: server posts, client processes and posts back
+
+struct SemHandshake {
+    sem_t* server;
+    sem_t* client;
+
+    static void* clientThread(void* const arg)
+    {
+        SemHandshake* const self((SemHandshake*)arg);
+
+        for (uint i=0; i < kCycles; ++i)
+        {
+            const bool ok(carla_sem_timedwait(self->server, 5));
+            assert(ok); (void)ok;
+            carla_sem_post(self->client);
+        }
+
+        return nullptr;
+    }
+
+    double run()
+    {
+        server = carla_sem_create();
+        client = carla_sem_create();
+        assert(server != nullptr && client != nullptr);
+
+        pthread_t thread;
+        const int ret(pthread_create(&thread, nullptr, clientThread, this));
+        assert(ret == 0); (void)ret;
+
+        const double start(getTimeInSecs());
+
+        for (uint i=0; i < kCycles; ++i)
+        {
+            carla_sem_post(server);
+            const bool ok(carla_sem_timedwait(client, 5));
+            assert(ok); (void)ok;
+        }
+
+        const double secs(getTimeInSecs() - start);
+
+        pthread_join(thread, nullptr);
+        carla_sem_destroy(client);
+        carla_sem_destroy(server);
+        return secs;
+    }
+};
+
+#ifdef CARLA_OS_LINUX
+struct FutexHandshake {
+    carla_futex_sem_t server;
+    carla_futex_sem_t client;
+
+    static void* clientThread(void* const arg)
+    {
+        FutexHandshake* const self((FutexHandshake*)arg);
+
+        for (uint i=0; i < kCycles; ++i)
+        {
+            const bool ok(carla_futex_sem_timedwait_ms(&self->server, 5000));
+            assert(ok); (void)ok;
+            carla_futex_sem_post(&self->client);
+        }
+
+        return nullptr;
+    }
+
+    double run()
+    {
+        carla_futex_sem_init(&server);
+        carla_futex_sem_init(&client);
+
+        pthread_t thread;
+        const int ret(pthread_create(&thread, nullptr, clientThread, this));
+        assert(ret == 0); (void)ret;
+
+        const double start(getTimeInSecs());
+
+        for (uint i=0; i < kCycles; ++i)
+        {
+            carla_futex_sem_post(&server);
+            const bool ok(carla_futex_sem_timedwait_ms(&client, 5000));
+            assert(ok); (void)ok;
+        }
+
+        const double secs(getTimeInSecs() - start);
+
+        pthread_join(thread, nullptr);
+        return secs;
+    }
+};
+
+static void testFutexTimeout()
+{
+    carla_futex_sem_t sem;
+    carla_futex_sem_init(&sem);
+
+    errno = 0;
+    bool ok = carla_futex_sem_timedwait_ms(&sem, 20);
+    assert(! ok);
+    assert(errno == ETIMEDOUT);
+
+    // posts are counted
+    carla_futex_sem_post(&sem);
+    carla_futex_sem_post(&sem);
+    ok = carla_futex_sem_timedwait_ms(&sem, 20);
+    assert(ok);
+    ok = carla_futex_sem_timedwait_ms(&sem, 20);
+    assert(ok);
+    ok = carla_futex_sem_trywait(&sem);
+    assert(! ok); (void)ok;
+}
+#endif
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    SemHandshake sem;
+    const double semSecs(sem.run());
+    carla_stdout("semaphore: %u round-trips in %f s (%f us per block)", kCycles, semSecs, semSecs*1000000.0/kCycles);
+
+#ifdef CARLA_OS_LINUX
+    testFutexTimeout();
+
+    FutexHandshake futex;
+    const double futexSecs(futex.run());
+    carla_stdout("futex:     %u round-trips in %f s (%f us per block)", kCycles, futexSecs, futexSecs*1000000.0/kCycles);
+#endif
+
+    carla_stdout("BridgeHandshake tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
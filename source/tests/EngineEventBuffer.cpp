@@ -0,0 +1,191 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "CarlaEngineUtils.hpp"
+
+#include <ctime>
+
+CARLA_BACKEND_USE_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+// fill with 'count' midi events, starting at 'time' and 'step' frames apart, tagged with 'tag' as data[1]
+static void fillEvents(EngineEventBuffer& buffer, const uint32_t count, const uint32_t time, const uint32_t step, const uint8_t tag)
+{
+    buffer.clear();
+
+    for (uint32_t i=0; i < count; ++i)
+    {
+        EngineEvent* const event(buffer.append());
+        assert(event != nullptr);
+
+        event->type = kEngineEventTypeMidi;
+        event->time = time + i*step;
+        event->midi.size    = 3;
+        event->midi.data[0] = 0x90;
+        event->midi.data[1] = tag;
+        event->midi.data[2] = 100;
+    }
+}
+
+static void checkSorted(const EngineEventBuffer& buffer)
+{
+    for (uint32_t i=1; i < buffer.count; ++i)
+        assert(buffer.data[i-1].time <= buffer.data[i].time);
+
+    if (buffer.count < kMaxEngineEventInternalCount)
+        assert(buffer.data[buffer.count].type == kEngineEventTypeNull);
+}
+
+// -----------------------------------------------------------------------
+
+static void testAppend()
+{
+    EngineEventBuffer buffer;
+    bool ok;
+
+    ok = buffer.alloc();
+    assert(ok);
+
+    for (uint32_t i=0; i < kMaxEngineEventInternalCount; ++i)
+    {
+        ok = (buffer.append() != nullptr);
+        assert(ok);
+    }
+
+    ok = (buffer.append() == nullptr);
+    assert(ok);
+    assert(buffer.count == kMaxEngineEventInternalCount);
+
+    buffer.clear();
+    assert(buffer.count == 0);
+    assert(buffer.data[0].type == kEngineEventTypeNull);
+    (void)ok;
+}
+
+static void testMerge()
+{
+    EngineEventBuffer a, b;
+    bool ok;
+
+    ok = a.alloc();
+    assert(ok);
+    ok = b.alloc();
+    assert(ok);
+
+    // interleaved, with equal times
+    fillEvents(a, 10, 0, 2, 1);
+    fillEvents(b, 10, 0, 2, 2);
+    ok = a.mergeFrom(b);
+    assert(ok);
+    assert(a.count == 20);
+    checkSorted(a);
+
+    // ours come first on equal time
+    for (uint32_t i=0; i < 20; i += 2)
+    {
+        assert(a.data[i].midi.data[1] == 1);
+        assert(a.data[i+1].midi.data[1] == 2);
+    }
+
+    // all of other after ours
+    fillEvents(a, 5, 0, 1, 1);
+    fillEvents(b, 5, 100, 1, 2);
+    ok = a.mergeFrom(b);
+    assert(ok);
+    assert(a.count == 10);
+    checkSorted(a);
+    assert(a.data[4].midi.data[1] == 1);
+    assert(a.data[5].midi.data[1] == 2);
+
+    // all of other before ours
+    fillEvents(a, 5, 100, 1, 1);
+    fillEvents(b, 5, 0, 1, 2);
+    ok = a.mergeFrom(b);
+    assert(ok);
+    assert(a.count == 10);
+    checkSorted(a);
+    assert(a.data[0].midi.data[1] == 2);
+    assert(a.data[9].midi.data[1] == 1);
+
+    // empty sides
+    fillEvents(a, 0, 0, 1, 1);
+    fillEvents(b, 7, 0, 1, 2);
+    ok = a.mergeFrom(b);
+    assert(ok);
+    assert(a.count == 7);
+    checkSorted(a);
+
+    fillEvents(b, 0, 0, 1, 2);
+    ok = a.mergeFrom(b);
+    assert(ok);
+    assert(a.count == 7);
+
+    // overflow drops the latest events
+    fillEvents(a, 400, 0, 2, 1);
+    fillEvents(b, 400, 1, 2, 2);
+    ok = a.mergeFrom(b);
+    assert(! ok);
+    assert(a.count == kMaxEngineEventInternalCount);
+    checkSorted(a);
+    assert(a.data[0].time == 0);
+    assert(a.data[kMaxEngineEventInternalCount-1].time == kMaxEngineEventInternalCount-1);
+    (void)ok;
+}
+
+// -----------------------------------------------------------------------
+
+static void benchmarkMerge()
+{
+    static const uint kBlocks = 10000;
+    static const uint32_t kHalf = kMaxEngineEventInternalCount/2;
+
+    EngineEventBuffer a, b;
+    bool ok;
+
+    ok = a.alloc();
+    assert(ok);
+    ok = b.alloc();
+    assert(ok); (void)ok;
+
+    const std::clock_t start(std::clock());
+
+    for (uint i=0; i < kBlocks; ++i)
+    {
+        fillEvents(a, kHalf, 0, 2, 1);
+        fillEvents(b, kHalf, 1, 2, 2);
+        a.mergeFrom(b);
+    }
+
+    const double secs(static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC);
+
+    carla_stdout("merged %u blocks of %u events in %f s (%f us per block)", kBlocks, kHalf*2, secs, secs*1000000.0/kBlocks);
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    testAppend();
+    testMerge();
+    benchmarkMerge();
+
+    carla_stdout("EngineEventBuffer tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
@@ -0,0 +1,149 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "engine/CarlaEngineProcessPool.hpp"
+
+CARLA_BACKEND_USE_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+// diamond shaped graph plus a lone node: 0 -> 1, 0 -> 2, 1 -> 3, 2 -> 3, 4
+static const uint kNodeCount = 5;
+static const uint kEdgeSources[] = { 0, 0, 1, 2 };
+static const uint kEdgeTargets[] = { 1, 2, 3, 3 };
+static const uint kEdgeCount = 4;
+
+struct TestCallback : public EngineProcessGraph::Callback {
+    juce::Atomic<int> order;
+    juce::Atomic<int> runs[kNodeCount];
+    int position[kNodeCount];
+
+    TestCallback() noexcept
+        : order(0)
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        order = 0;
+
+        for (uint i=0; i < kNodeCount; ++i)
+        {
+            runs[i] = 0;
+            position[i] = -1;
+        }
+    }
+
+    void processGraphNode(const uint index) override
+    {
+        assert(index < kNodeCount);
+
+        ++runs[index];
+        position[index] = (++order) - 1;
+
+        // make the middle nodes heavier
+        if (index == 1 || index == 2)
+            carla_msleep(1);
+    }
+};
+
+// -----------------------------------------------------------------------
+
+static void testPool(const uint numThreads)
+{
+    EngineProcessGraph graph(kNodeCount, kEdgeSources, kEdgeTargets, kEdgeCount);
+    assert(graph.isValid());
+    assert(graph.getNodeCount() == kNodeCount);
+
+    EngineProcessPool pool(numThreads, kNodeCount);
+    assert(pool.getThreadCount() == numThreads);
+    assert(pool.getMaxNodes() == kNodeCount);
+
+    TestCallback callback;
+
+    for (int cycle=0; cycle < 100; ++cycle)
+    {
+        callback.reset();
+        pool.process(graph, &callback);
+
+        for (uint i=0; i < kNodeCount; ++i)
+            assert(callback.runs[i].get() == 1);
+
+        assert(callback.position[0] < callback.position[1]);
+        assert(callback.position[0] < callback.position[2]);
+        assert(callback.position[1] < callback.position[3]);
+        assert(callback.position[2] < callback.position[3]);
+    }
+
+    // node 4 is never on the critical path, one of the heavier nodes always is
+    assert(graph.getNodeTiming(0).critical);
+    assert(graph.getNodeTiming(1).critical || graph.getNodeTiming(2).critical);
+    assert(graph.getNodeTiming(3).critical);
+    assert(! graph.getNodeTiming(4).critical);
+    assert(graph.getCriticalPathUsecs() >= graph.getNodeTiming(3).pathUsecs);
+    assert(graph.getNodeTiming(1).maxUsecs >= graph.getNodeTiming(1).avgUsecs);
+
+    // copy readable from other threads, keyed by our own ids
+    static const uint kNodeIds[kNodeCount] = { 10, 11, 12, 13, 14 };
+
+    EngineProcessTimings timings(kNodeCount);
+    EngineProcessNodeTiming timing;
+    float criticalPathUsecs = 0.0f;
+
+    assert(! timings.get(10, timing, criticalPathUsecs));
+
+    timings.publish(graph, kNodeIds);
+
+    assert(timings.get(13, timing, criticalPathUsecs));
+    assert(timing.critical);
+    assert(timing.avgUsecs == graph.getNodeTiming(3).avgUsecs);
+    assert(criticalPathUsecs == graph.getCriticalPathUsecs());
+    assert(timings.get(14, timing, criticalPathUsecs));
+    assert(! timing.critical);
+    assert(! timings.get(3, timing, criticalPathUsecs));
+
+    timings.clear();
+    assert(! timings.get(13, timing, criticalPathUsecs));
+
+    (void)criticalPathUsecs;
+}
+
+static void testFeedbackLoop()
+{
+    static const uint sources[] = { 0, 1, 2 };
+    static const uint targets[] = { 1, 2, 0 };
+
+    EngineProcessGraph graph(3, sources, targets, 3);
+    assert(! graph.isValid());
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    testFeedbackLoop();
+
+    testPool(1);
+    testPool(2);
+    testPool(4);
+
+    carla_stdout("EngineProcessPool tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
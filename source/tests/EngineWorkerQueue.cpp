@@ -0,0 +1,337 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "engine/CarlaEngineThread.hpp"
+
+#include <sched.h>
+
+CARLA_BACKEND_USE_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+// the queue never touches the plugins, so any unique address will do
+static const uint kNumProducers = 4;
+static const uint kNumConsumers = 3;
+static const uint kPerProducer  = 20000;
+
+static char gFakePlugins[kNumProducers*kPerProducer];
+
+static CarlaPlugin* fakePlugin(const uint index) noexcept
+{
+    return reinterpret_cast<CarlaPlugin*>(&gFakePlugins[index]);
+}
+
+static uint fakePluginIndex(CarlaPlugin* const plugin) noexcept
+{
+    return static_cast<uint>(reinterpret_cast<char*>(plugin) - gFakePlugins);
+}
+
+// -----------------------------------------------------------------------
+
+static void testSingleThread()
+{
+    CarlaEngineWorkerQueue queue;
+    CarlaPlugin* plugin = nullptr;
+    bool ok;
+
+    ok = queue.pop(plugin);
+    assert(! ok);
+
+    // fill up, including wrap around on the second pass
+    for (int pass=0; pass < 2; ++pass)
+    {
+        for (uint i=0; i < CarlaEngineWorkerQueue::kSize; ++i)
+        {
+            ok = queue.push(fakePlugin(i));
+            assert(ok);
+        }
+
+        ok = queue.push(fakePlugin(0));
+        assert(! ok);
+
+        for (uint i=0; i < CarlaEngineWorkerQueue::kSize; ++i)
+        {
+            ok = queue.pop(plugin);
+            assert(ok && plugin == fakePlugin(i));
+        }
+
+        ok = queue.pop(plugin);
+        assert(! ok);
+    }
+
+    // removed entries stay as null
+    queue.push(fakePlugin(1));
+    queue.push(fakePlugin(2));
+    queue.push(fakePlugin(1));
+
+    queue.remove(fakePlugin(1));
+
+    ok = queue.pop(plugin);
+    assert(ok && plugin == nullptr);
+    ok = queue.pop(plugin);
+    assert(ok && plugin == fakePlugin(2));
+    ok = queue.pop(plugin);
+    assert(ok && plugin == nullptr);
+    ok = queue.pop(plugin);
+    assert(! ok);
+}
+
+// -----------------------------------------------------------------------
+
+struct SharedData {
+    CarlaEngineWorkerQueue queue;
+    CarlaMutex readMutex;
+    juce::Atomic<int> producersDone;
+    juce::Atomic<int> popped[kNumProducers*kPerProducer];
+
+    SharedData() noexcept
+        : queue(),
+          readMutex(),
+          producersDone(0) {}
+};
+
+class Producer : public CarlaThread
+{
+public:
+    Producer(SharedData& data, const uint index)
+        : CarlaThread("Producer"),
+          fData(data),
+          fIndex(index) {}
+
+protected:
+    void run() override
+    {
+        for (uint i=0; i < kPerProducer; ++i)
+        {
+            // spin while full, like a plugin retrying on its next cycle
+            for (; ! fData.queue.push(fakePlugin(fIndex*kPerProducer + i));)
+                sched_yield();
+        }
+
+        ++fData.producersDone;
+    }
+
+private:
+    SharedData& fData;
+    const uint fIndex;
+};
+
+class Consumer : public CarlaThread
+{
+public:
+    Consumer(SharedData& data)
+        : CarlaThread("Consumer"),
+          fData(data) {}
+
+protected:
+    void run() override
+    {
+        for (;;)
+        {
+            const bool producersDone(fData.producersDone.get() == static_cast<int>(kNumProducers));
+
+            CarlaPlugin* plugin = nullptr;
+            bool gotOne;
+
+            {
+                const CarlaMutexLocker cml(fData.readMutex);
+                gotOne = fData.queue.pop(plugin);
+            }
+
+            if (gotOne)
+            {
+                assert(plugin != nullptr);
+
+                if (plugin != nullptr)
+                    ++fData.popped[fakePluginIndex(plugin)];
+                continue;
+            }
+
+            if (producersDone)
+                break;
+
+            sched_yield();
+        }
+    }
+
+private:
+    SharedData& fData;
+};
+
+static void testThreads()
+{
+    SharedData* const data(new SharedData());
+
+    Producer* producers[kNumProducers];
+    Consumer* consumers[kNumConsumers];
+
+    for (uint i=0; i < kNumConsumers; ++i)
+    {
+        consumers[i] = new Consumer(*data);
+
+        const bool started(consumers[i]->startThread());
+        assert(started);
+    }
+
+    for (uint i=0; i < kNumProducers; ++i)
+    {
+        producers[i] = new Producer(*data, i);
+
+        const bool started(producers[i]->startThread());
+        assert(started);
+    }
+
+    for (uint i=0; i < kNumProducers; ++i)
+    {
+        producers[i]->stopThread(-1);
+        delete producers[i];
+    }
+
+    for (uint i=0; i < kNumConsumers; ++i)
+    {
+        consumers[i]->stopThread(-1);
+        delete consumers[i];
+    }
+
+    // every entry comes out exactly once
+    for (uint i=0; i < kNumProducers*kPerProducer; ++i)
+        assert(data->popped[i].get() == 1);
+
+    CarlaPlugin* plugin = nullptr;
+    const bool gotOne(data->queue.pop(plugin));
+    assert(! gotOne);
+
+    delete data;
+}
+
+// -----------------------------------------------------------------------
+// same producers, but going through the pool and its semaphore like the plugins do
+
+class TestPool : public CarlaEngineWorkerPool
+{
+public:
+    juce::Atomic<int> ran[kNumProducers*kPerProducer];
+    juce::Atomic<int> total;
+
+    TestPool() noexcept
+        : CarlaEngineWorkerPool(),
+          total(0) {}
+
+    ~TestPool() noexcept override
+    {
+        stopThreads();
+    }
+
+    // what a producer preempted in the middle of schedule() looks like to the workers:
+    // another producer posted its token first, and the entry in front is not published yet
+    void postBeforePush(CarlaPlugin* const plugin) noexcept
+    {
+        carla_sem_post(fSem);
+        carla_msleep(50);
+
+        const bool pushed(fQueue.push(plugin));
+        assert(pushed); (void)pushed;
+    }
+
+protected:
+    void runWork(CarlaPlugin* const plugin) noexcept override
+    {
+        ++ran[fakePluginIndex(plugin)];
+        ++total;
+    }
+};
+
+class PoolProducer : public CarlaThread
+{
+public:
+    PoolProducer(TestPool& pool, const uint index)
+        : CarlaThread("PoolProducer"),
+          fPool(pool),
+          fIndex(index) {}
+
+protected:
+    void run() override
+    {
+        for (uint i=0; i < kPerProducer; ++i)
+        {
+            for (; ! fPool.schedule(fakePlugin(fIndex*kPerProducer + i));)
+                sched_yield();
+        }
+    }
+
+private:
+    TestPool& fPool;
+    const uint fIndex;
+};
+
+static void testPool()
+{
+    TestPool* const pool(new TestPool());
+    pool->startThreads();
+
+    // a worker takes the token first, it must wait for the entry instead of dropping the token
+    pool->postBeforePush(fakePlugin(0));
+
+    for (int i=0; i < 1000 && pool->total.get() != 1; ++i)
+        carla_msleep(1);
+
+    assert(pool->total.get() == 1);
+    pool->ran[0] = 0;
+    pool->total = 0;
+
+    PoolProducer* producers[kNumProducers];
+
+    for (uint i=0; i < kNumProducers; ++i)
+    {
+        producers[i] = new PoolProducer(*pool, i);
+
+        const bool started(producers[i]->startThread());
+        assert(started);
+    }
+
+    for (uint i=0; i < kNumProducers; ++i)
+    {
+        producers[i]->stopThread(-1);
+        delete producers[i];
+    }
+
+    // a lost semaphore token leaves an entry behind, give the workers plenty of time to catch up
+    for (int i=0; i < 10000 && pool->total.get() != static_cast<int>(kNumProducers*kPerProducer); ++i)
+        carla_msleep(1);
+
+    pool->stopThreads();
+
+    // every entry ran exactly once
+    for (uint i=0; i < kNumProducers*kPerProducer; ++i)
+        assert(pool->ran[i].get() == 1);
+
+    delete pool;
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    testSingleThread();
+    testThreads();
+    testPool();
+
+    carla_stdout("EngineWorkerQueue tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
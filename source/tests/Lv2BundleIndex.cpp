@@ -0,0 +1,119 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "Lv2BundleIndex.hpp"
+
+using juce::File;
+using juce::String;
+using juce::StringArray;
+
+// -----------------------------------------------------------------------
+
+static const char* const kPrefixes =
+    "@prefix lv2:  <http://lv2plug.in/ns/lv2core#> .\n"
+    "@prefix rdfs: <http://www.w3.org/2000/01/rdf-schema#> .\n"
+    "@prefix ui:   <http://lv2plug.in/ns/extensions/ui#> .\n\n";
+
+static void createBundle(const File& bundle, const String& manifest)
+{
+    bool ok;
+
+    ok = bundle.createDirectory();
+    assert(ok);
+    ok = bundle.getChildFile("manifest.ttl").replaceWithText(kPrefixes + manifest);
+    assert(ok); (void)ok;
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    const File tmpDir(File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("carla-bundle-index-test", ""));
+    const File lv2Dir(tmpDir.getChildFile("lv2"));
+    const File cacheDir(tmpDir.getChildFile("cache"));
+
+    const File pluginBundle(lv2Dir.getChildFile("plugin.lv2"));
+    const File presetBundle(lv2Dir.getChildFile("presets.lv2"));
+    const File uiBundle(lv2Dir.getChildFile("ui.lv2"));
+    const File otherBundle(lv2Dir.getChildFile("other.lv2"));
+
+    createBundle(pluginBundle,
+                 "<urn:carla:test:plugin> a lv2:Plugin ; rdfs:seeAlso <plugin.ttl> .\n"
+                 "<urn:carla:test:other> a lv2:Plugin, lv2:DelayPlugin .\n");
+    createBundle(presetBundle,
+                 "<preset.ttl#first> a <http://lv2plug.in/ns/ext/presets#Preset> ;\n"
+                 "    lv2:appliesTo <urn:carla:test:plugin> .\n");
+    createBundle(uiBundle,
+                 "<urn:carla:test:plugin> ui:ui <urn:carla:test:plugin#ui> .\n");
+    createBundle(otherBundle, "this is not valid turtle");
+
+    const String lv2Path(lv2Dir.getFullPathName());
+
+    {
+        Lv2BundleIndex index(cacheDir);
+
+        // related bundles first, declaring bundle last
+        const StringArray bundles(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:plugin"));
+        assert(bundles.size() == 3);
+        assert(bundles.contains(presetBundle.getFullPathName()));
+        assert(bundles.contains(uiBundle.getFullPathName()));
+        assert(bundles[2] == pluginBundle.getFullPathName());
+
+        const StringArray others(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:other"));
+        assert(others.size() == 1 && others[0] == pluginBundle.getFullPathName());
+
+        const StringArray missing(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:missing"));
+        assert(missing.size() == 0);
+
+        // a new bundle is found without having to restart
+        createBundle(lv2Dir.getChildFile("new.lv2"), "<urn:carla:test:new> a lv2:Plugin .\n");
+        const StringArray added(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:new"));
+        assert(added.size() == 1);
+    }
+
+    juce::Array<File> files;
+    const int numFiles(cacheDir.findChildFiles(files, File::findFiles, false));
+    assert(numFiles == 1); (void)numFiles;
+
+    // saved to disk, and updated on changes
+    {
+        const bool ok(pluginBundle.getChildFile("manifest.ttl").replaceWithText(String(kPrefixes) + "<urn:carla:test:renamed> a lv2:Plugin .\n"));
+        assert(ok); (void)ok;
+
+        Lv2BundleIndex index(cacheDir);
+        const StringArray added(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:new"));
+        assert(added.size() == 1);
+        const StringArray renamed(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:renamed"));
+        assert(renamed.size() == 1);
+        const StringArray others(index.getPluginBundles(lv2Path.toRawUTF8(), "urn:carla:test:other"));
+        assert(others.size() == 0);
+    }
+
+    // other LV2_PATH
+    {
+        Lv2BundleIndex index(cacheDir);
+        const StringArray added(index.getPluginBundles(presetBundle.getFullPathName().toRawUTF8(), "urn:carla:test:new"));
+        assert(added.size() == 0);
+    }
+
+    tmpDir.deleteRecursively();
+
+    carla_stdout("Lv2BundleIndex tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
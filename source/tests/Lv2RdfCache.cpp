@@ -0,0 +1,209 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "Lv2RdfCache.hpp"
+
+using juce::File;
+using juce::String;
+
+// -----------------------------------------------------------------------
+
+static const char* const kURI = "urn:carla:test:rdfcache";
+
+static LV2_RDF_Descriptor* createDescriptor(const File& bundle)
+{
+    LV2_RDF_Descriptor* const rdf(new LV2_RDF_Descriptor());
+
+    rdf->Type[0]   = LV2_PLUGIN_DELAY;
+    rdf->Type[1]   = LV2_PLUGIN_UTILITY;
+    rdf->URI       = carla_strdup(kURI);
+    rdf->Name      = carla_strdup("Cache Test");
+    rdf->Binary    = carla_strdup(bundle.getChildFile("test.so").getFullPathName().toRawUTF8());
+    rdf->Bundle    = carla_strdup(bundle.getFullPathName().toRawUTF8());
+    rdf->UniqueID  = 1234;
+    rdf->HasDefaultState = true;
+
+    rdf->PortCount = 2;
+    rdf->Ports     = new LV2_RDF_Port[2];
+    rdf->Ports[0].Types  = LV2_PORT_INPUT|LV2_PORT_CONTROL;
+    rdf->Ports[0].Name   = carla_strdup("Gain");
+    rdf->Ports[0].Symbol = carla_strdup("gain");
+    rdf->Ports[0].Points.Hints   = LV2_PORT_POINT_DEFAULT;
+    rdf->Ports[0].Points.Default = 0.5f;
+    rdf->Ports[0].Unit.Hints  = LV2_PORT_UNIT_SYMBOL;
+    rdf->Ports[0].Unit.Symbol = carla_strdup("dB");
+    rdf->Ports[0].ScalePointCount = 1;
+    rdf->Ports[0].ScalePoints = new LV2_RDF_PortScalePoint[1];
+    rdf->Ports[0].ScalePoints[0].Label = carla_strdup("Half");
+    rdf->Ports[0].ScalePoints[0].Value = 0.5f;
+    rdf->Ports[1].Types  = LV2_PORT_OUTPUT|LV2_PORT_AUDIO;
+    rdf->Ports[1].Symbol = carla_strdup("out");
+
+    rdf->PresetCount = 1;
+    rdf->Presets     = new LV2_RDF_Preset[1];
+    rdf->Presets[0].URI = carla_strdup("urn:carla:test:rdfcache#preset");
+
+    rdf->ExtensionCount = 2;
+    rdf->Extensions     = new LV2_URI[2];
+    rdf->Extensions[0]  = carla_strdup("http://lv2plug.in/ns/ext/state#interface");
+    rdf->Extensions[1]  = nullptr;
+
+    rdf->UICount = 1;
+    rdf->UIs     = new LV2_RDF_UI[1];
+    rdf->UIs[0].Type = LV2_UI_X11;
+    rdf->UIs[0].URI  = carla_strdup("urn:carla:test:rdfcache#ui");
+    rdf->UIs[0].FeatureCount = 1;
+    rdf->UIs[0].Features     = new LV2_RDF_Feature[1];
+    rdf->UIs[0].Features[0].Type = LV2_FEATURE_REQUIRED;
+    rdf->UIs[0].Features[0].URI  = carla_strdup("http://lv2plug.in/ns/extensions/ui#parent");
+
+    return rdf;
+}
+
+static bool strEqual(const char* const a, const char* const b)
+{
+    if (a == nullptr || b == nullptr)
+        return a == b;
+    return std::strcmp(a, b) == 0;
+}
+
+static void checkDescriptor(const LV2_RDF_Descriptor* const a, const LV2_RDF_Descriptor* const b)
+{
+    assert(a->Type[0] == b->Type[0] && a->Type[1] == b->Type[1]);
+    assert(strEqual(a->URI, b->URI) && strEqual(a->Name, b->Name) && strEqual(a->Author, b->Author));
+    assert(strEqual(a->Binary, b->Binary) && strEqual(a->Bundle, b->Bundle));
+    assert(a->UniqueID == b->UniqueID && a->HasDefaultState == b->HasDefaultState);
+
+    assert(a->PortCount == b->PortCount);
+    for (uint32_t i=0; i < a->PortCount; ++i)
+    {
+        assert(a->Ports[i].Types == b->Ports[i].Types);
+        assert(strEqual(a->Ports[i].Name, b->Ports[i].Name) && strEqual(a->Ports[i].Symbol, b->Ports[i].Symbol));
+        assert(a->Ports[i].Points.Default == b->Ports[i].Points.Default);
+        assert(strEqual(a->Ports[i].Unit.Symbol, b->Ports[i].Unit.Symbol));
+        assert(a->Ports[i].ScalePointCount == b->Ports[i].ScalePointCount);
+
+        for (uint32_t j=0; j < a->Ports[i].ScalePointCount; ++j)
+            assert(strEqual(a->Ports[i].ScalePoints[j].Label, b->Ports[i].ScalePoints[j].Label));
+    }
+
+    assert(a->PresetCount == b->PresetCount);
+    for (uint32_t i=0; i < a->PresetCount; ++i)
+        assert(strEqual(a->Presets[i].URI, b->Presets[i].URI) && strEqual(a->Presets[i].Label, b->Presets[i].Label));
+
+    assert(a->ExtensionCount == b->ExtensionCount);
+    for (uint32_t i=0; i < a->ExtensionCount; ++i)
+        assert(strEqual(a->Extensions[i], b->Extensions[i]));
+
+    assert(a->UICount == b->UICount);
+    for (uint32_t i=0; i < a->UICount; ++i)
+    {
+        assert(a->UIs[i].Type == b->UIs[i].Type && strEqual(a->UIs[i].URI, b->UIs[i].URI));
+        assert(a->UIs[i].FeatureCount == b->UIs[i].FeatureCount);
+
+        for (uint32_t j=0; j < a->UIs[i].FeatureCount; ++j)
+            assert(strEqual(a->UIs[i].Features[j].URI, b->UIs[i].Features[j].URI));
+    }
+
+    // unused with NDEBUG
+    (void)b;
+    (void)strEqual;
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    const File tmpDir(File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("carla-rdf-cache-test", ""));
+    const File lv2Dir(tmpDir.getChildFile("lv2"));
+    const File bundle(lv2Dir.getChildFile("test.lv2"));
+    const File cacheDir(tmpDir.getChildFile("cache"));
+
+    bool ok;
+
+    ok = bundle.createDirectory();
+    assert(ok);
+    ok = bundle.getChildFile("manifest.ttl").replaceWithText("# manifest");
+    assert(ok);
+
+    const String lv2Path(lv2Dir.getFullPathName());
+    const Lv2RdfCache cache(lv2Path.toRawUTF8(), cacheDir);
+
+    // not cached yet
+    assert(cache.load(kURI) == nullptr);
+
+    // round trip
+    LV2_RDF_Descriptor* const rdf(createDescriptor(bundle));
+    ok = cache.store(rdf);
+    assert(ok);
+
+    {
+        LV2_RDF_Descriptor* const cached(cache.load(kURI));
+        assert(cached != nullptr);
+        checkDescriptor(rdf, cached);
+        delete cached;
+    }
+
+    // other LV2_PATH
+    {
+        const Lv2RdfCache otherCache("/nonexistent", cacheDir);
+        assert(otherCache.load(kURI) == nullptr);
+    }
+
+    // bundle file changed, even within the same second
+    ok = bundle.getChildFile("manifest.ttl").replaceWithText("# manifest, changed");
+    assert(ok);
+    assert(cache.load(kURI) == nullptr);
+
+    ok = cache.store(rdf);
+    assert(ok);
+
+    {
+        LV2_RDF_Descriptor* const cached(cache.load(kURI));
+        assert(cached != nullptr);
+        delete cached;
+    }
+
+    // truncated entry
+    {
+        juce::Array<File> files;
+        const int numFiles(cacheDir.findChildFiles(files, File::findFiles, false));
+        assert(numFiles == 1); (void)numFiles;
+
+        const File entry(files.getFirst());
+        juce::MemoryBlock data;
+        ok = entry.loadFileAsData(data);
+        assert(ok);
+
+        for (size_t size = data.getSize(); size-- > 0;)
+        {
+            ok = entry.replaceWithData(data.getData(), size);
+            assert(ok);
+            assert(cache.load(kURI) == nullptr);
+        }
+    }
+
+    (void)ok;
+
+    delete rdf;
+    tmpDir.deleteRecursively();
+
+    carla_stdout("Lv2RdfCache tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
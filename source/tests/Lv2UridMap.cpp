@@ -0,0 +1,162 @@
+/*
+ * Carla Tests
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#include "Lv2UridMap.hpp"
+
+#include <pthread.h>
+
+// -----------------------------------------------------------------------
+
+static const uint32_t kFirstURID = 10;
+static const uint32_t kURICount  = 5000; // spans several pages
+static const uint32_t kThreads   = 4;
+
+static void makeURI(char* const buf, const uint32_t i)
+{
+    std::snprintf(buf, 64, "urn:carla:test#%u", i);
+}
+
+static void testBasic()
+{
+    Lv2UridMap map(kFirstURID);
+    char uri[64];
+    LV2_URID urid;
+    bool ok;
+
+    assert(map.getCount() == kFirstURID);
+    assert(map.find("urn:carla:test#0") == 0);
+    assert(map.unmap(0) == nullptr);
+    assert(map.unmap(kFirstURID) == nullptr);
+
+    for (uint32_t i=0; i < kURICount; ++i)
+    {
+        makeURI(uri, i);
+        urid = map.map(uri);
+        assert(urid == kFirstURID + i);
+    }
+
+    assert(map.getCount() == kFirstURID + kURICount);
+
+    for (uint32_t i=0; i < kURICount; ++i)
+    {
+        makeURI(uri, i);
+        urid = map.map(uri);
+        assert(urid == kFirstURID + i);
+        assert(map.find(uri) == kFirstURID + i);
+        assert(std::strcmp(map.unmap(kFirstURID + i), uri) == 0);
+    }
+
+    // replaying a remote map, with a gap
+    const uint32_t next(map.getCount());
+    ok = map.mapAt(next + 2, "urn:carla:remote");
+    assert(ok);
+    assert(map.unmap(next) == nullptr);
+    assert(map.find("urn:carla:remote") == next + 2);
+    ok = map.mapAt(next + 2, "urn:carla:remote");
+    assert(ok);
+    ok = map.mapAt(next + 2, "urn:carla:other");
+    assert(! ok);
+
+    // gaps can be filled later
+    ok = map.mapAt(next, "urn:carla:gap");
+    assert(ok);
+    assert(map.find("urn:carla:gap") == next);
+
+    // an URI mapped again at another ID keeps its first ID for lookups
+    ok = map.mapAt(next + 3, "urn:carla:gap");
+    assert(ok);
+    assert(map.find("urn:carla:gap") == next);
+    assert(std::strcmp(map.unmap(next + 3), "urn:carla:gap") == 0);
+
+    (void)urid;
+    (void)ok;
+}
+
+// -----------------------------------------------------------------------
+// all threads map the same URIs, in different order, and must agree on the IDs
+
+static Lv2UridMap* gMap = nullptr;
+static LV2_URID gResults[kThreads][kURICount];
+
+static void* mapThread(void* const arg)
+{
+    const uint32_t index(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg)));
+    char uri[64];
+
+    for (uint32_t j=0; j < kURICount; ++j)
+    {
+        const uint32_t i((index % 2 == 0) ? j : kURICount-j-1);
+        makeURI(uri, i);
+
+        const LV2_URID urid(gMap->map(uri));
+        gResults[index][i] = urid;
+
+        // the ID might come from another thread's insert, it must be usable right away
+        const char* const unmapped(gMap->unmap(urid));
+        assert(unmapped != nullptr && std::strcmp(unmapped, uri) == 0); (void)unmapped;
+    }
+
+    return nullptr;
+}
+
+static void testThreads()
+{
+    Lv2UridMap map(kFirstURID);
+    gMap = &map;
+
+    pthread_t threads[kThreads];
+
+    for (uint32_t i=0; i < kThreads; ++i)
+    {
+        const int ret(pthread_create(&threads[i], nullptr, mapThread, reinterpret_cast<void*>(static_cast<uintptr_t>(i))));
+        assert(ret == 0); (void)ret;
+    }
+
+    for (uint32_t i=0; i < kThreads; ++i)
+        pthread_join(threads[i], nullptr);
+
+    assert(map.getCount() == kFirstURID + kURICount);
+
+    char uri[64];
+
+    for (uint32_t i=0; i < kURICount; ++i)
+    {
+        const LV2_URID urid(gResults[0][i]);
+        assert(urid >= kFirstURID);
+
+        for (uint32_t j=1; j < kThreads; ++j)
+            assert(gResults[j][i] == urid);
+
+        makeURI(uri, i);
+        assert(std::strcmp(map.unmap(urid), uri) == 0); (void)urid;
+    }
+
+    gMap = nullptr;
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    testBasic();
+    testThreads();
+
+    carla_stdout("Lv2UridMap tests passed");
+    return 0;
+}
+
+// -----------------------------------------------------------------------
@@ -48,6 +48,8 @@ const char* PluginOption2Str(const uint option) noexcept
         return "PLUGIN_OPTION_SEND_PITCHBEND";
     case PLUGIN_OPTION_SEND_ALL_SOUND_OFF:
         return "PLUGIN_OPTION_SEND_ALL_SOUND_OFF";
+    case PLUGIN_OPTION_SKIP_SILENCE:
+        return "PLUGIN_OPTION_SKIP_SILENCE";
     }
 
     carla_stderr("CarlaBackend::PluginOption2Str(%i) - invalid option", option);
@@ -278,6 +280,10 @@ const char* EngineCallbackOpcode2Str(const EngineCallbackOpcode opcode) noexcept
         return "ENGINE_CALLBACK_ERROR";
     case ENGINE_CALLBACK_QUIT:
         return "ENGINE_CALLBACK_QUIT";
+    case ENGINE_CALLBACK_RENDER_PROGRESS:
+        return "ENGINE_CALLBACK_RENDER_PROGRESS";
+    case ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS:
+        return "ENGINE_CALLBACK_BRIDGE_SLOW_BLOCKS";
     }
 
     carla_stderr("CarlaBackend::EngineCallbackOpcode2Str(%i) - invalid opcode", opcode);
@@ -327,6 +333,18 @@ const char* EngineOption2Str(const EngineOption option) noexcept
         return "ENGINE_OPTION_PREVENT_BAD_BEHAVIOUR";
     case ENGINE_OPTION_FRONTEND_WIN_ID:
         return "ENGINE_OPTION_FRONTEND_WIN_ID";
+    case ENGINE_OPTION_PROCESS_THREADS:
+        return "ENGINE_OPTION_PROCESS_THREADS";
+    case ENGINE_OPTION_IDLE_POLL_INTERVAL:
+        return "ENGINE_OPTION_IDLE_POLL_INTERVAL";
+    case ENGINE_OPTION_PIPELINED_BRIDGES:
+        return "ENGINE_OPTION_PIPELINED_BRIDGES";
+    case ENGINE_OPTION_BRIDGE_SOFT_DEADLINE:
+        return "ENGINE_OPTION_BRIDGE_SOFT_DEADLINE";
+    case ENGINE_OPTION_SPLIT_GRANULARITY:
+        return "ENGINE_OPTION_SPLIT_GRANULARITY";
+    case ENGINE_OPTION_LOW_LATENCY_BRIDGES:
+        return "ENGINE_OPTION_LOW_LATENCY_BRIDGES";
     }
 
     carla_stderr("CarlaBackend::EngineOption2Str(%i) - invalid option", option);
@@ -25,11 +25,15 @@
 # define PLUGIN_BRIDGE_NAMEPREFIX_RT_CLIENT     "Global\\carla-bridge_shm_rtC_"
 # define PLUGIN_BRIDGE_NAMEPREFIX_NON_RT_CLIENT "Global\\carla-bridge_shm_nonrtC_"
 # define PLUGIN_BRIDGE_NAMEPREFIX_NON_RT_SERVER "Global\\carla-bridge_shm_nonrtS_"
+# define PLUGIN_BRIDGE_NAMEPREFIX_PARAMETERS    "Global\\carla-bridge_shm_params_"
+# define PLUGIN_BRIDGE_NAMEPREFIX_CHUNK         "Global\\carla-bridge_shm_chunk_"
 #else
 # define PLUGIN_BRIDGE_NAMEPREFIX_AUDIO_POOL    "/carla-bridge_shm_ap_"
 # define PLUGIN_BRIDGE_NAMEPREFIX_RT_CLIENT     "/carla-bridge_shm_rtC_"
 # define PLUGIN_BRIDGE_NAMEPREFIX_NON_RT_CLIENT "/carla-bridge_shm_nonrtC_"
 # define PLUGIN_BRIDGE_NAMEPREFIX_NON_RT_SERVER "/carla-bridge_shm_nonrtS_"
+# define PLUGIN_BRIDGE_NAMEPREFIX_PARAMETERS    "/carla-bridge_shm_params_"
+# define PLUGIN_BRIDGE_NAMEPREFIX_CHUNK         "/carla-bridge_shm_chunk_"
 #endif
 
 // -----------------------------------------------------------------------
@@ -76,7 +80,9 @@ enum PluginBridgeNonRtClientOpcode {
     kPluginBridgeNonRtClientUiMidiProgramChange,     // uint
     kPluginBridgeNonRtClientUiNoteOn,                // byte, byte, byte
     kPluginBridgeNonRtClientUiNoteOff,               // byte, byte
-    kPluginBridgeNonRtClientQuit
+    kPluginBridgeNonRtClientQuit,
+    kPluginBridgeNonRtClientSetChunkDataShm,         // ulong/size, uint/size, str[] (shm name, raw content)
+    kPluginBridgeNonRtClientChunkDataShmRead         // uint/size, str[] (shm name)
 };
 
 // Client sends these to server during non-RT
@@ -106,7 +112,10 @@ enum PluginBridgeNonRtServerOpcode {
     kPluginBridgeNonRtServerReady,
     kPluginBridgeNonRtServerSaved,
     kPluginBridgeNonRtServerUiClosed,
-    kPluginBridgeNonRtServerError               // uint/size, str[]
+    kPluginBridgeNonRtServerError,              // uint/size, str[]
+    kPluginBridgeNonRtServerParameterDataBulk,  // uint/count, uint/size, uint/size, str[] (count BridgeParameterData + strings, shm size, shm name)
+    kPluginBridgeNonRtServerSetChunkDataShm,    // ulong/size, uint/size, str[] (shm name, raw content)
+    kPluginBridgeNonRtServerChunkDataShmRead    // uint/size, str[] (shm name)
 };
 
 // -----------------------------------------------------------------------
@@ -120,6 +129,16 @@ struct BridgeSemaphore {
         void* client;
         char _padClient[64];
     };
+    // spin-then-futex handshake, used instead of the above when lowLatency is set
+    union {
+        void* futexServer;
+        char _padFutexServer[64];
+    };
+    union {
+        void* futexClient;
+        char _padFutexClient[64];
+    };
+    uint32_t lowLatency;
 };
 
 // needs to be 64bit aligned
@@ -156,6 +175,22 @@ struct BridgeNonRtServerData {
     HugeStackBuffer ringBuffer;
 };
 
+// Client => Server Non-RT, all parameter info and values packed in a separate shared memory area
+// same contents as ParameterData1, ParameterData2, ParameterRanges and ParameterValue2
+// strings are null-terminated, stored right after the last entry and referenced by their offset from there
+struct BridgeParameterData {
+    uint32_t index;
+    int32_t  rindex;
+    uint32_t type;
+    uint32_t hints;
+    int32_t  midiCC;
+    float def, min, max, step, stepSmall, stepLarge;
+    float value;
+    uint32_t nameOffset;
+    uint32_t symbolOffset;
+    uint32_t unitOffset;
+};
+
 // -----------------------------------------------------------------------
 
 static inline
@@ -248,6 +283,10 @@ const char* PluginBridgeNonRtClientOpcode2str(const PluginBridgeNonRtClientOpcod
         return "kPluginBridgeNonRtClientUiNoteOff";
     case kPluginBridgeNonRtClientQuit:
         return "kPluginBridgeNonRtClientQuit";
+    case kPluginBridgeNonRtClientSetChunkDataShm:
+        return "kPluginBridgeNonRtClientSetChunkDataShm";
+    case kPluginBridgeNonRtClientChunkDataShmRead:
+        return "kPluginBridgeNonRtClientChunkDataShmRead";
     }
 
     carla_stderr("CarlaBackend::PluginBridgeNonRtClientOpcode2str(%i) - invalid opcode", opcode);
@@ -311,6 +350,12 @@ const char* PluginBridgeNonRtServerOpcode2str(const PluginBridgeNonRtServerOpcod
         return "kPluginBridgeNonRtServerUiClosed";
     case kPluginBridgeNonRtServerError:
         return "kPluginBridgeNonRtServerError";
+    case kPluginBridgeNonRtServerParameterDataBulk:
+        return "kPluginBridgeNonRtServerParameterDataBulk";
+    case kPluginBridgeNonRtServerSetChunkDataShm:
+        return "kPluginBridgeNonRtServerSetChunkDataShm";
+    case kPluginBridgeNonRtServerChunkDataShmRead:
+        return "kPluginBridgeNonRtServerChunkDataShmRead";
     }
 
     carla_stderr("CarlaBackend::PluginBridgeNonRtServerOpcode2str%i) - invalid opcode", opcode);
@@ -30,6 +30,137 @@ CARLA_BACKEND_START_NAMESPACE
 
 const ushort kMaxEngineEventInternalCount = 512;
 
+// -----------------------------------------------------------------------
+// Pre-allocated event buffer
+
+/*
+ * Fixed-size list of kMaxEngineEventInternalCount engine events.
+ * Appending is O(1) and clearing only resets the count, readers should stop at 'count'.
+ * The slot after the last event is always kept as kEngineEventTypeNull, for code that still scans for it.
+ */
+struct EngineEventBuffer {
+    EngineEvent* data;
+    uint32_t     count;
+
+    EngineEventBuffer() noexcept
+        : data(nullptr),
+          count(0) {}
+
+    ~EngineEventBuffer() noexcept
+    {
+        free();
+    }
+
+    bool alloc() noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(data == nullptr, false);
+
+        try {
+            data = new EngineEvent[kMaxEngineEventInternalCount];
+        } CARLA_SAFE_EXCEPTION_RETURN("EngineEventBuffer::alloc", false);
+
+        clear();
+        return true;
+    }
+
+    void free() noexcept
+    {
+        if (data == nullptr)
+            return;
+
+        delete[] data;
+        data  = nullptr;
+        count = 0;
+    }
+
+    bool isAllocated() const noexcept
+    {
+        return data != nullptr;
+    }
+
+    // must only be called when allocated
+    void clear() noexcept
+    {
+        count = 0;
+        data[0].type = kEngineEventTypeNull;
+    }
+
+    // returns a zeroed event at the end of the list, or null if the buffer is full
+    EngineEvent* append() noexcept
+    {
+        if (count >= kMaxEngineEventInternalCount)
+            return nullptr;
+
+        EngineEvent* const event(&data[count++]);
+        carla_zeroStruct<EngineEvent>(*event);
+
+        if (count < kMaxEngineEventInternalCount)
+            data[count].type = kEngineEventTypeNull;
+
+        return event;
+    }
+
+    void copyFrom(const EngineEventBuffer& other) noexcept
+    {
+        count = other.count;
+
+        if (count > 0)
+            carla_copyStruct<EngineEvent>(data, other.data, count);
+
+        if (count < kMaxEngineEventInternalCount)
+            data[count].type = kEngineEventTypeNull;
+    }
+
+    /*
+     * Merge the events of 'other' into this buffer, keeping them ordered by time.
+     * Both buffers must already be sorted; on equal time our own events come first.
+     * Merging is done in place from the end, without any extra storage.
+     * If the result does not fit, the latest events are dropped and false is returned.
+     */
+    bool mergeFrom(const EngineEventBuffer& other) noexcept
+    {
+        if (other.count == 0)
+            return true;
+
+        const uint32_t wanted(count + other.count);
+        const uint32_t total(wanted < kMaxEngineEventInternalCount ? wanted : kMaxEngineEventInternalCount);
+
+        uint32_t skip(wanted - total);
+        int64_t  i(static_cast<int64_t>(count) - 1);       // read index, ours
+        int64_t  j(static_cast<int64_t>(other.count) - 1); // read index, other
+        int64_t  k(static_cast<int64_t>(total) - 1);       // write index
+
+        // once 'other' is consumed our remaining events are already in place
+        for (; j >= 0; --k)
+        {
+            const EngineEvent* event;
+
+            if (i >= 0 && data[i].time > other.data[j].time)
+                event = &data[i--];
+            else
+                event = &other.data[j--];
+
+            if (skip > 0)
+            {
+                --skip;
+                ++k;
+                continue;
+            }
+
+            carla_copyStruct<EngineEvent>(data[k], *event);
+        }
+
+        count = total;
+
+        if (count < kMaxEngineEventInternalCount)
+            data[count].type = kEngineEventTypeNull;
+
+        return wanted == total;
+    }
+
+    CARLA_DECLARE_NON_COPY_STRUCT(EngineEventBuffer)
+};
+
 // -----------------------------------------------------------------------
 
 static inline
@@ -49,6 +180,8 @@ const char* EngineType2Str(const EngineType type) noexcept
         return "kEngineTypePlugin";
     case kEngineTypeBridge:
         return "kEngineTypeBridge";
+    case kEngineTypeOffline:
+        return "kEngineTypeOffline";
     }
 
     carla_stderr("CarlaBackend::EngineType2Str(%i) - invalid type", type);
@@ -117,24 +250,12 @@ const char* EngineControlEventType2Str(const EngineControlEventType type) noexce
 // -----------------------------------------------------------------------
 
 static inline
-void fillEngineEventsFromJuceMidiBuffer(EngineEvent engineEvents[kMaxEngineEventInternalCount], const juce::MidiBuffer& midiBuffer)
+void fillEngineEventsFromJuceMidiBuffer(EngineEventBuffer& engineEvents, const juce::MidiBuffer& midiBuffer)
 {
     const uint8_t* midiData;
     int numBytes, sampleNumber;
-    ushort engineEventIndex = 0;
 
-    for (ushort i=0; i < kMaxEngineEventInternalCount; ++i)
-    {
-        const EngineEvent& engineEvent(engineEvents[i]);
-
-        if (engineEvent.type != kEngineEventTypeNull)
-            continue;
-
-        engineEventIndex = i;
-        break;
-    }
-
-    for (juce::MidiBuffer::Iterator midiBufferIterator(midiBuffer); midiBufferIterator.getNextEvent(midiData, numBytes, sampleNumber) && engineEventIndex < kMaxEngineEventInternalCount;)
+    for (juce::MidiBuffer::Iterator midiBufferIterator(midiBuffer); midiBufferIterator.getNextEvent(midiData, numBytes, sampleNumber);)
     {
         CARLA_SAFE_ASSERT_CONTINUE(numBytes > 0);
         CARLA_SAFE_ASSERT_CONTINUE(sampleNumber >= 0);
@@ -142,31 +263,30 @@ void fillEngineEventsFromJuceMidiBuffer(EngineEvent engineEvents[kMaxEngineEvent
         if (numBytes > UINT8_MAX)
             continue;
 
-        EngineEvent& engineEvent(engineEvents[engineEventIndex++]);
+        EngineEvent* const engineEvent(engineEvents.append());
+
+        if (engineEvent == nullptr)
+            break;
 
-        engineEvent.time = static_cast<uint32_t>(sampleNumber);
-        engineEvent.fillFromMidiData(static_cast<uint8_t>(numBytes), midiData);
+        engineEvent->time = static_cast<uint32_t>(sampleNumber);
+        engineEvent->fillFromMidiData(static_cast<uint8_t>(numBytes), midiData);
     }
 }
 
 // -----------------------------------------------------------------------
 
 static inline
-void fillJuceMidiBufferFromEngineEvents(juce::MidiBuffer& midiBuffer, const EngineEvent engineEvents[kMaxEngineEventInternalCount])
+void fillJuceMidiBufferFromEngineEvents(juce::MidiBuffer& midiBuffer, const EngineEventBuffer& engineEvents)
 {
     uint8_t        size     = 0;
     uint8_t        mdata[3] = { 0, 0, 0 };
     const uint8_t* mdataPtr = mdata;
 
-    for (ushort i=0; i < kMaxEngineEventInternalCount; ++i)
+    for (uint32_t i=0; i < engineEvents.count; ++i)
     {
-        const EngineEvent& engineEvent(engineEvents[i]);
+        const EngineEvent& engineEvent(engineEvents.data[i]);
 
-        if (engineEvent.type == kEngineEventTypeNull)
-        {
-            break;
-        }
-        else if (engineEvent.type == kEngineEventTypeControl)
+        if (engineEvent.type == kEngineEventTypeControl)
         {
             const EngineControlEvent& ctrlEvent(engineEvent.ctrl);
 
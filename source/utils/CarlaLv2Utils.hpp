@@ -81,7 +81,7 @@
 #ifdef USE_QT
 # include <QtCore/QStringList>
 #else
-# include "juce_core.h"
+# include "Lv2BundleIndex.hpp"
 #endif
 
 // -----------------------------------------------------------------------
@@ -244,8 +244,16 @@ public:
     Lilv::Node doap_license;
     Lilv::Node rdf_type;
     Lilv::Node rdfs_label;
+    Lilv::Node rdfs_seeAlso;
 
     bool needsInit;
+    bool loadedAll;
+
+#ifndef USE_QT
+    Lv2BundleIndex bundleIndex;
+    juce::StringArray loadedBundles;
+    juce::StringArray loadedPlugins;
+#endif
 
     // -------------------------------------------------------------------
 
@@ -363,8 +371,16 @@ public:
           doap_license       (new_uri(NS_doap "license")),
           rdf_type           (new_uri(NS_rdf "type")),
           rdfs_label         (new_uri(NS_rdfs "label")),
-
-          needsInit(true)    {}
+          rdfs_seeAlso       (new_uri(NS_rdfs "seeAlso")),
+
+          needsInit(true),
+          loadedAll(false)
+#ifndef USE_QT
+        , bundleIndex(),
+          loadedBundles(),
+          loadedPlugins()
+#endif
+    {}
 
     static Lv2WorldClass& getInstance()
     {
@@ -376,14 +392,56 @@ public:
     {
         CARLA_SAFE_ASSERT_RETURN(LV2_PATH != nullptr && LV2_PATH[0] != '\0',);
 
-        if (! needsInit)
+        if (loadedAll)
             return;
 
+        // bundles already loaded one by one will be reported as duplicates by lilv, but work fine
         needsInit = false;
+        loadedAll = true;
 
         Lilv::World::load_all(LV2_PATH);
     }
 
+#ifndef USE_QT
+    // Only load the bundles a single plugin needs, falls back to loading everything if the plugin is not found.
+    void initIfNeeded(const char* const LV2_PATH, const LV2_URI uri)
+    {
+        CARLA_SAFE_ASSERT_RETURN(LV2_PATH != nullptr && LV2_PATH[0] != '\0',);
+        CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0',);
+
+        if (loadedAll || loadedPlugins.contains(uri))
+            return;
+
+        const juce::StringArray bundles(bundleIndex.getPluginBundles(LV2_PATH, uri));
+
+        if (bundles.size() == 0)
+        {
+            carla_stderr("Lv2WorldClass::initIfNeeded(\"%s\") - plugin not found in bundle index, loading everything", uri);
+            return initIfNeeded(LV2_PATH);
+        }
+
+        for (int i=0, count=bundles.size(); i < count; ++i)
+        {
+            if (loadedBundles.contains(bundles[i]))
+                continue;
+
+            loadedBundles.add(bundles[i]);
+
+            Lilv::Node bundleNode(new_file_uri(nullptr, bundles[i].toRawUTF8()));
+            CARLA_SAFE_ASSERT_CONTINUE(bundleNode.is_uri());
+
+            juce::String bundleURI(bundleNode.as_uri());
+
+            if (! bundleURI.endsWithChar('/'))
+                bundleURI += "/";
+
+            load_bundle(bundleURI.toRawUTF8());
+        }
+
+        loadedPlugins.add(uri);
+    }
+#endif
+
     void load_bundle(const char* const bundle)
     {
         CARLA_SAFE_ASSERT_RETURN(bundle != nullptr && bundle[0] != '\0',);
@@ -447,6 +505,9 @@ public:
         LilvNode* const uriNode(lilv_new_uri(this->me, uri));
         CARLA_SAFE_ASSERT_RETURN(uriNode != nullptr, nullptr);
 
+        // the state data is not loaded yet if the plugin descriptor came from the cache
+        lilv_world_load_resource(this->me, uriNode);
+
         LilvState* const cState(lilv_state_new_from_world(this->me, uridMap, uriNode));
         lilv_node_free(uriNode);
 
@@ -584,6 +645,12 @@ const LV2_RDF_Descriptor* lv2_rdf_new(const LV2_URI uri, const bool loadPresets)
         }
 
         lilv_nodes_free(const_cast<LilvNodes*>(licenseNodes.me));
+
+        Lilv::Nodes stateNodes(lilvPlugin.get_value(lv2World.state_state));
+
+        rdfDescriptor->HasDefaultState = (stateNodes.size() > 0);
+
+        lilv_nodes_free(const_cast<LilvNodes*>(stateNodes.me));
     }
 
     // -------------------------------------------------------------------
@@ -1421,6 +1488,59 @@ const LV2_RDF_Descriptor* lv2_rdf_new(const LV2_URI uri, const bool loadPresets)
     return rdfDescriptor;
 }
 
+#ifndef USE_QT
+// -----------------------------------------------------------------------
+// Get RDF object from the on-disk cache, or create and cache it (using lilv) if missing or stale.
+// The LV2 world is only loaded when the cache cannot be used, and then only the bundles this plugin needs.
+
+static inline
+const LV2_RDF_Descriptor* lv2_rdf_new_cached(const LV2_URI uri, const char* const LV2_PATH)
+{
+    CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', nullptr);
+    CARLA_SAFE_ASSERT_RETURN(LV2_PATH != nullptr && LV2_PATH[0] != '\0', nullptr);
+
+    const Lv2RdfCache cache(LV2_PATH);
+
+    if (const LV2_RDF_Descriptor* const rdfDescriptor = cache.load(uri))
+        return rdfDescriptor;
+
+    Lv2WorldClass& lv2World(Lv2WorldClass::getInstance());
+    lv2World.initIfNeeded(LV2_PATH, uri);
+
+    const LV2_RDF_Descriptor* const rdfDescriptor(lv2_rdf_new(uri, true));
+
+    if (rdfDescriptor == nullptr)
+        return nullptr;
+
+    // presets are often in their own bundles, check those too
+    juce::StringArray presetBundles;
+
+    for (uint32_t i=0; i < rdfDescriptor->PresetCount; ++i)
+    {
+        if (rdfDescriptor->Presets[i].URI == nullptr)
+            continue;
+
+        Lilv::Node presetNode(lv2World.new_uri(rdfDescriptor->Presets[i].URI));
+        Lilv::Nodes fileNodes(lv2World.find_nodes(presetNode, lv2World.rdfs_seeAlso, nullptr));
+
+        LILV_FOREACH(nodes, it, fileNodes)
+        {
+            Lilv::Node fileNode(fileNodes.get(it));
+
+            if (const char* const fileURI = fileNode.as_uri())
+                presetBundles.addIfNotAlreadyThere(juce::File(lilv_uri_to_path(fileURI)).getParentDirectory().getFullPathName());
+        }
+
+        lilv_nodes_free(const_cast<LilvNodes*>(fileNodes.me));
+    }
+
+    if (! cache.store(rdfDescriptor, presetBundles))
+        carla_stderr("lv2_rdf_new_cached(\"%s\") - failed to write cache entry", uri);
+
+    return rdfDescriptor;
+}
+#endif
+
 // -----------------------------------------------------------------------
 // Check if we support a plugin port
 
@@ -205,6 +205,7 @@ public:
 
     /*!
      * Write an lv2 "urid" message.
+     * An 'urid' of 0 asks the host to map 'uri', which replies with another "urid" message.
      */
     void writeLv2UridMessage(const uint32_t urid, const char* const uri) const noexcept;
 
@@ -36,6 +36,14 @@ extern "C" {
 # endif
 #endif
 
+#ifdef CARLA_OS_LINUX
+# include <algorithm>
+# include <cerrno>
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
 /*
  * Create a new semaphore.
  */
@@ -131,16 +139,16 @@ bool carla_sem_post(sem_t* const sem) noexcept
 }
 
 /*
- * Wait for a semaphore (lock).
+ * Wait for a semaphore (lock), with a timeout in milliseconds.
  */
 static inline
-bool carla_sem_timedwait(sem_t* const sem, const uint secs) noexcept
+bool carla_sem_timedwait_ms(sem_t* const sem, const uint msecs) noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(sem != nullptr, false);
-    CARLA_SAFE_ASSERT_RETURN(secs > 0, false);
+    CARLA_SAFE_ASSERT_RETURN(msecs > 0, false);
 
 #if defined(CARLA_OS_WIN)
-    const DWORD result = ::WaitForSingleObject(sem->handle, secs*1000);
+    const DWORD result = ::WaitForSingleObject(sem->handle, msecs);
 
     switch (result)
     {
@@ -163,7 +171,14 @@ bool carla_sem_timedwait(sem_t* const sem, const uint secs) noexcept
     timeout.tv_sec  = now.tv_sec;
     timeout.tv_nsec = now.tv_usec * 1000;
 # endif
-    timeout.tv_sec += static_cast<time_t>(secs);
+    timeout.tv_sec  += static_cast<time_t>(msecs / 1000);
+    timeout.tv_nsec += static_cast<long>(msecs % 1000) * 1000000L;
+
+    if (timeout.tv_nsec >= 1000000000L)
+    {
+        timeout.tv_sec  += 1;
+        timeout.tv_nsec -= 1000000000L;
+    }
 
     try {
         return (::sem_timedwait(sem, &timeout) == 0);
@@ -171,6 +186,165 @@ bool carla_sem_timedwait(sem_t* const sem, const uint secs) noexcept
 #endif
 }
 
+/*
+ * Wait for a semaphore (lock).
+ */
+static inline
+bool carla_sem_timedwait(sem_t* const sem, const uint secs) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(secs > 0, false);
+
+    return carla_sem_timedwait_ms(sem, secs * 1000);
+}
+
+#ifdef CARLA_OS_LINUX
+// -----------------------------------------------------------------------
+// Spin-then-futex semaphore
+
+/*
+ * Lightweight semaphore that can live in shared memory, used for low-latency handshakes between processes.
+ * Waiting spins for a short time first, and only sleeps in the kernel (using a futex) if nothing was posted meanwhile.
+ * The spin time adapts itself: it grows when spinning was enough and shrinks when the waiter had to sleep.
+ */
+struct carla_futex_sem_t {
+    int32_t value;    // number of pending posts, the futex word
+    int32_t waiters;  // number of threads sleeping in the kernel
+    int32_t spins;    // current spin count
+    int32_t maxSpins; // 0 on single-core systems
+};
+
+static const int32_t kCarlaFutexSemMinSpins = 16;
+static const int32_t kCarlaFutexSemMaxSpins = 4096;
+
+/*
+ * Initialize a futex semaphore, possibly in shared memory.
+ */
+static inline
+void carla_futex_sem_init(carla_futex_sem_t* const sem) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(sem != nullptr,);
+
+    sem->value    = 0;
+    sem->waiters  = 0;
+    sem->maxSpins = (::sysconf(_SC_NPROCESSORS_ONLN) > 1) ? kCarlaFutexSemMaxSpins : 0;
+    sem->spins    = std::min(kCarlaFutexSemMinSpins*8, sem->maxSpins);
+
+    __sync_synchronize();
+}
+
+/*
+ * Try to take a post from a futex semaphore, without waiting.
+ */
+static inline
+bool carla_futex_sem_trywait(carla_futex_sem_t* const sem) noexcept
+{
+    for (int32_t value;;)
+    {
+        value = *(volatile int32_t*)&sem->value;
+
+        if (value <= 0)
+            return false;
+        if (__sync_bool_compare_and_swap(&sem->value, value, value-1))
+            return true;
+    }
+}
+
+/*
+ * Post a futex semaphore (unlock).
+ */
+static inline
+bool carla_futex_sem_post(carla_futex_sem_t* const sem) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(sem != nullptr, false);
+
+    __sync_add_and_fetch(&sem->value, 1);
+
+    // only enter the kernel if the other side is sleeping
+    if (*(volatile int32_t*)&sem->waiters > 0)
+        ::syscall(SYS_futex, &sem->value, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+
+    return true;
+}
+
+/*
+ * Wait for a futex semaphore (lock), with a timeout in milliseconds.
+ * errno is set to ETIMEDOUT if the timeout is reached.
+ */
+static inline
+bool carla_futex_sem_timedwait_ms(carla_futex_sem_t* const sem, const uint msecs) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(sem != nullptr, false);
+    CARLA_SAFE_ASSERT_RETURN(msecs > 0, false);
+
+    // spin first
+    const int32_t spins(sem->spins);
+
+    for (int32_t i=0; i < spins; ++i)
+    {
+        if (carla_futex_sem_trywait(sem))
+        {
+            sem->spins = std::min(spins + spins/4 + 1, sem->maxSpins);
+            return true;
+        }
+#if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // nothing yet, sleep
+    timespec now, deadline;
+    ::clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += static_cast<time_t>(msecs / 1000);
+    deadline.tv_nsec += static_cast<long>(msecs % 1000) * 1000000L;
+
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    bool ok = false;
+    __sync_add_and_fetch(&sem->waiters, 1);
+
+    for (timespec timeout;;)
+    {
+        if (carla_futex_sem_trywait(sem))
+        {
+            ok = true;
+            break;
+        }
+
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        timeout.tv_sec  = deadline.tv_sec  - now.tv_sec;
+        timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+
+        if (timeout.tv_nsec < 0)
+        {
+            timeout.tv_sec  -= 1;
+            timeout.tv_nsec += 1000000000L;
+        }
+
+        if (timeout.tv_sec < 0)
+        {
+            errno = ETIMEDOUT;
+            break;
+        }
+
+        // returns right away if a post happened in between
+        if (::syscall(SYS_futex, &sem->value, FUTEX_WAIT, 0, &timeout, nullptr, 0) != 0)
+        {
+            if (errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT)
+                break;
+        }
+    }
+
+    __sync_sub_and_fetch(&sem->waiters, 1);
+
+    sem->spins = std::max(spins/2, std::min(kCarlaFutexSemMinSpins, sem->maxSpins));
+    return ok;
+}
+#endif // CARLA_OS_LINUX
+
 // -----------------------------------------------------------------------
 
 #endif // CARLA_SEM_UTILS_HPP_INCLUDED
@@ -292,7 +292,7 @@ const char* carla_strdup(const char* const strBuf)
     char* const       buffer    = new char[bufferLen+1];
 
     if (strBuf != nullptr && bufferLen > 0)
-        std::strncpy(buffer, strBuf, bufferLen);
+        std::memcpy(buffer, strBuf, bufferLen);
 
     buffer[bufferLen] = '\0';
 
@@ -330,7 +330,7 @@ const char* carla_strdup_safe(const char* const strBuf) noexcept
     } CARLA_SAFE_EXCEPTION_RETURN("carla_strdup_safe", nullptr);
 
     if (strBuf != nullptr && bufferLen > 0)
-        std::strncpy(buffer, strBuf, bufferLen);
+        std::memcpy(buffer, strBuf, bufferLen);
 
     buffer[bufferLen] = '\0';
 
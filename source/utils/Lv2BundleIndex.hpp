@@ -0,0 +1,366 @@
+/*
+ * LV2 Bundle Index
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#ifndef LV2_BUNDLE_INDEX_HPP_INCLUDED
+#define LV2_BUNDLE_INDEX_HPP_INCLUDED
+
+#include "Lv2RdfCache.hpp"
+
+#include "lv2/lv2.h"
+#include "lv2/ui.h"
+#include "serd/serd.h"
+
+// -----------------------------------------------------------------------
+// Index of the LV2 bundles on LV2_PATH and the plugins they describe, made from their manifest files only.
+// It is saved next to the RDF cache, only bundles with a changed manifest are parsed again.
+
+class Lv2BundleIndex
+{
+public:
+    /*
+     * Constructor.
+     */
+    Lv2BundleIndex(const juce::File& dir = Lv2RdfCache::getDefaultDirectory())
+        : fDir(dir),
+          fLv2Path(),
+          fBundles(),
+          fScanned(false) {}
+
+    /*
+     * Get the bundles a plugin needs, as directory paths.
+     * These are the bundle declaring the plugin plus the ones adding UIs or presets to it.
+     * The declaring bundle comes last, as lilv only sees data from bundles loaded before it.
+     * Returns an empty list if the plugin is not in any bundle.
+     */
+    juce::StringArray getPluginBundles(const char* const lv2Path, const LV2_URI uri)
+    {
+        CARLA_SAFE_ASSERT_RETURN(lv2Path != nullptr && lv2Path[0] != '\0', juce::StringArray());
+        CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', juce::StringArray());
+
+        bool justScanned = false;
+
+        if (fLv2Path != lv2Path)
+        {
+            fLv2Path = lv2Path;
+            fScanned = false;
+            fBundles.clear();
+            readFromDisk();
+        }
+
+        if (! fScanned)
+        {
+            scan();
+            justScanned = true;
+        }
+
+        juce::StringArray bundles(findPluginBundles(uri));
+
+        // might have been installed since our last scan
+        if (bundles.size() == 0 && ! justScanned)
+        {
+            scan();
+            bundles = findPluginBundles(uri);
+        }
+
+        return bundles;
+    }
+
+private:
+    struct Bundle {
+        juce::String path;
+        juce::int64 mtime;
+        juce::int64 size;
+        juce::StringArray plugins; // plugins declared in this bundle
+        juce::StringArray related; // plugins this bundle adds UIs or presets to
+
+        Bundle(const juce::String& p, const juce::int64 m, const juce::int64 s)
+            : path(p),
+              mtime(m),
+              size(s),
+              plugins(),
+              related() {}
+    };
+
+    const juce::File fDir;
+    juce::String fLv2Path;
+    juce::OwnedArray<Bundle> fBundles;
+    bool fScanned;
+
+    juce::File getFile() const
+    {
+        return fDir.getChildFile("bundles-" + juce::String::toHexString(fLv2Path.hashCode64()) + ".index");
+    }
+
+    juce::StringArray findPluginBundles(const LV2_URI uri) const
+    {
+        juce::StringArray bundles;
+        const Bundle* pluginBundle = nullptr;
+
+        for (int i=0, count=fBundles.size(); i < count; ++i)
+        {
+            const Bundle* const bundle(fBundles.getUnchecked(i));
+
+            if (bundle->plugins.contains(uri))
+            {
+                // the first one wins, like in lilv
+                if (pluginBundle == nullptr)
+                    pluginBundle = bundle;
+            }
+            else if (bundle->related.contains(uri))
+            {
+                bundles.add(bundle->path);
+            }
+        }
+
+        if (pluginBundle == nullptr)
+            return juce::StringArray();
+
+        bundles.add(pluginBundle->path);
+        return bundles;
+    }
+
+    // -------------------------------------------------------------------
+    // scan LV2_PATH, only parsing new or changed manifests
+
+    void scan()
+    {
+        fScanned = true;
+
+        juce::OwnedArray<Bundle> oldBundles;
+        oldBundles.swapWith(fBundles);
+
+        juce::HashMap<juce::String, int> oldIndexes;
+
+        for (int i=0, count=oldBundles.size(); i < count; ++i)
+            oldIndexes.set(oldBundles.getUnchecked(i)->path, i);
+
+        juce::StringArray paths;
+#ifdef CARLA_OS_WIN
+        paths.addTokens(fLv2Path, ";", "");
+#else
+        paths.addTokens(fLv2Path, ":", "");
+#endif
+        paths.removeEmptyStrings();
+
+        bool changed = false;
+
+        for (int i=0, count=paths.size(); i < count; ++i)
+        {
+            juce::Array<juce::File> dirs;
+            juce::File(paths[i]).findChildFiles(dirs, juce::File::findDirectories, false);
+
+            for (int j=0, dcount=dirs.size(); j < dcount; ++j)
+            {
+                const juce::File manifest(dirs.getReference(j).getChildFile("manifest.ttl"));
+
+                if (! manifest.existsAsFile())
+                    continue;
+
+                const juce::String path(dirs.getReference(j).getFullPathName());
+                const juce::int64 mtime(manifest.getLastModificationTime().toMilliseconds());
+                const juce::int64 size(manifest.getSize());
+
+                if (oldIndexes.contains(path))
+                {
+                    const int index(oldIndexes[path]);
+                    Bundle* const bundle(oldBundles.getUnchecked(index));
+
+                    if (bundle != nullptr && bundle->mtime == mtime && bundle->size == size)
+                    {
+                        fBundles.add(bundle);
+                        oldBundles.set(index, nullptr, false);
+                        continue;
+                    }
+                }
+
+                Bundle* const bundle(new Bundle(path, mtime, size));
+                parseManifest(manifest, bundle);
+                fBundles.add(bundle);
+                changed = true;
+            }
+        }
+
+        // removed bundles
+        for (int i=0, count=oldBundles.size(); i < count && ! changed; ++i)
+        {
+            if (oldBundles.getUnchecked(i) != nullptr)
+                changed = true;
+        }
+
+        if (changed)
+            writeToDisk();
+    }
+
+    struct ParseContext {
+        SerdEnv* env;
+        Bundle* bundle;
+    };
+
+    static void parseManifest(const juce::File& manifest, Bundle* const bundle)
+    {
+        SerdNode baseNode(serd_node_new_file_uri((const uint8_t*)manifest.getFullPathName().toRawUTF8(), nullptr, nullptr, true));
+        CARLA_SAFE_ASSERT_RETURN(baseNode.buf != nullptr,);
+
+        ParseContext context;
+        context.env    = serd_env_new(&baseNode);
+        context.bundle = bundle;
+
+        if (SerdReader* const reader = serd_reader_new(SERD_TURTLE, &context, nullptr, _base, _prefix, _statement, nullptr))
+        {
+            if (serd_reader_read_file(reader, baseNode.buf) != SERD_SUCCESS)
+                carla_stderr("Lv2BundleIndex: failed to parse '%s'", manifest.getFullPathName().toRawUTF8());
+
+            serd_reader_free(reader);
+        }
+
+        serd_env_free(context.env);
+        serd_node_free(&baseNode);
+    }
+
+    static SerdStatus _base(void* const handle, const SerdNode* const uri)
+    {
+        return serd_env_set_base_uri(((ParseContext*)handle)->env, uri);
+    }
+
+    static SerdStatus _prefix(void* const handle, const SerdNode* const name, const SerdNode* const uri)
+    {
+        return serd_env_set_prefix(((ParseContext*)handle)->env, name, uri);
+    }
+
+    static SerdStatus _statement(void* const handle, SerdStatementFlags, const SerdNode*,
+                                 const SerdNode* const subject, const SerdNode* const predicate, const SerdNode* const object,
+                                 const SerdNode*, const SerdNode*)
+    {
+        ParseContext* const context((ParseContext*)handle);
+
+        SerdNode predicateNode(serd_env_expand_node(context->env, predicate));
+
+        if (predicateNode.buf == nullptr)
+            return SERD_SUCCESS;
+
+        const char* const predicateURI((const char*)predicateNode.buf);
+
+        // <plugin> a lv2:Plugin
+        if (std::strcmp(predicateURI, "http://www.w3.org/1999/02/22-rdf-syntax-ns#type") == 0)
+        {
+            SerdNode objectNode(serd_env_expand_node(context->env, object));
+
+            if (objectNode.buf != nullptr && std::strcmp((const char*)objectNode.buf, LV2_CORE__Plugin) == 0)
+                addURI(context, subject, context->bundle->plugins);
+
+            serd_node_free(&objectNode);
+        }
+        // <plugin> ui:ui <ui>
+        else if (std::strcmp(predicateURI, LV2_UI__ui) == 0)
+        {
+            addURI(context, subject, context->bundle->related);
+        }
+        // <preset> lv2:appliesTo <plugin>
+        else if (std::strcmp(predicateURI, LV2_CORE__appliesTo) == 0)
+        {
+            addURI(context, object, context->bundle->related);
+        }
+
+        serd_node_free(&predicateNode);
+        return SERD_SUCCESS;
+    }
+
+    static void addURI(ParseContext* const context, const SerdNode* const node, juce::StringArray& list)
+    {
+        SerdNode uriNode(serd_env_expand_node(context->env, node));
+
+        if (uriNode.buf != nullptr)
+            list.addIfNotAlreadyThere(juce::String::fromUTF8((const char*)uriNode.buf));
+
+        serd_node_free(&uriNode);
+    }
+
+    // -------------------------------------------------------------------
+    // text file, one line per item:
+    //  B <tab> bundle path <tab> manifest mtime <tab> manifest size
+    //  P <tab> plugin URI
+    //  R <tab> related plugin URI
+
+    static const char* kHeader() noexcept
+    {
+        return "carla-lv2-bundle-index 1";
+    }
+
+    void readFromDisk()
+    {
+        juce::StringArray lines;
+        getFile().readLines(lines);
+
+        if (lines.size() == 0 || lines[0] != kHeader())
+            return;
+
+        Bundle* bundle = nullptr;
+
+        for (int i=1, count=lines.size(); i < count; ++i)
+        {
+            juce::StringArray tokens;
+            tokens.addTokens(lines[i], "\t", "");
+
+            if (tokens.size() == 4 && tokens[0] == "B")
+            {
+                bundle = new Bundle(tokens[1], tokens[2].getLargeIntValue(), tokens[3].getLargeIntValue());
+                fBundles.add(bundle);
+            }
+            else if (tokens.size() == 2 && tokens[0] == "P" && bundle != nullptr)
+            {
+                bundle->plugins.add(tokens[1]);
+            }
+            else if (tokens.size() == 2 && tokens[0] == "R" && bundle != nullptr)
+            {
+                bundle->related.add(tokens[1]);
+            }
+        }
+    }
+
+    void writeToDisk() const
+    {
+        juce::MemoryOutputStream out;
+        out << kHeader() << "\n";
+
+        for (int i=0, count=fBundles.size(); i < count; ++i)
+        {
+            const Bundle* const bundle(fBundles.getUnchecked(i));
+
+            out << "B\t" << bundle->path << "\t" << bundle->mtime << "\t" << bundle->size << "\n";
+
+            for (int j=0, pcount=bundle->plugins.size(); j < pcount; ++j)
+                out << "P\t" << bundle->plugins[j] << "\n";
+
+            for (int j=0, rcount=bundle->related.size(); j < rcount; ++j)
+                out << "R\t" << bundle->related[j] << "\n";
+        }
+
+        if (! fDir.createDirectory())
+            return;
+
+        const juce::TemporaryFile tmpFile(getFile());
+
+        if (tmpFile.getFile().replaceWithData(out.getData(), out.getDataSize()))
+            tmpFile.overwriteTargetFileWithTemporary();
+    }
+
+    CARLA_DECLARE_NON_COPY_CLASS(Lv2BundleIndex)
+};
+
+// -----------------------------------------------------------------------
+
+#endif // LV2_BUNDLE_INDEX_HPP_INCLUDED
@@ -0,0 +1,551 @@
+/*
+ * LV2 RDF Cache
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#ifndef LV2_RDF_CACHE_HPP_INCLUDED
+#define LV2_RDF_CACHE_HPP_INCLUDED
+
+#include "CarlaUtils.hpp"
+
+#include "lv2_rdf.hpp"
+
+#include "juce_core.h"
+
+// -----------------------------------------------------------------------
+// On-disk cache of LV2_RDF_Descriptor, one memory-mapped file per plugin URI.
+// Each entry records the modification time and size of the LV2_PATH directories and
+// of every bundle it was created from, and is ignored once any of them changes.
+
+class Lv2RdfCache
+{
+public:
+    /*
+     * Constructor.
+     * 'lv2Path' is the LV2_PATH used to create the descriptors, entries made with another path are ignored.
+     */
+    Lv2RdfCache(const char* const lv2Path, const juce::File& dir = getDefaultDirectory())
+        : fLv2Path(lv2Path),
+          fDir(dir) {}
+
+    /*
+     * Load a descriptor from the cache.
+     * Returns null if not cached or stale.
+     */
+    LV2_RDF_Descriptor* load(const LV2_URI uri) const
+    {
+        CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', nullptr);
+
+        const juce::File file(getFileFor(uri));
+
+        if (! file.existsAsFile())
+            return nullptr;
+
+        const juce::MemoryMappedFile mappedFile(file, juce::MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() == nullptr)
+            return nullptr;
+
+        Reader reader(mappedFile.getData(), mappedFile.getSize());
+
+        if (! readHeader(reader, uri))
+            return nullptr;
+
+        LV2_RDF_Descriptor* const rdfDescriptor(new LV2_RDF_Descriptor());
+
+        if (readDescriptor(reader, rdfDescriptor) && reader.isAtEnd())
+            return rdfDescriptor;
+
+        carla_stderr("Lv2RdfCache::load(\"%s\") - cache entry is corrupt", uri);
+        delete rdfDescriptor;
+        return nullptr;
+    }
+
+    /*
+     * Store a descriptor in the cache.
+     * The plugin and UI bundles are checked automatically, 'extraBundles' adds more (like preset bundles).
+     */
+    bool store(const LV2_RDF_Descriptor* const rdfDescriptor, const juce::StringArray& extraBundles = juce::StringArray()) const
+    {
+        CARLA_SAFE_ASSERT_RETURN(rdfDescriptor != nullptr, false);
+        CARLA_SAFE_ASSERT_RETURN(rdfDescriptor->URI != nullptr, false);
+
+        // dependencies
+        juce::StringArray bundles(extraBundles);
+
+        if (rdfDescriptor->Bundle != nullptr)
+            bundles.add(rdfDescriptor->Bundle);
+
+        for (uint32_t i=0; i < rdfDescriptor->UICount; ++i)
+        {
+            if (rdfDescriptor->UIs[i].Bundle != nullptr)
+                bundles.add(rdfDescriptor->UIs[i].Bundle);
+        }
+
+        juce::StringArray paths;
+#ifdef CARLA_OS_WIN
+        paths.addTokens(fLv2Path, ";", "");
+#else
+        paths.addTokens(fLv2Path, ":", "");
+#endif
+        paths.removeEmptyStrings();
+
+        for (int i=0, count=bundles.size(); i < count; ++i)
+        {
+            const juce::File bundle(bundles[i]);
+
+            if (! bundle.isDirectory())
+                continue;
+
+            paths.add(bundle.getFullPathName());
+
+            juce::Array<juce::File> files;
+            bundle.findChildFiles(files, juce::File::findFiles, false, "*.ttl");
+
+            for (int j=0, fcount=files.size(); j < fcount; ++j)
+                paths.add(files.getReference(j).getFullPathName());
+        }
+
+        paths.removeDuplicates(false);
+
+        // write
+        juce::MemoryOutputStream out;
+
+        writeValue(out, kMagic);
+        writeValue(out, kVersion);
+        writeString(out, rdfDescriptor->URI);
+        writeString(out, fLv2Path.toRawUTF8());
+
+        writeValue(out, static_cast<uint32_t>(paths.size()));
+
+        for (int i=0, count=paths.size(); i < count; ++i)
+        {
+            const juce::File file(paths[i]);
+
+            writeString(out, paths[i].toRawUTF8());
+            writeValue(out, static_cast<int64_t>(file.getLastModificationTime().toMilliseconds()));
+            writeValue(out, static_cast<int64_t>(file.getSize()));
+        }
+
+        writeDescriptor(out, rdfDescriptor);
+
+        if (! fDir.createDirectory())
+            return false;
+
+        const juce::TemporaryFile tmpFile(getFileFor(rdfDescriptor->URI));
+
+        if (! tmpFile.getFile().replaceWithData(out.getData(), out.getDataSize()))
+            return false;
+
+        return tmpFile.overwriteTargetFileWithTemporary();
+    }
+
+    /*
+     * Default cache location for this user.
+     */
+    static juce::File getDefaultDirectory()
+    {
+#if defined(CARLA_OS_WIN) || defined(CARLA_OS_MAC)
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Carla").getChildFile("lv2-rdf");
+#else
+        const char* const xdgCacheHome(std::getenv("XDG_CACHE_HOME"));
+
+        if (xdgCacheHome != nullptr && xdgCacheHome[0] == '/')
+            return juce::File(xdgCacheHome).getChildFile("carla").getChildFile("lv2-rdf");
+
+        return juce::File::getSpecialLocation(juce::File::userHomeDirectory).getChildFile(".cache").getChildFile("carla").getChildFile("lv2-rdf");
+#endif
+    }
+
+private:
+    const juce::String fLv2Path;
+    const juce::File   fDir;
+
+    static const uint32_t kMagic      = 0x4644524c; // "LRDF"
+    static const uint32_t kVersion    = 1;
+    static const uint32_t kNullString = 0xffffffff;
+
+    juce::File getFileFor(const LV2_URI uri) const
+    {
+        return fDir.getChildFile(juce::String::toHexString(juce::String(uri).hashCode64()) + ".rdf");
+    }
+
+    // -------------------------------------------------------------------
+    // writing
+
+    template<typename T>
+    static void writeValue(juce::MemoryOutputStream& out, const T value)
+    {
+        out.write(&value, sizeof(T));
+    }
+
+    static void writeString(juce::MemoryOutputStream& out, const char* const str)
+    {
+        if (str == nullptr)
+        {
+            writeValue(out, kNullString);
+            return;
+        }
+
+        const uint32_t len(static_cast<uint32_t>(std::strlen(str)));
+
+        writeValue(out, len);
+        out.write(str, len+1);
+    }
+
+    static void writeFeatures(juce::MemoryOutputStream& out, const uint32_t count, const LV2_RDF_Feature* const features)
+    {
+        writeValue(out, count);
+
+        for (uint32_t i=0; i < count; ++i)
+        {
+            writeValue(out, features[i].Type);
+            writeString(out, features[i].URI);
+        }
+    }
+
+    static void writeExtensions(juce::MemoryOutputStream& out, const uint32_t count, const LV2_URI* const extensions)
+    {
+        writeValue(out, count);
+
+        for (uint32_t i=0; i < count; ++i)
+            writeString(out, extensions[i]);
+    }
+
+    static void writeDescriptor(juce::MemoryOutputStream& out, const LV2_RDF_Descriptor* const rdfDescriptor)
+    {
+        writeValue(out, rdfDescriptor->Type[0]);
+        writeValue(out, rdfDescriptor->Type[1]);
+        writeString(out, rdfDescriptor->URI);
+        writeString(out, rdfDescriptor->Name);
+        writeString(out, rdfDescriptor->Author);
+        writeString(out, rdfDescriptor->License);
+        writeString(out, rdfDescriptor->Binary);
+        writeString(out, rdfDescriptor->Bundle);
+        writeValue(out, static_cast<uint64_t>(rdfDescriptor->UniqueID));
+        writeValue(out, static_cast<uint8_t>(rdfDescriptor->HasDefaultState ? 1 : 0));
+
+        writeValue(out, rdfDescriptor->PortCount);
+
+        for (uint32_t i=0; i < rdfDescriptor->PortCount; ++i)
+        {
+            const LV2_RDF_Port& port(rdfDescriptor->Ports[i]);
+
+            writeValue(out, port.Types);
+            writeValue(out, port.Properties);
+            writeValue(out, port.Designation);
+            writeString(out, port.Name);
+            writeString(out, port.Symbol);
+
+            writeValue(out, port.MidiMap.Type);
+            writeValue(out, port.MidiMap.Number);
+
+            writeValue(out, port.Points.Hints);
+            writeValue(out, port.Points.Default);
+            writeValue(out, port.Points.Minimum);
+            writeValue(out, port.Points.Maximum);
+
+            writeValue(out, port.Unit.Hints);
+            writeString(out, port.Unit.Name);
+            writeString(out, port.Unit.Render);
+            writeString(out, port.Unit.Symbol);
+            writeValue(out, port.Unit.Unit);
+
+            writeValue(out, port.MinimumSize);
+
+            writeValue(out, port.ScalePointCount);
+
+            for (uint32_t j=0; j < port.ScalePointCount; ++j)
+            {
+                writeString(out, port.ScalePoints[j].Label);
+                writeValue(out, port.ScalePoints[j].Value);
+            }
+        }
+
+        writeValue(out, rdfDescriptor->PresetCount);
+
+        for (uint32_t i=0; i < rdfDescriptor->PresetCount; ++i)
+        {
+            writeString(out, rdfDescriptor->Presets[i].URI);
+            writeString(out, rdfDescriptor->Presets[i].Label);
+        }
+
+        writeFeatures(out, rdfDescriptor->FeatureCount, rdfDescriptor->Features);
+        writeExtensions(out, rdfDescriptor->ExtensionCount, rdfDescriptor->Extensions);
+
+        writeValue(out, rdfDescriptor->UICount);
+
+        for (uint32_t i=0; i < rdfDescriptor->UICount; ++i)
+        {
+            const LV2_RDF_UI& ui(rdfDescriptor->UIs[i]);
+
+            writeValue(out, ui.Type);
+            writeString(out, ui.URI);
+            writeString(out, ui.Binary);
+            writeString(out, ui.Bundle);
+
+            writeFeatures(out, ui.FeatureCount, ui.Features);
+            writeExtensions(out, ui.ExtensionCount, ui.Extensions);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    // reading, all sizes are checked against the mapped data
+
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t pos;
+
+        Reader(const void* const d, const size_t s) noexcept
+            : data(static_cast<const uint8_t*>(d)),
+              size(s),
+              pos(0) {}
+
+        bool isAtEnd() const noexcept
+        {
+            return pos == size;
+        }
+
+        template<typename T>
+        bool read(T& value) noexcept
+        {
+            if (size - pos < sizeof(T))
+                return false;
+
+            std::memcpy(&value, data + pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        // every item takes at least 1 byte, so a valid count can never exceed the remaining size
+        bool readCount(uint32_t& count) noexcept
+        {
+            return read(count) && count <= size - pos;
+        }
+
+        // points to the mapped data, valid while the file stays mapped
+        bool readStringRef(const char*& str) noexcept
+        {
+            uint32_t len;
+
+            if (! read(len))
+                return false;
+
+            if (len == kNullString)
+            {
+                str = nullptr;
+                return true;
+            }
+
+            if (size - pos <= len || data[pos+len] != '\0')
+                return false;
+
+            str = reinterpret_cast<const char*>(data + pos);
+            pos += len+1;
+            return true;
+        }
+
+        bool readString(const char*& str) noexcept
+        {
+            const char* ref;
+
+            if (! readStringRef(ref))
+                return false;
+
+            str = (ref != nullptr) ? carla_strdup_safe(ref) : nullptr;
+            return true;
+        }
+    };
+
+    bool readHeader(Reader& reader, const LV2_URI uri) const
+    {
+        uint32_t magic, version, count;
+        const char* str;
+
+        if (! (reader.read(magic) && magic == kMagic && reader.read(version) && version == kVersion))
+            return false;
+
+        // hash collision or changed LV2_PATH
+        if (! (reader.readStringRef(str) && str != nullptr && std::strcmp(str, uri) == 0))
+            return false;
+        if (! (reader.readStringRef(str) && str != nullptr && fLv2Path == str))
+            return false;
+
+        if (! reader.readCount(count))
+            return false;
+
+        // mtime usually has a resolution of 1 second, the size catches quick edits
+        for (uint32_t i=0; i < count; ++i)
+        {
+            int64_t mtime, size;
+
+            if (! (reader.readStringRef(str) && str != nullptr && reader.read(mtime) && reader.read(size)))
+                return false;
+
+            const juce::File file(str);
+
+            if (file.getLastModificationTime().toMilliseconds() != mtime || file.getSize() != size)
+                return false;
+        }
+
+        return true;
+    }
+
+    static bool readFeatures(Reader& reader, uint32_t& count, LV2_RDF_Feature*& features)
+    {
+        if (! reader.readCount(count))
+            return false;
+        if (count == 0)
+            return true;
+
+        features = new LV2_RDF_Feature[count];
+
+        for (uint32_t i=0; i < count; ++i)
+        {
+            if (! (reader.read(features[i].Type) && reader.readString(features[i].URI)))
+                return false;
+        }
+
+        return true;
+    }
+
+    static bool readExtensions(Reader& reader, uint32_t& count, LV2_URI*& extensions)
+    {
+        if (! reader.readCount(count))
+            return false;
+        if (count == 0)
+            return true;
+
+        extensions = new LV2_URI[count];
+        carla_zeroPointers(extensions, count);
+
+        for (uint32_t i=0; i < count; ++i)
+        {
+            if (! reader.readString(extensions[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    static bool readDescriptor(Reader& reader, LV2_RDF_Descriptor* const rdfDescriptor)
+    {
+        uint64_t uniqueId;
+        uint8_t hasDefaultState;
+
+        if (! (reader.read(rdfDescriptor->Type[0]) && reader.read(rdfDescriptor->Type[1])))
+            return false;
+        if (! (reader.readString(rdfDescriptor->URI) && reader.readString(rdfDescriptor->Name) && reader.readString(rdfDescriptor->Author)))
+            return false;
+        if (! (reader.readString(rdfDescriptor->License) && reader.readString(rdfDescriptor->Binary) && reader.readString(rdfDescriptor->Bundle)))
+            return false;
+        if (! (reader.read(uniqueId) && reader.read(hasDefaultState)))
+            return false;
+
+        rdfDescriptor->UniqueID = static_cast<ulong>(uniqueId);
+        rdfDescriptor->HasDefaultState = (hasDefaultState != 0);
+
+        // ports
+        if (! reader.readCount(rdfDescriptor->PortCount))
+            return false;
+
+        if (rdfDescriptor->PortCount > 0)
+        {
+            rdfDescriptor->Ports = new LV2_RDF_Port[rdfDescriptor->PortCount];
+
+            for (uint32_t i=0; i < rdfDescriptor->PortCount; ++i)
+            {
+                LV2_RDF_Port& port(rdfDescriptor->Ports[i]);
+
+                if (! (reader.read(port.Types) && reader.read(port.Properties) && reader.read(port.Designation)))
+                    return false;
+                if (! (reader.readString(port.Name) && reader.readString(port.Symbol)))
+                    return false;
+                if (! (reader.read(port.MidiMap.Type) && reader.read(port.MidiMap.Number)))
+                    return false;
+                if (! (reader.read(port.Points.Hints) && reader.read(port.Points.Default) && reader.read(port.Points.Minimum) && reader.read(port.Points.Maximum)))
+                    return false;
+                if (! (reader.read(port.Unit.Hints) && reader.readString(port.Unit.Name) && reader.readString(port.Unit.Render)))
+                    return false;
+                if (! (reader.readString(port.Unit.Symbol) && reader.read(port.Unit.Unit)))
+                    return false;
+                if (! (reader.read(port.MinimumSize) && reader.readCount(port.ScalePointCount)))
+                    return false;
+
+                if (port.ScalePointCount == 0)
+                    continue;
+
+                port.ScalePoints = new LV2_RDF_PortScalePoint[port.ScalePointCount];
+
+                for (uint32_t j=0; j < port.ScalePointCount; ++j)
+                {
+                    if (! (reader.readString(port.ScalePoints[j].Label) && reader.read(port.ScalePoints[j].Value)))
+                        return false;
+                }
+            }
+        }
+
+        // presets
+        if (! reader.readCount(rdfDescriptor->PresetCount))
+            return false;
+
+        if (rdfDescriptor->PresetCount > 0)
+        {
+            rdfDescriptor->Presets = new LV2_RDF_Preset[rdfDescriptor->PresetCount];
+
+            for (uint32_t i=0; i < rdfDescriptor->PresetCount; ++i)
+            {
+                if (! (reader.readString(rdfDescriptor->Presets[i].URI) && reader.readString(rdfDescriptor->Presets[i].Label)))
+                    return false;
+            }
+        }
+
+        // features and extensions
+        if (! readFeatures(reader, rdfDescriptor->FeatureCount, rdfDescriptor->Features))
+            return false;
+        if (! readExtensions(reader, rdfDescriptor->ExtensionCount, rdfDescriptor->Extensions))
+            return false;
+
+        // UIs
+        if (! reader.readCount(rdfDescriptor->UICount))
+            return false;
+
+        if (rdfDescriptor->UICount > 0)
+        {
+            rdfDescriptor->UIs = new LV2_RDF_UI[rdfDescriptor->UICount];
+
+            for (uint32_t i=0; i < rdfDescriptor->UICount; ++i)
+            {
+                LV2_RDF_UI& ui(rdfDescriptor->UIs[i]);
+
+                if (! (reader.read(ui.Type) && reader.readString(ui.URI) && reader.readString(ui.Binary) && reader.readString(ui.Bundle)))
+                    return false;
+                if (! readFeatures(reader, ui.FeatureCount, ui.Features))
+                    return false;
+                if (! readExtensions(reader, ui.ExtensionCount, ui.Extensions))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    CARLA_DECLARE_NON_COPY_CLASS(Lv2RdfCache)
+};
+
+// -----------------------------------------------------------------------
+
+#endif // LV2_RDF_CACHE_HPP_INCLUDED
@@ -0,0 +1,250 @@
+/*
+ * LV2 URID Map
+ * Copyright (C) 2014 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+#ifndef LV2_URID_MAP_HPP_INCLUDED
+#define LV2_URID_MAP_HPP_INCLUDED
+
+#include "CarlaMutex.hpp"
+
+#include "lv2/urid.h"
+
+#include "juce_core.h"
+
+// -----------------------------------------------------------------------
+// Hashed URI <-> URID map.
+// Lookups never lock, only adding a new URI does.
+// Entries are never removed until the map itself is destroyed.
+
+class Lv2UridMap
+{
+public:
+    /*
+     * Constructor.
+     * IDs below 'firstURID' are reserved for the caller's static URIs.
+     */
+    Lv2UridMap(const uint32_t firstURID = 1) noexcept
+        : fMutex(),
+          fFirstURID(firstURID),
+          fCount(static_cast<int>(firstURID)),
+          fHidden(nullptr)
+    {
+        CARLA_SAFE_ASSERT(firstURID > 0);
+    }
+
+    /*
+     * Destructor.
+     */
+    ~Lv2UridMap() noexcept
+    {
+        for (uint32_t i=0; i < kBucketCount; ++i)
+        {
+            for (Node* node = fBuckets[i].get(); node != nullptr;)
+            {
+                Node* const next(node->next);
+                delete[] node->uri;
+                delete node;
+                node = next;
+            }
+        }
+
+        for (Node* node = fHidden; node != nullptr;)
+        {
+            Node* const next(node->next);
+            delete[] node->uri;
+            delete node;
+            node = next;
+        }
+
+        for (uint32_t i=0; i < kMaxPages; ++i)
+        {
+            if (const char** const page = fPages[i].get())
+                delete[] page;
+        }
+    }
+
+    /*
+     * Number of IDs in use, including the reserved ones.
+     */
+    uint32_t getCount() const noexcept
+    {
+        return static_cast<uint32_t>(fCount.get());
+    }
+
+    /*
+     * Get the ID of an URI, or 0 if not mapped yet.
+     */
+    LV2_URID find(const char* const uri) const noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', 0);
+
+        return _find(uri, _hash(uri));
+    }
+
+    /*
+     * Get the ID of an URI, mapping it if needed.
+     * Returns 0 if the map is full.
+     */
+    LV2_URID map(const char* const uri)
+    {
+        CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', 0);
+
+        const uint32_t hash(_hash(uri));
+
+        if (const LV2_URID urid = _find(uri, hash))
+            return urid;
+
+        const CarlaMutexLocker cml(fMutex);
+
+        // someone else might have added it meanwhile
+        if (const LV2_URID urid = _find(uri, hash))
+            return urid;
+
+        const LV2_URID urid(getCount());
+        CARLA_SAFE_ASSERT_RETURN(_insert(urid, uri, hash, true), 0);
+
+        return urid;
+    }
+
+    /*
+     * Map an URI to a specific ID, used to replay the map of another process.
+     * Gaps are allowed, and an URI already mapped elsewhere keeps its old ID for lookups.
+     * Returns false if the ID is already used by a different URI.
+     */
+    bool mapAt(const LV2_URID urid, const char* const uri)
+    {
+        CARLA_SAFE_ASSERT_RETURN(urid >= fFirstURID, false);
+        CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', false);
+
+        const CarlaMutexLocker cml(fMutex);
+
+        if (const char* const ourURI = unmap(urid))
+            return (std::strcmp(ourURI, uri) == 0);
+
+        const uint32_t hash(_hash(uri));
+
+        return _insert(urid, uri, hash, _find(uri, hash) == 0);
+    }
+
+    /*
+     * Get the URI of an ID, or null if not mapped.
+     */
+    const char* unmap(const LV2_URID urid) const noexcept
+    {
+        if (urid < fFirstURID || urid >= getCount())
+            return nullptr;
+
+        const char** const page(fPages[urid/kPageSize].get());
+        CARLA_SAFE_ASSERT_RETURN(page != nullptr, nullptr);
+
+        return page[urid % kPageSize];
+    }
+
+private:
+    static const uint32_t kBucketCount = 1024;
+    static const uint32_t kPageSize    = 256;
+    static const uint32_t kMaxPages    = 1024;
+
+    struct Node {
+        uint32_t    hash;
+        LV2_URID    urid;
+        const char* uri;
+        Node*       next;
+    };
+
+    CarlaMutex fMutex; // used for writing only
+    const uint32_t fFirstURID;
+
+    juce::Atomic<int>          fCount;
+    juce::Atomic<Node*>        fBuckets[kBucketCount];
+    juce::Atomic<const char**> fPages[kMaxPages];
+
+    Node* fHidden; // nodes only reachable by ID
+
+    // FNV-1a
+    static uint32_t _hash(const char* uri) noexcept
+    {
+        uint32_t hash = 2166136261U;
+
+        for (; *uri != '\0'; ++uri)
+        {
+            hash ^= static_cast<uint8_t>(*uri);
+            hash *= 16777619U;
+        }
+
+        return hash;
+    }
+
+    LV2_URID _find(const char* const uri, const uint32_t hash) const noexcept
+    {
+        for (const Node* node = fBuckets[hash % kBucketCount].get(); node != nullptr; node = node->next)
+        {
+            if (node->hash == hash && std::strcmp(node->uri, uri) == 0)
+                return node->urid;
+        }
+
+        return 0;
+    }
+
+    // must be called with the mutex locked, and urid must be unused
+    bool _insert(const LV2_URID urid, const char* const uri, const uint32_t hash, const bool addToBuckets)
+    {
+        const uint32_t pageIndex(urid/kPageSize);
+        CARLA_SAFE_ASSERT_RETURN(pageIndex < kMaxPages, false);
+
+        const char** page(fPages[pageIndex].get());
+
+        if (page == nullptr)
+        {
+            page = new const char*[kPageSize];
+            carla_zeroPointers(page, kPageSize);
+            fPages[pageIndex] = page;
+        }
+
+        Node* const node(new Node);
+        node->hash = hash;
+        node->urid = urid;
+        node->uri  = carla_strdup(uri);
+
+        // publish the ID side first, so that once lookups can return the new ID, unmap() works for it too
+        // a gap being filled simply reads as null until then
+        page[urid % kPageSize] = node->uri;
+
+        if (urid >= getCount())
+            fCount = static_cast<int>(urid + 1);
+
+        if (addToBuckets)
+        {
+            juce::Atomic<Node*>& bucket(fBuckets[hash % kBucketCount]);
+            node->next = bucket.get();
+            bucket = node;
+        }
+        else
+        {
+            // not reachable through lookups, keep it so it gets freed
+            node->next = fHidden;
+            fHidden = node;
+        }
+
+        return true;
+    }
+
+    CARLA_DECLARE_NON_COPY_CLASS(Lv2UridMap)
+};
+
+// -----------------------------------------------------------------------
+
+#endif // LV2_URID_MAP_HPP_INCLUDED